@@ -0,0 +1,78 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "Allocations.hpp"
+
+#include "oatpp-bob/AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace oatpp { namespace bob { namespace benchmark {
+
+namespace {
+
+std::atomic<v_int64> ALLOCATIONS_COUNT(0);
+std::atomic<v_int64> ALLOCATIONS_BYTES(0);
+
+void* allocate(std::size_t size) {
+  ALLOCATIONS_COUNT.fetch_add(1, std::memory_order_relaxed);
+  ALLOCATIONS_BYTES.fetch_add((v_int64) size, std::memory_order_relaxed);
+  oatpp::bob::AllocationCounter::onHeapAllocation((v_int64) size);
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if(ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+}
+
+Allocations::Counters Allocations::get() {
+  Counters result;
+  result.count = ALLOCATIONS_COUNT.load(std::memory_order_relaxed);
+  result.bytes = ALLOCATIONS_BYTES.load(std::memory_order_relaxed);
+  return result;
+}
+
+}}}
+
+/* all other forms of the global new/delete forward to these */
+
+void* operator new(std::size_t size) {
+  return oatpp::bob::benchmark::allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+  return oatpp::bob::benchmark::allocate(size);
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  std::free(ptr);
+}
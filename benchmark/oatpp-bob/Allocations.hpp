@@ -0,0 +1,68 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_BOB_BENCHMARK_ALLOCATIONS_HPP
+#define OATPP_BOB_BENCHMARK_ALLOCATIONS_HPP
+
+#include "oatpp/core/Types.hpp"
+
+namespace oatpp { namespace bob { namespace benchmark {
+
+/**
+ * Heap allocation counters of the benchmark process.
+ * Counted by the replaced global `operator new`, which also reports allocations to &id:oatpp::bob::AllocationCounter;.
+ */
+class Allocations {
+public:
+
+  /**
+   * Snapshot of the counters.
+   */
+  struct Counters {
+
+    /**
+     * Number of allocations.
+     */
+    v_int64 count;
+
+    /**
+     * Number of allocated bytes.
+     */
+    v_int64 bytes;
+
+  };
+
+public:
+
+  /**
+   * Get current values of the counters.
+   * @return - &l:Allocations::Counters;.
+   */
+  static Counters get();
+
+};
+
+}}}
+
+#endif // OATPP_BOB_BENCHMARK_ALLOCATIONS_HPP
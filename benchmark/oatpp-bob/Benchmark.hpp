@@ -0,0 +1,137 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_BOB_BENCHMARK_BENCHMARK_HPP
+#define OATPP_BOB_BENCHMARK_BENCHMARK_HPP
+
+#include "./Allocations.hpp"
+
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__)
+  #include <x86intrin.h>
+  #define OATPP_BOB_BENCHMARK_CYCLES
+#elif defined(_M_X64) || defined(_M_IX86)
+  #include <intrin.h>
+  #define OATPP_BOB_BENCHMARK_CYCLES
+#endif
+
+namespace oatpp { namespace bob { namespace benchmark {
+
+/**
+ * Read the CPU timestamp counter.
+ * @return - number of reference cycles. Always `0` if there is no counter for the platform.
+ */
+inline v_uint64 readCycles() {
+#ifdef OATPP_BOB_BENCHMARK_CYCLES
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+/**
+ * Result of the repeated run of the benchmarked operation.
+ */
+struct Measurement {
+
+  v_int64 iterations = 0;
+  v_int64 nanos = 0;
+  v_uint64 cycles = 0;
+  v_int64 allocations = 0;
+  v_int64 allocatedBytes = 0;
+
+  double getNanosPerOp() const {
+    return iterations > 0 ? (double) nanos / iterations : 0;
+  }
+
+  double getOpsPerSecond() const {
+    return nanos > 0 ? iterations * 1e9 / nanos : 0;
+  }
+
+  double getAllocationsPerOp() const {
+    return iterations > 0 ? (double) allocations / iterations : 0;
+  }
+
+  double getAllocatedBytesPerOp() const {
+    return iterations > 0 ? (double) allocatedBytes / iterations : 0;
+  }
+
+};
+
+/**
+ * Keeps results of the benchmarked operations alive, so the compiler can't drop the operations.
+ */
+extern volatile v_int64 SINK;
+
+/**
+ * Run the operation in growing batches until it takes at least `minNanos`.
+ * @tparam F - operation. `v_int64 f()` - the result goes to &l:SINK;.
+ * @param f - operation.
+ * @param minNanos - min total time of the measured runs.
+ * @return - &l:Measurement;.
+ */
+template<class F>
+Measurement measure(F f, v_int64 minNanos) {
+
+  SINK = SINK + f(); // warm-up - caches and lazily built type info
+
+  Measurement result;
+  v_int64 batch = 1;
+
+  while(result.nanos < minNanos) {
+
+    const auto allocationsBefore = Allocations::get();
+    const auto start = std::chrono::steady_clock::now();
+    const v_uint64 startCycles = readCycles();
+
+    v_int64 sum = 0;
+    for(v_int64 i = 0; i < batch; i ++) {
+      sum += f();
+    }
+
+    const v_uint64 endCycles = readCycles();
+    const auto end = std::chrono::steady_clock::now();
+    const auto allocationsAfter = Allocations::get();
+    SINK = SINK + sum;
+
+    result.iterations += batch;
+    result.nanos += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    result.cycles += endCycles - startCycles;
+    result.allocations += allocationsAfter.count - allocationsBefore.count;
+    result.allocatedBytes += allocationsAfter.bytes - allocationsBefore.bytes;
+
+    if(batch < (1 << 20)) {
+      batch *= 2;
+    }
+
+  }
+
+  return result;
+
+}
+
+}}}
+
+#endif // OATPP_BOB_BENCHMARK_BENCHMARK_HPP
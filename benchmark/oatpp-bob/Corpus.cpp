@@ -0,0 +1,183 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "Corpus.hpp"
+
+#include "oatpp/core/macro/codegen.hpp"
+
+namespace oatpp { namespace bob { namespace benchmark {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class NumbersDto : public oatpp::DTO {
+
+  DTO_INIT(NumbersDto, DTO)
+
+  DTO_FIELD(Int8, i8);
+  DTO_FIELD(UInt8, u8);
+  DTO_FIELD(Int16, i16);
+  DTO_FIELD(UInt16, u16);
+  DTO_FIELD(Int32, i32);
+  DTO_FIELD(UInt32, u32);
+  DTO_FIELD(Int64, i64);
+  DTO_FIELD(UInt64, u64);
+  DTO_FIELD(Float32, f32);
+  DTO_FIELD(Float64, f64);
+  DTO_FIELD(Boolean, flag);
+
+};
+
+class NodeDto : public oatpp::DTO {
+
+  DTO_INIT(NodeDto, DTO)
+
+  DTO_FIELD(String, name);
+  DTO_FIELD(Int32, depth);
+  DTO_FIELD(Object<NodeDto>, child);
+
+};
+
+class SeriesDto : public oatpp::DTO {
+
+  DTO_INIT(SeriesDto, DTO)
+
+  DTO_FIELD(String, name);
+  DTO_FIELD(Vector<Int64>, timestamps);
+  DTO_FIELD(Vector<Float64>, values);
+
+};
+
+class TextPayloadDto : public oatpp::DTO {
+
+  DTO_INIT(TextPayloadDto, DTO)
+
+  DTO_FIELD(String, text);
+  DTO_FIELD(String, language);
+
+};
+
+class EventDto : public oatpp::DTO {
+
+  DTO_INIT(EventDto, DTO)
+
+  DTO_FIELD(String, kind);
+  DTO_FIELD(Int64, timestamp);
+  DTO_FIELD(Any, payload);
+
+  DTO_FIELD_TYPE_SELECTOR(payload) {
+    if(kind == "numbers") return oatpp::Object<NumbersDto>::Class::getType();
+    if(kind == "text") return oatpp::Object<TextPayloadDto>::Class::getType();
+    return Void::Class::getType();
+  }
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::Object<NumbersDto> createNumbers(v_int32 seed) {
+  auto numbers = NumbersDto::createShared();
+  numbers->i8 = (v_int8) (-seed);
+  numbers->u8 = (v_uint8) (seed * 7);
+  numbers->i16 = (v_int16) (-seed * 301);
+  numbers->u16 = (v_uint16) (seed * 601);
+  numbers->i32 = -seed * 100003;
+  numbers->u32 = (v_uint32) seed * 4000037u;
+  numbers->i64 = -(v_int64) seed << 40;
+  numbers->u64 = (v_uint64) seed << 50;
+  numbers->f32 = seed * 0.5f;
+  numbers->f64 = seed * 0.001;
+  numbers->flag = seed % 2 == 0;
+  return numbers;
+}
+
+oatpp::Void createNested(v_int32 depth) {
+  oatpp::Object<NodeDto> node;
+  for(v_int32 i = depth - 1; i >= 0; i --) {
+    auto parent = NodeDto::createShared();
+    parent->name = "node-" + std::to_string(i);
+    parent->depth = i;
+    parent->child = node;
+    node = parent;
+  }
+  return node;
+}
+
+oatpp::Void createStringMap(v_int32 count) {
+  oatpp::Fields<oatpp::String> map({});
+  for(v_int32 i = 0; i < count; i ++) {
+    map->push_back({"header-" + std::to_string(i),
+                    "the quick brown fox jumps over the lazy dog - value " + std::to_string(i)});
+  }
+  return map;
+}
+
+oatpp::Void createLargeArray(v_int32 count) {
+  auto series = SeriesDto::createShared();
+  series->name = "series";
+  series->timestamps = oatpp::Vector<oatpp::Int64>::createShared();
+  series->values = oatpp::Vector<oatpp::Float64>::createShared();
+  series->timestamps->reserve(count);
+  series->values->reserve(count);
+  for(v_int32 i = 0; i < count; i ++) {
+    series->timestamps->push_back(1600000000000 + (v_int64) i * 1000);
+    series->values->push_back(i * 0.25);
+  }
+  return series;
+}
+
+oatpp::Void createPolymorphic(v_int32 count) {
+  oatpp::List<oatpp::Object<EventDto>> events({});
+  for(v_int32 i = 0; i < count; i ++) {
+    auto event = EventDto::createShared();
+    event->timestamp = 1600000000000 + (v_int64) i;
+    if(i % 2 == 0) {
+      event->kind = "numbers";
+      event->payload = createNumbers(i);
+    } else {
+      auto text = TextPayloadDto::createShared();
+      text->text = "event text " + std::to_string(i);
+      text->language = "en";
+      event->kind = "text";
+      event->payload = text;
+    }
+    events->push_back(event);
+  }
+  return events;
+}
+
+}
+
+std::vector<Corpus> createCorpora() {
+  std::vector<Corpus> result;
+  result.push_back({"flat-numeric", createNumbers(12345)});
+  result.push_back({"nested", createNested(64)});
+  result.push_back({"string-map", createStringMap(200)});
+  result.push_back({"large-array", createLargeArray(10000)});
+  result.push_back({"polymorphic", createPolymorphic(100)});
+  return result;
+}
+
+}}}
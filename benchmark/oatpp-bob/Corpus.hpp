@@ -0,0 +1,67 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_BOB_BENCHMARK_CORPUS_HPP
+#define OATPP_BOB_BENCHMARK_CORPUS_HPP
+
+#include "oatpp/core/Types.hpp"
+
+#include <string>
+#include <vector>
+
+namespace oatpp { namespace bob { namespace benchmark {
+
+/**
+ * Representative message for the mapper benchmarks.
+ */
+struct Corpus {
+
+  /**
+   * Name of the corpus.
+   */
+  std::string name;
+
+  /**
+   * Message. Its value type is the type the message is read to.
+   */
+  oatpp::Void message;
+
+};
+
+/**
+ * Create benchmark corpora:
+ * <ul>
+ *   <li>`flat-numeric` - DTO of numeric fields.</li>
+ *   <li>`nested` - deeply nested objects.</li>
+ *   <li>`string-map` - map of long strings.</li>
+ *   <li>`large-array` - DTO with large arrays of numbers.</li>
+ *   <li>`polymorphic` - list of DTOs with polymorphic `Any` fields.</li>
+ * </ul>
+ * @return - list of &l:Corpus;.
+ */
+std::vector<Corpus> createCorpora();
+
+}}}
+
+#endif // OATPP_BOB_BENCHMARK_CORPUS_HPP
@@ -0,0 +1,119 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "MapperBenchmark.hpp"
+
+#include "./Benchmark.hpp"
+
+#include "oatpp-bob/ObjectMapper.hpp"
+
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+
+#include <cstdio>
+#include <stdexcept>
+
+namespace oatpp { namespace bob { namespace benchmark {
+
+namespace {
+
+template<class Mapper>
+void runMapper(const char* mapperName, const Mapper& mapper, const Corpus& corpus, v_int64 minNanos) {
+
+  const oatpp::Void& message = corpus.message;
+  const oatpp::data::mapping::type::Type* type = message.getValueType();
+
+  const oatpp::String encoded = mapper.writeToString(message);
+  const v_int64 size = encoded->size();
+
+  {
+    /* make sure the message round-trips before measuring it */
+    oatpp::parser::Caret caret(encoded);
+    mapper.read(caret, type);
+    if(caret.hasError()) {
+      throw std::runtime_error("[oatpp::bob::benchmark::MapperBenchmark::run()]: Error. Can't read '" +
+                               corpus.name + "' with " + mapperName + " mapper: " + caret.getErrorMessage());
+    }
+  }
+
+  auto serialize = measure([&mapper, &message]() -> v_int64 {
+    return mapper.writeToString(message)->size();
+  }, minNanos);
+
+  auto deserialize = measure([&mapper, &encoded, type]() -> v_int64 {
+    oatpp::parser::Caret caret(encoded);
+    return mapper.read(caret, type) ? 1 : 0;
+  }, minNanos);
+
+  std::printf("%-14s %-6s %10lld %10.1f %12.0f %10.1f %10.1f %12.0f %10.1f\n",
+              corpus.name.c_str(), mapperName, (long long) size,
+              serialize.getOpsPerSecond() * size / 1e6, serialize.getOpsPerSecond(), serialize.getAllocationsPerOp(),
+              deserialize.getOpsPerSecond() * size / 1e6, deserialize.getOpsPerSecond(), deserialize.getAllocationsPerOp());
+
+}
+
+/*
+ * Allocations of one bob deserialize call - values by category and the total number of heap allocations.
+ */
+void printAllocationBreakdown(const oatpp::bob::ObjectMapper& mapper, const std::vector<Corpus>& corpora) {
+
+  typedef oatpp::bob::AllocationCounter AC;
+
+  std::printf("\n%-14s %10s %10s %10s %10s %10s %10s\n",
+              "bob read", "strings", "primitive", "objects", "collection", "any", "heap");
+
+  for(auto const& corpus : corpora) {
+    const oatpp::String encoded = mapper.writeToString(corpus.message);
+    oatpp::parser::Caret caret(encoded);
+    AC::Scope scope;
+    mapper.read(caret, corpus.message.getValueType());
+    const auto& c = scope.getCounters();
+    std::printf("%-14s %10lld %10lld %10lld %10lld %10lld %10lld\n", corpus.name.c_str(),
+                (long long) c.count[AC::STRINGS], (long long) c.count[AC::PRIMITIVES], (long long) c.count[AC::OBJECTS],
+                (long long) c.count[AC::COLLECTIONS], (long long) c.count[AC::ANY_HANDLES], (long long) c.heapCount);
+  }
+
+}
+
+}
+
+void MapperBenchmark::run(const std::vector<Corpus>& corpora, v_int64 minNanos) {
+
+  oatpp::bob::ObjectMapper bobMapper;
+  oatpp::parser::json::mapping::ObjectMapper jsonMapper;
+
+  std::printf("\n%-14s %-6s %10s %10s %12s %10s %10s %12s %10s\n",
+              "corpus", "mapper", "size(B)",
+              "ser MB/s", "ser msg/s", "ser alloc",
+              "de MB/s", "de msg/s", "de alloc");
+
+  for(auto const& corpus : corpora) {
+    runMapper("bob", bobMapper, corpus, minNanos);
+    runMapper("json", jsonMapper, corpus, minNanos);
+  }
+
+  printAllocationBreakdown(bobMapper, corpora);
+
+}
+
+}}}
@@ -0,0 +1,51 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_BOB_BENCHMARK_MAPPERBENCHMARK_HPP
+#define OATPP_BOB_BENCHMARK_MAPPERBENCHMARK_HPP
+
+#include "./Corpus.hpp"
+
+namespace oatpp { namespace bob { namespace benchmark {
+
+/**
+ * End-to-end benchmark of `oatpp::bob::ObjectMapper` against `oatpp::parser::json::mapping::ObjectMapper`. <br>
+ * For each corpus and mapper reports the encoded size, serialize/deserialize throughput (MB/s and msgs/s)
+ * and heap allocations per message.
+ */
+class MapperBenchmark {
+public:
+
+  /**
+   * Run the benchmark and print results to stdout.
+   * @param corpora - messages to benchmark.
+   * @param minNanos - min time of each measurement.
+   */
+  static void run(const std::vector<Corpus>& corpora, v_int64 minNanos);
+
+};
+
+}}}
+
+#endif // OATPP_BOB_BENCHMARK_MAPPERBENCHMARK_HPP
@@ -0,0 +1,280 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "MicroBenchmark.hpp"
+
+#include "./Benchmark.hpp"
+
+#include "oatpp-bob/ObjectMapper.hpp"
+#include "oatpp-bob/Utils.hpp"
+
+#include "oatpp/core/data/stream/BufferStream.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace oatpp { namespace bob { namespace benchmark {
+
+namespace {
+
+constexpr v_int32 VALUES_COUNT = 1024; // values processed by one run of a case
+constexpr v_buff_size SKIP_DATA_SIZE = 64 * 1024; // min size of the data skipped by one run of a skip case
+
+struct Case {
+  std::string name;
+  v_int64 ops;
+  v_int64 bytes;
+  std::function<v_int64()> run;
+};
+
+typedef oatpp::data::stream::BufferOutputStream BufferOutputStream;
+
+template<class Write>
+oatpp::String encodeValues(Write write) {
+  BufferOutputStream stream;
+  for(v_int32 i = 0; i < VALUES_COUNT; i ++) {
+    write(&stream, i);
+  }
+  return stream.toString();
+}
+
+template<class Write>
+Case createWriteCase(const std::string& name, Write write) {
+  const auto data = encodeValues(write);
+  auto stream = std::make_shared<BufferOutputStream>(data->size() + 1);
+  Case result;
+  result.name = name;
+  result.ops = VALUES_COUNT;
+  result.bytes = data->size();
+  result.run = [stream, write]() -> v_int64 {
+    stream->setCurrentPosition(0);
+    for(v_int32 i = 0; i < VALUES_COUNT; i ++) {
+      write(stream.get(), i);
+    }
+    return stream->getCurrentPosition();
+  };
+  return result;
+}
+
+template<class Write, class Read>
+Case createReadCase(const std::string& name, Write write, Read read) {
+  const auto data = encodeValues(write);
+  Case result;
+  result.name = name;
+  result.ops = VALUES_COUNT;
+  result.bytes = data->size();
+  result.run = [data, read]() -> v_int64 {
+    oatpp::parser::Caret caret(data);
+    v_int64 sum = 0;
+    for(v_int32 i = 0; i < VALUES_COUNT; i ++) {
+      sum += (v_int64) read(caret);
+    }
+    return sum;
+  };
+  return result;
+}
+
+Case createSkipCase(const std::string& name, const oatpp::String& value) {
+
+  const v_buff_size copies = SKIP_DATA_SIZE / value->size() + 1;
+  std::string buffer;
+  buffer.reserve(copies * value->size());
+  for(v_buff_size i = 0; i < copies; i ++) {
+    buffer.append(value->data(), value->size());
+  }
+  const oatpp::String data(std::move(buffer));
+
+  Case result;
+  result.name = name + " '" + value->substr(0, 1) + "'";
+  result.ops = copies;
+  result.bytes = data->size();
+  result.run = [data]() -> v_int64 {
+    oatpp::parser::Caret caret(data);
+    v_int64 count = 0;
+    while(caret.canContinue()) {
+      Deserializer::skipValue(caret);
+      count ++;
+    }
+    if(caret.hasError()) {
+      throw std::runtime_error("[oatpp::bob::benchmark::MicroBenchmark::run()]: Error. Can't skip value: " +
+                               std::string(caret.getErrorMessage()));
+    }
+    return count;
+  };
+  return result;
+
+}
+
+std::vector<Case> createCases() {
+
+  typedef Utils::BO_TYPE BO;
+  std::vector<Case> result;
+
+  /* numbers */
+
+  auto writeInt16 = [](BufferOutputStream* s, v_int32 i) { Utils::writeInt16(s, (v_int16) (i * 31), BO::NETWORK); };
+  auto writeInt32 = [](BufferOutputStream* s, v_int32 i) { Utils::writeInt32(s, i * 100003, BO::NETWORK); };
+  auto writeInt64 = [](BufferOutputStream* s, v_int32 i) { Utils::writeInt64(s, (v_int64) i << 33, BO::NETWORK); };
+  auto writeFloat32 = [](BufferOutputStream* s, v_int32 i) { Utils::writeFloat32(s, i * 0.5f, BO::NETWORK); };
+  auto writeFloat64 = [](BufferOutputStream* s, v_int32 i) { Utils::writeFloat64(s, i * 0.25, BO::NETWORK); };
+
+  result.push_back(createWriteCase("writeInt16", writeInt16));
+  result.push_back(createWriteCase("writeInt32", writeInt32));
+  result.push_back(createWriteCase("writeInt64", writeInt64));
+  result.push_back(createWriteCase("writeFloat32", writeFloat32));
+  result.push_back(createWriteCase("writeFloat64", writeFloat64));
+
+  result.push_back(createReadCase("readInt16", writeInt16, [](oatpp::parser::Caret& c) { return Utils::readInt16(c, BO::NETWORK); }));
+  result.push_back(createReadCase("readInt32", writeInt32, [](oatpp::parser::Caret& c) { return Utils::readInt32(c, BO::NETWORK); }));
+  result.push_back(createReadCase("readInt64", writeInt64, [](oatpp::parser::Caret& c) { return Utils::readInt64(c, BO::NETWORK); }));
+  result.push_back(createReadCase("readFloat32", writeFloat32, [](oatpp::parser::Caret& c) { return Utils::readFloat32(c, BO::NETWORK); }));
+  result.push_back(createReadCase("readFloat64", writeFloat64, [](oatpp::parser::Caret& c) { return Utils::readFloat64(c, BO::NETWORK); }));
+
+  /* keys */
+
+  auto writeKey = [](BufferOutputStream* s, v_int32 i) { Utils::writeCString(s, "field-" + std::to_string(i % 32)); };
+  result.push_back(createWriteCase("writeCString", writeKey));
+  result.push_back(createReadCase("readCString", writeKey, [](oatpp::parser::Caret& c) { return Utils::readCString(c)->size(); }));
+
+  /* skip */
+
+  oatpp::bob::ObjectMapper mapper;
+
+  auto sizedConfig = oatpp::bob::Serializer::Config::createShared();
+  sizedConfig->sizedContainers = true;
+  oatpp::bob::ObjectMapper sizedMapper(sizedConfig, oatpp::bob::Deserializer::Config::createShared());
+
+  oatpp::Fields<oatpp::Int32> map({});
+  oatpp::Vector<oatpp::Int32> array({});
+  for(v_int32 i = 0; i < 16; i ++) {
+    map->push_back({"key-" + std::to_string(i), i * 1000});
+    array->push_back(i * 1000);
+  }
+
+  result.push_back(createSkipCase("skip null", mapper.writeToString(oatpp::Int32(nullptr))));
+  result.push_back(createSkipCase("skip bool", mapper.writeToString(oatpp::Boolean(true))));
+  result.push_back(createSkipCase("skip int8", mapper.writeToString(oatpp::Int8(-5))));
+  result.push_back(createSkipCase("skip int16", mapper.writeToString(oatpp::Int16(-500))));
+  result.push_back(createSkipCase("skip int32", mapper.writeToString(oatpp::Int32(-500000))));
+  result.push_back(createSkipCase("skip int64", mapper.writeToString(oatpp::Int64(-5000000000))));
+  result.push_back(createSkipCase("skip float32", mapper.writeToString(oatpp::Float32(0.5f))));
+  result.push_back(createSkipCase("skip float64", mapper.writeToString(oatpp::Float64(0.25))));
+  result.push_back(createSkipCase("skip string16", mapper.writeToString(oatpp::String(std::string(16, 'x')))));
+  result.push_back(createSkipCase("skip string1k", mapper.writeToString(oatpp::String(std::string(1000, 'x')))));
+  result.push_back(createSkipCase("skip string100k", mapper.writeToString(oatpp::String(std::string(100000, 'x')))));
+  result.push_back(createSkipCase("skip map16", mapper.writeToString(map)));
+  result.push_back(createSkipCase("skip array16", mapper.writeToString(array)));
+  result.push_back(createSkipCase("skip sized map16", sizedMapper.writeToString(map)));
+  result.push_back(createSkipCase("skip sized array16", sizedMapper.writeToString(array)));
+
+  return result;
+
+}
+
+/*
+ * Baseline file - one line per case: <case name>\t<ns/op>
+ */
+std::unordered_map<std::string, double> loadBaseline(const std::string& path) {
+  std::unordered_map<std::string, double> result;
+  std::ifstream file(path);
+  if(!file) {
+    throw std::runtime_error("[oatpp::bob::benchmark::MicroBenchmark::run()]: Error. Can't open baseline file '" + path + "'.");
+  }
+  std::string line;
+  while(std::getline(file, line)) {
+    auto tab = line.rfind('\t');
+    if(tab != std::string::npos) {
+      result[line.substr(0, tab)] = std::atof(line.c_str() + tab + 1);
+    }
+  }
+  return result;
+}
+
+}
+
+v_int32 MicroBenchmark::run(const Options& options) {
+
+  std::unordered_map<std::string, double> baseline;
+  if(!options.baselinePath.empty()) {
+    baseline = loadBaseline(options.baselinePath);
+  }
+
+  std::ofstream saveFile;
+  if(!options.saveBaselinePath.empty()) {
+    saveFile.open(options.saveBaselinePath);
+    if(!saveFile) {
+      throw std::runtime_error("[oatpp::bob::benchmark::MicroBenchmark::run()]: Error. Can't open file '" + options.saveBaselinePath + "'.");
+    }
+  }
+
+  std::printf("\n%-28s %10s %12s %12s %10s\n", "case", "ns/op", "cycles/byte", "baseline", "change");
+
+  v_int32 regressions = 0;
+
+  for(auto& c : createCases()) {
+
+    auto m = measure(c.run, options.minNanos);
+
+    const double nanosPerOp = (double) m.nanos / (m.iterations * c.ops);
+
+    char cycles[32];
+#ifdef OATPP_BOB_BENCHMARK_CYCLES
+    std::snprintf(cycles, sizeof(cycles), "%.3f", (double) m.cycles / (m.iterations * c.bytes));
+#else
+    std::snprintf(cycles, sizeof(cycles), "n/a");
+#endif
+
+    auto it = baseline.find(c.name);
+    if(it != baseline.end() && it->second > 0) {
+      const double change = nanosPerOp / it->second - 1;
+      const bool regression = change > options.tolerance;
+      if(regression) {
+        regressions ++;
+      }
+      std::printf("%-28s %10.3f %12s %12.3f %+9.1f%%%s\n", c.name.c_str(), nanosPerOp, cycles, it->second, change * 100,
+                  regression ? " REGRESSION" : "");
+    } else {
+      std::printf("%-28s %10.3f %12s %12s %10s\n", c.name.c_str(), nanosPerOp, cycles, "-", "-");
+    }
+
+    if(saveFile) {
+      saveFile << c.name << '\t' << nanosPerOp << '\n';
+    }
+
+  }
+
+  if(!baseline.empty()) {
+    std::printf("\n%d regression(s) over %.0f%% tolerance\n", regressions, options.tolerance * 100);
+  }
+
+  return regressions;
+
+}
+
+}}}
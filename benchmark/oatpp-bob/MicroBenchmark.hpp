@@ -0,0 +1,82 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_BOB_BENCHMARK_MICROBENCHMARK_HPP
+#define OATPP_BOB_BENCHMARK_MICROBENCHMARK_HPP
+
+#include "oatpp/core/Types.hpp"
+
+#include <string>
+
+namespace oatpp { namespace bob { namespace benchmark {
+
+/**
+ * Micro-benchmarks of the per-value hot paths - `Utils::read*` / `Utils::write*` of numbers,
+ * `Utils::readCString` and `Deserializer::skipValue` for each tag. <br>
+ * Reports ns/op and cycles/byte. Results can be saved as a baseline and compared to it later.
+ */
+class MicroBenchmark {
+public:
+
+  /**
+   * Benchmark options.
+   */
+  struct Options {
+
+    /**
+     * Min time of each measurement.
+     */
+    v_int64 minNanos = 200000000;
+
+    /**
+     * Baseline file to compare the results to. Empty - no comparison.
+     */
+    std::string baselinePath;
+
+    /**
+     * File to save the results to as a new baseline. Empty - results are not saved.
+     */
+    std::string saveBaselinePath;
+
+    /**
+     * Result slower than the baseline by more than this fraction is reported as a regression.
+     */
+    double tolerance = 0.1;
+
+  };
+
+public:
+
+  /**
+   * Run the benchmark and print results to stdout.
+   * @param options - &l:MicroBenchmark::Options;.
+   * @return - number of regressions against the baseline.
+   */
+  static v_int32 run(const Options& options);
+
+};
+
+}}}
+
+#endif // OATPP_BOB_BENCHMARK_MICROBENCHMARK_HPP
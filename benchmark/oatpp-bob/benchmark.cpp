@@ -0,0 +1,100 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "./MapperBenchmark.hpp"
+#include "./MicroBenchmark.hpp"
+
+#include "oatpp/core/base/Environment.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace oatpp { namespace bob { namespace benchmark {
+
+volatile v_int64 SINK = 0;
+
+}}}
+
+namespace {
+
+/*
+ * Usage: oatpp-bob-benchmark [--suite all|mapper|micro] [--time <millis per measurement>]
+ *                            [--baseline <file>] [--save-baseline <file>] [--tolerance <fraction>]
+ * Returns non-zero if micro-benchmarks regressed against the baseline.
+ */
+v_int32 runBenchmarks(int argc, char* argv[]) {
+
+  std::string suite = "all";
+  v_int64 minMillis = 200;
+  oatpp::bob::benchmark::MicroBenchmark::Options microOptions;
+
+  for(int i = 1; i + 1 < argc; i += 2) {
+    if(std::strcmp(argv[i], "--suite") == 0) {
+      suite = argv[i + 1];
+    } else if(std::strcmp(argv[i], "--time") == 0) {
+      minMillis = std::atoll(argv[i + 1]);
+    } else if(std::strcmp(argv[i], "--baseline") == 0) {
+      microOptions.baselinePath = argv[i + 1];
+    } else if(std::strcmp(argv[i], "--save-baseline") == 0) {
+      microOptions.saveBaselinePath = argv[i + 1];
+    } else if(std::strcmp(argv[i], "--tolerance") == 0) {
+      microOptions.tolerance = std::atof(argv[i + 1]);
+    } else {
+      std::cerr << "Unknown option '" << argv[i] << "'\n";
+      return 2;
+    }
+  }
+
+  const v_int64 minNanos = minMillis * 1000000;
+  v_int32 regressions = 0;
+
+  if(suite == "all" || suite == "mapper") {
+    auto corpora = oatpp::bob::benchmark::createCorpora();
+    oatpp::bob::benchmark::MapperBenchmark::run(corpora, minNanos);
+  }
+
+  if(suite == "all" || suite == "micro") {
+    microOptions.minNanos = minNanos;
+    regressions = oatpp::bob::benchmark::MicroBenchmark::run(microOptions);
+  }
+
+  return regressions > 0 ? 1 : 0;
+
+}
+
+}
+
+int main(int argc, char* argv[]) {
+
+  oatpp::base::Environment::init();
+
+  v_int32 result = runBenchmarks(argc, argv);
+
+  std::cout << "\n";
+
+  oatpp::base::Environment::destroy();
+
+  return result;
+}
@@ -0,0 +1,129 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "AllocationCounter.hpp"
+
+#include <cstring>
+
+namespace oatpp { namespace bob {
+
+thread_local AllocationCounter::Scope* AllocationCounter::CURRENT_SCOPE = nullptr;
+
+v_int64 AllocationCounter::Counters::getTotalCount() const {
+  v_int64 result = 0;
+  for(v_int32 i = 0; i < CATEGORIES_COUNT; i ++) {
+    result += count[i];
+  }
+  return result;
+}
+
+v_int64 AllocationCounter::Counters::getTotalBytes() const {
+  v_int64 result = 0;
+  for(v_int32 i = 0; i < CATEGORIES_COUNT; i ++) {
+    result += bytes[i];
+  }
+  return result;
+}
+
+AllocationCounter::Scope::Scope()
+  : m_previous(CURRENT_SCOPE)
+{
+  reset();
+  CURRENT_SCOPE = this;
+}
+
+AllocationCounter::Scope::~Scope() {
+  CURRENT_SCOPE = m_previous;
+  if(m_previous) {
+    for(v_int32 i = 0; i < CATEGORIES_COUNT; i ++) {
+      m_previous->m_counters.count[i] += m_counters.count[i];
+      m_previous->m_counters.bytes[i] += m_counters.bytes[i];
+    }
+    m_previous->m_counters.heapCount += m_counters.heapCount;
+    m_previous->m_counters.heapBytes += m_counters.heapBytes;
+  }
+}
+
+const AllocationCounter::Counters& AllocationCounter::Scope::getCounters() const {
+  return m_counters;
+}
+
+void AllocationCounter::Scope::reset() {
+  std::memset(&m_counters, 0, sizeof(Counters));
+}
+
+void AllocationCounter::recordValueImpl(Scope* scope, const oatpp::Void& value) {
+
+  namespace __class = oatpp::data::mapping::type::__class;
+
+  const auto type = value.getValueType();
+  const auto& id = type->classId;
+
+  Category category;
+  v_int64 bytes;
+
+  if(id == __class::String::CLASS_ID) {
+    category = STRINGS;
+    bytes = sizeof(std::string) + static_cast<std::string*>(value.get())->size();
+  } else if(id == __class::Int8::CLASS_ID || id == __class::UInt8::CLASS_ID || id == __class::Boolean::CLASS_ID) {
+    category = PRIMITIVES;
+    bytes = 1;
+  } else if(id == __class::Int16::CLASS_ID || id == __class::UInt16::CLASS_ID) {
+    category = PRIMITIVES;
+    bytes = 2;
+  } else if(id == __class::Int32::CLASS_ID || id == __class::UInt32::CLASS_ID || id == __class::Float32::CLASS_ID) {
+    category = PRIMITIVES;
+    bytes = 4;
+  } else if(id == __class::Int64::CLASS_ID || id == __class::UInt64::CLASS_ID || id == __class::Float64::CLASS_ID ||
+            id == __class::AbstractEnum::CLASS_ID)
+  {
+    category = PRIMITIVES;
+    bytes = 8;
+  } else if(id == __class::AbstractObject::CLASS_ID) {
+    auto dispatcher = static_cast<const __class::AbstractObject::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+    category = OBJECTS;
+    bytes = (v_int64) dispatcher->getProperties()->getList().size() * sizeof(oatpp::Void);
+  } else if(id == __class::AbstractVector::CLASS_ID || id == __class::AbstractList::CLASS_ID ||
+            id == __class::AbstractUnorderedSet::CLASS_ID)
+  {
+    auto dispatcher = static_cast<const __class::Collection::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+    category = COLLECTIONS;
+    bytes = dispatcher->getCollectionSize(value) * sizeof(oatpp::Void);
+  } else if(id == __class::AbstractPairList::CLASS_ID || id == __class::AbstractUnorderedMap::CLASS_ID) {
+    auto dispatcher = static_cast<const __class::Map::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+    category = COLLECTIONS;
+    bytes = dispatcher->getMapSize(value) * 2 * sizeof(oatpp::Void);
+  } else if(id == __class::Any::CLASS_ID) {
+    category = ANY_HANDLES;
+    bytes = sizeof(oatpp::data::mapping::type::AnyHandle);
+  } else {
+    return; // custom types - unknown layout
+  }
+
+  scope->m_counters.count[category] ++;
+  scope->m_counters.bytes[category] += bytes;
+
+}
+
+}}
@@ -0,0 +1,225 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_BOB_ALLOCATIONCOUNTER_HPP
+#define OATPP_BOB_ALLOCATIONCOUNTER_HPP
+
+#include "oatpp/core/Types.hpp"
+
+namespace oatpp { namespace bob {
+
+/**
+ * Allocation counters of the (de)serialization calls made on the current thread. <br>
+ * Counting is active while an &l:AllocationCounter::Scope; exists on the thread:
+ * <ul>
+ *   <li>Deserializer counts values it creates - by the category of their type.</li>
+ *   <li>Serializer counts its temporary buffers (back-patching, columns, cached subtrees, parallel chunks).</li>
+ *   <li>Raw heap allocations are counted if the application reports them with &l:AllocationCounter::onHeapAllocation ();
+ *   from its replacement of the global `operator new`.</li>
+ * </ul>
+ * Bytes of values are estimated payload sizes - shared pointer control blocks and allocator overhead are not included.
+ * Work done by &id:oatpp::bob::Serializer::Config::parallelThreads; workers is not counted. <br>
+ * Build with `OATPP_BOB_DISABLE_ALLOCATION_COUNTER` defined to compile the counting out.
+ */
+class AllocationCounter {
+public:
+
+  /**
+   * Category of the allocation.
+   */
+  enum Category : v_int32 {
+
+    /**
+     * `oatpp::String`.
+     */
+    STRINGS = 0,
+
+    /**
+     * Boxed primitives - integers, floats, booleans and enums.
+     */
+    PRIMITIVES = 1,
+
+    /**
+     * DTO objects.
+     */
+    OBJECTS = 2,
+
+    /**
+     * Lists, vectors, sets and maps.
+     */
+    COLLECTIONS = 3,
+
+    /**
+     * `oatpp::Any` handles.
+     */
+    ANY_HANDLES = 4,
+
+    /**
+     * Temporary buffers of the serializer.
+     */
+    BUFFERS = 5
+
+  };
+
+  /**
+   * Number of categories.
+   */
+  static constexpr v_int32 CATEGORIES_COUNT = 6;
+
+  /**
+   * Counters of the scope.
+   */
+  struct Counters {
+
+    /**
+     * Number of allocations by category.
+     */
+    v_int64 count[CATEGORIES_COUNT];
+
+    /**
+     * Bytes by category.
+     */
+    v_int64 bytes[CATEGORIES_COUNT];
+
+    /**
+     * Number of heap allocations reported with &l:AllocationCounter::onHeapAllocation ();.
+     */
+    v_int64 heapCount;
+
+    /**
+     * Bytes of heap allocations reported with &l:AllocationCounter::onHeapAllocation ();.
+     */
+    v_int64 heapBytes;
+
+    /**
+     * Get number of allocations of all categories.
+     * @return
+     */
+    v_int64 getTotalCount() const;
+
+    /**
+     * Get bytes of all categories.
+     * @return
+     */
+    v_int64 getTotalBytes() const;
+
+  };
+
+  /**
+   * Counting scope. While the scope exists, allocations of the current thread are counted to it. <br>
+   * Scopes can be nested - when the inner scope ends, its counters are added to the outer one.
+   */
+  class Scope {
+    friend AllocationCounter;
+  private:
+    Counters m_counters;
+    Scope* m_previous;
+  public:
+
+    /**
+     * Constructor. Start counting.
+     */
+    Scope();
+
+    /**
+     * Destructor. Stop counting.
+     */
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    /**
+     * Get counters.
+     * @return - &l:AllocationCounter::Counters;.
+     */
+    const Counters& getCounters() const;
+
+    /**
+     * Set all counters to zero.
+     */
+    void reset();
+
+  };
+
+private:
+  static thread_local Scope* CURRENT_SCOPE;
+  static void recordValueImpl(Scope* scope, const oatpp::Void& value);
+public:
+
+  /**
+   * Count allocation in the current scope.
+   * @param category - &l:AllocationCounter::Category;.
+   * @param bytes - size of the allocation.
+   */
+  static void record(Category category, v_int64 bytes) {
+#ifndef OATPP_BOB_DISABLE_ALLOCATION_COUNTER
+    Scope* scope = CURRENT_SCOPE;
+    if(scope) {
+      scope->m_counters.count[category] ++;
+      scope->m_counters.bytes[category] += bytes;
+    }
+#else
+    (void) category;
+    (void) bytes;
+#endif
+  }
+
+  /**
+   * Count created value in the current scope. The category is selected by the value type. `null` values are not counted.
+   * @param value - created value.
+   */
+  static void recordValue(const oatpp::Void& value) {
+#ifndef OATPP_BOB_DISABLE_ALLOCATION_COUNTER
+    Scope* scope = CURRENT_SCOPE;
+    if(scope && value) {
+      recordValueImpl(scope, value);
+    }
+#else
+    (void) value;
+#endif
+  }
+
+  /**
+   * Report heap allocation. Call it from the replacement of the global `operator new`. <br>
+   * Doesn't allocate.
+   * @param size - size of the allocation.
+   */
+  static void onHeapAllocation(v_int64 size) {
+#ifndef OATPP_BOB_DISABLE_ALLOCATION_COUNTER
+    Scope* scope = CURRENT_SCOPE;
+    if(scope) {
+      scope->m_counters.heapCount ++;
+      scope->m_counters.heapBytes += size;
+    }
+#else
+    (void) size;
+#endif
+  }
+
+};
+
+}}
+
+#endif // OATPP_BOB_ALLOCATIONCOUNTER_HPP
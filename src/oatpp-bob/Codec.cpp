@@ -0,0 +1,439 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "Codec.hpp"
+
+#include "./Utils.hpp"
+
+#include <cstring>
+#include <string>
+
+#ifdef OATPP_BOB_WITH_ZLIB
+  #include <zlib.h>
+#endif
+
+#ifdef OATPP_BOB_WITH_ZSTD
+  #include <zstd.h>
+#endif
+
+namespace oatpp { namespace bob {
+
+namespace {
+
+struct BlockHeader {
+  v_buff_size rawSize;
+  v_buff_size dataSize;
+};
+
+bool readBlockHeader(oatpp::parser::Caret& caret, BlockHeader& header) {
+  v_uint64 rawSize = Utils::readVarUInt(caret);
+  if(caret.hasError()) {
+    return false;
+  }
+  if(rawSize == 0) {
+    header.rawSize = 0;
+    header.dataSize = 0;
+    return true;
+  }
+  v_uint64 dataSize = Utils::readVarUInt(caret);
+  if(caret.hasError()) {
+    return false;
+  }
+  if(rawSize > (v_uint64) Codec::MAX_BLOCK_SIZE || dataSize == 0 || dataSize > rawSize ||
+     dataSize > (v_uint64) (caret.getDataSize() - caret.getPosition()))
+  {
+    caret.setError("[oatpp::bob::Codec::readFrame()]: Error. Invalid block header.");
+    return false;
+  }
+  header.rawSize = (v_buff_size) rawSize;
+  header.dataSize = (v_buff_size) dataSize;
+  return true;
+}
+
+}
+
+constexpr const v_uint8 Codec::ID_LZ;
+constexpr const v_uint8 Codec::ID_ZLIB;
+constexpr const v_uint8 Codec::ID_ZSTD;
+constexpr const v_char8 Codec::FRAME_BEGIN;
+constexpr const v_buff_size Codec::DEFAULT_MAX_FRAME_SIZE;
+constexpr const v_buff_size Codec::MAX_BLOCK_SIZE;
+
+std::shared_ptr<Codec> Codec::getBuiltinCodec(v_uint8 id) {
+  switch(id) {
+    case ID_LZ: return std::make_shared<LzCodec>();
+#ifdef OATPP_BOB_WITH_ZLIB
+    case ID_ZLIB: return std::make_shared<ZlibCodec>();
+#endif
+#ifdef OATPP_BOB_WITH_ZSTD
+    case ID_ZSTD: return std::make_shared<ZstdCodec>();
+#endif
+    default:
+      return nullptr;
+  }
+}
+
+oatpp::String Codec::readFrame(oatpp::parser::Caret& caret, const std::shared_ptr<Codec>& codec, v_buff_size maxSize) {
+
+  if(!caret.canContinueAtChar(FRAME_BEGIN, 1) || !caret.canContinue()) {
+    caret.setError("[oatpp::bob::Codec::readFrame()]: Error. Invalid frame header.");
+    return nullptr;
+  }
+
+  v_uint8 id = (v_uint8) caret.getCurrData()[0];
+  caret.inc();
+
+  std::shared_ptr<Codec> frameCodec = codec;
+  if(!frameCodec || frameCodec->getId() != id) {
+    frameCodec = getBuiltinCodec(id);
+  }
+  if(!frameCodec) {
+    caret.setError("[oatpp::bob::Codec::readFrame()]: Error. Unknown codec.");
+    return nullptr;
+  }
+
+  /* blocks are decompressed as they are read - the output grows with the data actually present in the frame */
+
+  std::string result;
+  BlockHeader header;
+
+  while(true) {
+
+    if(!readBlockHeader(caret, header)) {
+      return nullptr;
+    }
+    if(header.rawSize == 0) {
+      break;
+    }
+
+    if(header.rawSize > maxSize - (v_buff_size) result.size()) {
+      caret.setError("[oatpp::bob::Codec::readFrame()]: Error. Frame is too large.");
+      return nullptr;
+    }
+
+    const char* src = caret.getCurrData();
+    v_buff_size position = result.size();
+    result.resize(position + header.rawSize);
+    char* dst = &result[position];
+
+    if(header.dataSize == header.rawSize) {
+      std::memcpy(dst, src, header.rawSize);
+    } else {
+      auto res = frameCodec->decompress(src, header.dataSize, dst, header.rawSize);
+      if(res != header.rawSize) {
+        caret.setError("[oatpp::bob::Codec::readFrame()]: Error. Can't decompress block.");
+        return nullptr;
+      }
+    }
+
+    caret.inc(header.dataSize);
+
+  }
+
+  return oatpp::String(std::move(result));
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LzCodec
+//
+// Block is a sequence of <token> <literals> <offset> <match> entries:
+//   - token - high 4 bits: number of literals, low 4 bits: match length - 4.
+//             Value 15 means that the length is continued in the following bytes (each 255 adds up, stops at < 255).
+//   - offset - 2 bytes, little endian, distance back to the match in the output.
+// The last sequence has literals only and no offset.
+
+namespace {
+
+constexpr v_int32 LZ_HASH_BITS = 12;
+constexpr v_buff_size LZ_MIN_MATCH = 4;
+constexpr v_buff_size LZ_MAX_OFFSET = 65535;
+constexpr v_buff_size LZ_LAST_LITERALS = 5; // match never covers the last bytes of the block
+constexpr v_buff_size LZ_MATCH_FIND_LIMIT = 12; // don't look for matches close to the end of the block
+
+v_uint32 lzRead32(const v_uint8* p) {
+  v_uint32 value;
+  std::memcpy(&value, p, 4);
+  return value;
+}
+
+v_uint32 lzHash(v_uint32 sequence) {
+  return (sequence * 2654435761U) >> (32 - LZ_HASH_BITS);
+}
+
+bool lzWriteLength(v_uint8*& op, const v_uint8* end, v_buff_size length) {
+  while(length >= 255) {
+    if(op >= end) return false;
+    *op ++ = 255;
+    length -= 255;
+  }
+  if(op >= end) return false;
+  *op ++ = (v_uint8) length;
+  return true;
+}
+
+bool lzReadLength(const v_uint8*& ip, const v_uint8* end, v_buff_size& length) {
+  v_uint8 byte;
+  do {
+    if(ip >= end) return false;
+    byte = *ip ++;
+    length += byte;
+  } while(byte == 255);
+  return true;
+}
+
+bool lzWriteSequence(v_uint8*& op, const v_uint8* end,
+                     const v_uint8* literals, v_buff_size literalsSize,
+                     v_buff_size offset, v_buff_size matchSize)
+{
+
+  if(op >= end) return false;
+  v_uint8* token = op ++;
+
+  if(literalsSize >= 15) {
+    *token = 15 << 4;
+    if(!lzWriteLength(op, end, literalsSize - 15)) return false;
+  } else {
+    *token = (v_uint8) (literalsSize << 4);
+  }
+
+  if(end - op < literalsSize) return false;
+  std::memcpy(op, literals, literalsSize);
+  op += literalsSize;
+
+  if(matchSize == 0) {
+    return true;
+  }
+
+  if(end - op < 2) return false;
+  *op ++ = (v_uint8) (offset & 0xFF);
+  *op ++ = (v_uint8) (offset >> 8);
+
+  v_buff_size matchCode = matchSize - LZ_MIN_MATCH;
+  if(matchCode >= 15) {
+    *token |= 15;
+    if(!lzWriteLength(op, end, matchCode - 15)) return false;
+  } else {
+    *token |= (v_uint8) matchCode;
+  }
+
+  return true;
+
+}
+
+}
+
+v_uint8 LzCodec::getId() const {
+  return ID_LZ;
+}
+
+v_buff_size LzCodec::getMaxCompressedSize(v_buff_size size) const {
+  return size + size / 255 + 16;
+}
+
+v_buff_size LzCodec::compress(const void* src, v_buff_size size, void* dst, v_buff_size capacity) const {
+
+  const v_uint8* in = (const v_uint8*) src;
+  v_uint8* op = (v_uint8*) dst;
+  const v_uint8* end = op + capacity;
+
+  v_buff_size anchor = 0;
+
+  if(size > LZ_MATCH_FIND_LIMIT) {
+
+    v_int32 table[1 << LZ_HASH_BITS];
+    for(auto& entry : table) {
+      entry = -1;
+    }
+
+    v_buff_size findLimit = size - LZ_MATCH_FIND_LIMIT;
+    v_buff_size matchLimit = size - LZ_LAST_LITERALS;
+    v_buff_size ip = 0;
+
+    while(ip < findLimit) {
+
+      v_uint32 sequence = lzRead32(in + ip);
+      v_uint32 hash = lzHash(sequence);
+      v_buff_size ref = table[hash];
+      table[hash] = (v_int32) ip;
+
+      if(ref < 0 || ip - ref > LZ_MAX_OFFSET || lzRead32(in + ref) != sequence) {
+        ip ++;
+        continue;
+      }
+
+      v_buff_size matchSize = LZ_MIN_MATCH;
+      while(ip + matchSize < matchLimit && in[ref + matchSize] == in[ip + matchSize]) {
+        matchSize ++;
+      }
+
+      if(!lzWriteSequence(op, end, in + anchor, ip - anchor, ip - ref, matchSize)) {
+        return -1;
+      }
+
+      ip += matchSize;
+      anchor = ip;
+
+    }
+
+  }
+
+  if(!lzWriteSequence(op, end, in + anchor, size - anchor, 0, 0)) {
+    return -1;
+  }
+
+  return op - (v_uint8*) dst;
+
+}
+
+v_buff_size LzCodec::decompress(const void* src, v_buff_size size, void* dst, v_buff_size capacity) const {
+
+  const v_uint8* ip = (const v_uint8*) src;
+  const v_uint8* inEnd = ip + size;
+  v_uint8* out = (v_uint8*) dst;
+  v_buff_size op = 0;
+
+  while(ip < inEnd) {
+
+    v_uint8 token = *ip ++;
+
+    v_buff_size literalsSize = token >> 4;
+    if(literalsSize == 15 && !lzReadLength(ip, inEnd, literalsSize)) {
+      return -1;
+    }
+
+    if(inEnd - ip < literalsSize || capacity - op < literalsSize) {
+      return -1;
+    }
+    std::memcpy(out + op, ip, literalsSize);
+    ip += literalsSize;
+    op += literalsSize;
+
+    if(ip == inEnd) {
+      break; // last sequence
+    }
+
+    if(inEnd - ip < 2) {
+      return -1;
+    }
+    v_buff_size offset = ip[0] | ((v_buff_size) ip[1] << 8);
+    ip += 2;
+    if(offset == 0 || offset > op) {
+      return -1;
+    }
+
+    v_buff_size matchSize = token & 15;
+    if(matchSize == 15 && !lzReadLength(ip, inEnd, matchSize)) {
+      return -1;
+    }
+    matchSize += LZ_MIN_MATCH;
+
+    if(capacity - op < matchSize) {
+      return -1;
+    }
+
+    // byte by byte - the match may overlap the output being written
+    v_uint8* match = out + op - offset;
+    for(v_buff_size i = 0; i < matchSize; i ++) {
+      out[op + i] = match[i];
+    }
+    op += matchSize;
+
+  }
+
+  return op;
+
+}
+
+#ifdef OATPP_BOB_WITH_ZLIB
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ZlibCodec
+
+ZlibCodec::ZlibCodec(v_int32 level)
+  : m_level(level)
+{}
+
+v_uint8 ZlibCodec::getId() const {
+  return ID_ZLIB;
+}
+
+v_buff_size ZlibCodec::getMaxCompressedSize(v_buff_size size) const {
+  return (v_buff_size) compressBound((uLong) size);
+}
+
+v_buff_size ZlibCodec::compress(const void* src, v_buff_size size, void* dst, v_buff_size capacity) const {
+  uLongf dstSize = (uLongf) capacity;
+  if(compress2((Bytef*) dst, &dstSize, (const Bytef*) src, (uLong) size, m_level) != Z_OK) {
+    return -1;
+  }
+  return (v_buff_size) dstSize;
+}
+
+v_buff_size ZlibCodec::decompress(const void* src, v_buff_size size, void* dst, v_buff_size capacity) const {
+  uLongf dstSize = (uLongf) capacity;
+  if(uncompress((Bytef*) dst, &dstSize, (const Bytef*) src, (uLong) size) != Z_OK) {
+    return -1;
+  }
+  return (v_buff_size) dstSize;
+}
+
+#endif
+
+#ifdef OATPP_BOB_WITH_ZSTD
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ZstdCodec
+
+ZstdCodec::ZstdCodec(v_int32 level)
+  : m_level(level)
+{}
+
+v_uint8 ZstdCodec::getId() const {
+  return ID_ZSTD;
+}
+
+v_buff_size ZstdCodec::getMaxCompressedSize(v_buff_size size) const {
+  return (v_buff_size) ZSTD_compressBound((size_t) size);
+}
+
+v_buff_size ZstdCodec::compress(const void* src, v_buff_size size, void* dst, v_buff_size capacity) const {
+  size_t res = ZSTD_compress(dst, (size_t) capacity, src, (size_t) size, m_level);
+  if(ZSTD_isError(res)) {
+    return -1;
+  }
+  return (v_buff_size) res;
+}
+
+v_buff_size ZstdCodec::decompress(const void* src, v_buff_size size, void* dst, v_buff_size capacity) const {
+  size_t res = ZSTD_decompress(dst, (size_t) capacity, src, (size_t) size);
+  if(ZSTD_isError(res)) {
+    return -1;
+  }
+  return (v_buff_size) res;
+}
+
+#endif
+
+}}
@@ -0,0 +1,213 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_BOB_CODEC_HPP
+#define OATPP_BOB_CODEC_HPP
+
+#include "oatpp/core/parser/Caret.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include <memory>
+
+namespace oatpp { namespace bob {
+
+/**
+ * Block compression codec used for compressed BOB frames. <br>
+ * Each block is compressed independently, so implementations must not keep state between calls.
+ * See &id:oatpp::bob::CompressingOutputStream;.
+ */
+class Codec {
+public:
+
+  /**
+   * Id of the dependency-free LZ codec. See &l:LzCodec;.
+   */
+  static constexpr const v_uint8 ID_LZ = 1;
+
+  /**
+   * Id of the zlib codec. See &l:ZlibCodec;.
+   */
+  static constexpr const v_uint8 ID_ZLIB = 2;
+
+  /**
+   * Id of the zstd codec. See &l:ZstdCodec;.
+   */
+  static constexpr const v_uint8 ID_ZSTD = 3;
+
+public:
+
+  /**
+   * Control byte starting a compressed frame.
+   */
+  static constexpr const v_char8 FRAME_BEGIN = 'Z';
+
+  /**
+   * Default limit for the total size of the decompressed frame - 256 MB.
+   */
+  static constexpr const v_buff_size DEFAULT_MAX_FRAME_SIZE = 256 * 1024 * 1024;
+
+  /**
+   * Upper limit for the size of a single uncompressed block - 64 MB.
+   * Frames with larger blocks are rejected by &l:Codec::readFrame ();.
+   */
+  static constexpr const v_buff_size MAX_BLOCK_SIZE = 64 * 1024 * 1024;
+
+public:
+
+  /**
+   * Default virtual destructor.
+   */
+  virtual ~Codec() = default;
+
+  /**
+   * Id of the codec written to the frame header. Ids below 128 are reserved for built-in codecs.
+   * @return
+   */
+  virtual v_uint8 getId() const = 0;
+
+  /**
+   * Max size of the compressed data for the input of the given size.
+   * @param size - size of the input.
+   * @return
+   */
+  virtual v_buff_size getMaxCompressedSize(v_buff_size size) const = 0;
+
+  /**
+   * Compress block.
+   * @param src - input data.
+   * @param size - size of the input.
+   * @param dst - output buffer.
+   * @param capacity - size of the output buffer.
+   * @return - size of the compressed data, or `-1` on error.
+   */
+  virtual v_buff_size compress(const void* src, v_buff_size size, void* dst, v_buff_size capacity) const = 0;
+
+  /**
+   * Decompress block.
+   * @param src - compressed data.
+   * @param size - size of the compressed data.
+   * @param dst - output buffer. Its capacity is exactly the size of the original data.
+   * @param capacity - size of the output buffer.
+   * @return - size of the decompressed data, or `-1` on error.
+   */
+  virtual v_buff_size decompress(const void* src, v_buff_size size, void* dst, v_buff_size capacity) const = 0;
+
+public:
+
+  /**
+   * Get built-in codec by id.
+   * @param id - codec id.
+   * @return - codec or `nullptr` if there is no such codec (or the library for the codec was not found at build time).
+   */
+  static std::shared_ptr<Codec> getBuiltinCodec(v_uint8 id);
+
+  /**
+   * Read compressed frame. The caret must be at &l:Codec::FRAME_BEGIN;. <br>
+   * On success the caret is positioned right after the frame.
+   * @param caret - &id:oatpp::parser::Caret;.
+   * @param codec - codec to use if its id matches the id in the frame header. Built-in codec is used otherwise.
+   * @param maxSize - max total size of the decompressed data. Larger frames are rejected.
+   * @return - decompressed data. In case of error the error is set on the caret.
+   */
+  static oatpp::String readFrame(oatpp::parser::Caret& caret, const std::shared_ptr<Codec>& codec,
+                                 v_buff_size maxSize = DEFAULT_MAX_FRAME_SIZE);
+
+};
+
+/**
+ * Dependency-free byte-oriented LZ codec (LZ77 family, in the spirit of LZ4). <br>
+ * Favours speed over ratio - suitable for compressing data on the fly.
+ */
+class LzCodec : public Codec {
+public:
+
+  v_uint8 getId() const override;
+
+  v_buff_size getMaxCompressedSize(v_buff_size size) const override;
+
+  v_buff_size compress(const void* src, v_buff_size size, void* dst, v_buff_size capacity) const override;
+
+  v_buff_size decompress(const void* src, v_buff_size size, void* dst, v_buff_size capacity) const override;
+
+};
+
+#ifdef OATPP_BOB_WITH_ZLIB
+
+/**
+ * zlib (deflate) codec. Available when zlib is found at configure time.
+ */
+class ZlibCodec : public Codec {
+private:
+  v_int32 m_level;
+public:
+
+  /**
+   * Constructor.
+   * @param level - compression level `[1..9]`.
+   */
+  ZlibCodec(v_int32 level = 6);
+
+  v_uint8 getId() const override;
+
+  v_buff_size getMaxCompressedSize(v_buff_size size) const override;
+
+  v_buff_size compress(const void* src, v_buff_size size, void* dst, v_buff_size capacity) const override;
+
+  v_buff_size decompress(const void* src, v_buff_size size, void* dst, v_buff_size capacity) const override;
+
+};
+
+#endif
+
+#ifdef OATPP_BOB_WITH_ZSTD
+
+/**
+ * Zstandard codec. Available when zstd is found at configure time.
+ */
+class ZstdCodec : public Codec {
+private:
+  v_int32 m_level;
+public:
+
+  /**
+   * Constructor.
+   * @param level - compression level.
+   */
+  ZstdCodec(v_int32 level = 3);
+
+  v_uint8 getId() const override;
+
+  v_buff_size getMaxCompressedSize(v_buff_size size) const override;
+
+  v_buff_size compress(const void* src, v_buff_size size, void* dst, v_buff_size capacity) const override;
+
+  v_buff_size decompress(const void* src, v_buff_size size, void* dst, v_buff_size capacity) const override;
+
+};
+
+#endif
+
+}}
+
+#endif /* OATPP_BOB_CODEC_HPP */
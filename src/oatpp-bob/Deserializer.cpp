@@ -27,10 +27,17 @@
 #include "oatpp/core/data/stream/BufferStream.hpp"
 #include "oatpp/core/utils/ConversionUtils.hpp"
 
+#include <chrono>
+#include <cstring>
+#include <limits>
+
 namespace oatpp { namespace bob {
 
+thread_local Deserializer::Session* Deserializer::CURRENT_SESSION = nullptr;
+
 Deserializer::Deserializer(const std::shared_ptr<Config>& config)
   : m_config(config)
+  , m_statistics(config->statistics.get())
 {
 
   m_methods.resize(oatpp::data::mapping::type::ClassId::getClassCount(), nullptr);
@@ -74,8 +81,152 @@ void Deserializer::setDeserializerMethod(const oatpp::data::mapping::type::Class
   m_methods[id] = method;
 }
 
+oatpp::String Deserializer::readKey(oatpp::parser::Caret& caret) {
+
+  if(!caret.isAtChar(Utils::KEY_REFERENCE)) {
+    return Utils::readCString(caret);
+  }
+
+  const v_buff_size position = caret.getPosition();
+  caret.inc();
+  v_uint64 distance = Utils::readVarUInt(caret);
+  if(caret.hasError()) {
+    return nullptr;
+  }
+
+  if(distance == 0 || distance > (v_uint64) position) {
+    caret.setError("[oatpp::bob::Deserializer::readKey()]: Error. Invalid key reference.");
+    return nullptr;
+  }
+
+  /* referenced key must be a plain key located before the reference */
+  oatpp::parser::Caret keyCaret(caret.getData(), position);
+  keyCaret.setPosition(position - distance);
+  if(keyCaret.isAtChar(Utils::KEY_REFERENCE)) {
+    caret.setError("[oatpp::bob::Deserializer::readKey()]: Error. Invalid key reference.");
+    return nullptr;
+  }
+
+  auto key = Utils::readCString(keyCaret);
+  if(keyCaret.hasError()) {
+    caret.setError("[oatpp::bob::Deserializer::readKey()]: Error. Invalid key reference.");
+    return nullptr;
+  }
+
+  return key;
+
+}
+
+oatpp::String Deserializer::readStringReference(oatpp::parser::Caret& caret) {
+
+  const v_buff_size position = caret.getPosition();
+  caret.inc();
+  v_uint64 distance = Utils::readVarUInt(caret);
+  if(caret.hasError()) {
+    return nullptr;
+  }
+
+  if(distance == 0 || distance > (v_uint64) position) {
+    caret.setError("[oatpp::bob::Deserializer::readStringReference()]: Error. Invalid string reference.");
+    return nullptr;
+  }
+
+  const v_buff_size target = position - distance;
+
+  Session* session = CURRENT_SESSION;
+  if(session && session->data == caret.getData()) {
+    auto it = session->strings.find(target);
+    if(it != session->strings.end()) {
+      return it->second;
+    }
+  }
+
+  /* referenced string must be a plain string located before the reference */
+  oatpp::parser::Caret stringCaret(caret.getData(), position);
+  stringCaret.setPosition(target);
+  if(!stringCaret.isAtOneOfChars("sS$")) {
+    caret.setError("[oatpp::bob::Deserializer::readStringReference()]: Error. Invalid string reference.");
+    return nullptr;
+  }
+
+  oatpp::String result = deserializeString(nullptr, stringCaret, oatpp::String::Class::getType()).cast<oatpp::String>();
+  if(stringCaret.hasError()) {
+    caret.setError("[oatpp::bob::Deserializer::readStringReference()]: Error. Invalid string reference.");
+    return nullptr;
+  }
+
+  if(session && session->data == caret.getData()) {
+    session->strings.insert({target, result});
+  }
+
+  return result;
+
+}
+
+bool Deserializer::readContainerBegin(oatpp::parser::Caret& caret, v_char8 tag, v_char8 sizedTag, ContainerHeader& header) {
+
+  header.count = -1;
+  header.end = -1;
+  header.stride = 0;
+
+  if(caret.canContinueAtChar(tag, 1)) {
+    header.valuesStart = caret.getPosition();
+    return true;
+  }
+
+  const bool indexed = tag == Utils::CONTROL_ARRAY_BEGIN && caret.isAtChar(Utils::CONTROL_ARRAY_INDEXED);
+  if(!indexed && !caret.isAtChar(sizedTag)) {
+    return false;
+  }
+
+  caret.inc();
+  v_uint32 size = (v_uint32) Utils::readInt32(caret, Utils::BO_TYPE::NETWORK);
+  header.count = (v_uint32) Utils::readInt32(caret, Utils::BO_TYPE::NETWORK);
+  header.end = caret.getPosition() + size;
+  if(indexed) {
+    header.stride = Utils::readInt32(caret, Utils::BO_TYPE::NETWORK);
+  }
+  header.valuesStart = caret.getPosition();
+
+  if(caret.hasError()) {
+    return false;
+  }
+
+  if(header.end > caret.getDataSize() || header.end <= header.valuesStart || (indexed && header.stride <= 0)) {
+    caret.setError("[oatpp::bob::Deserializer::readContainerBegin()]: Error. Invalid container header.");
+    return false;
+  }
+
+  return true;
+
+}
+
+bool Deserializer::readContainerEnd(oatpp::parser::Caret& caret, const ContainerHeader& header, v_int64 count) {
+
+  if(header.count >= 0 && header.count != count) {
+    caret.setError("[oatpp::bob::Deserializer::readContainerEnd()]: Error. Invalid number of elements.");
+    return false;
+  }
+
+  if(header.end >= 0) {
+    if(caret.getPosition() > header.end) {
+      caret.setError("[oatpp::bob::Deserializer::readContainerEnd()]: Error. Invalid container size.");
+      return false;
+    }
+    caret.setPosition(header.end); // skip the offset index
+  }
+
+  return true;
+
+}
+
 void Deserializer::skipKey(oatpp::parser::Caret& caret) {
 
+    if(caret.canContinueAtChar(Utils::KEY_REFERENCE, 1)) {
+      Utils::readVarUInt(caret);
+      return;
+    }
+
     while(!caret.isAtChar(0)) {
       caret.inc();
     }
@@ -148,6 +299,98 @@ void Deserializer::skipArray(oatpp::parser::Caret& caret) {
 
 }
 
+void Deserializer::skipColumns(oatpp::parser::Caret& caret) {
+
+  caret.inc(); // 'C'
+
+  Utils::readVarUInt(caret);
+  const v_uint64 columnsCount = Utils::readVarUInt(caret);
+  if(caret.hasError()) return;
+
+  for(v_uint64 c = 0; c < columnsCount; c ++) {
+
+    skipKey(caret);
+    if(caret.hasError()) return;
+
+    caret.inc(); // column type
+    v_uint32 size = (v_uint32) Utils::readInt32(caret, Utils::BO_TYPE::NETWORK);
+    if(caret.hasError()) return;
+
+    if(size > caret.getDataSize() - caret.getPosition()) {
+      caret.setError("[oatpp::bob::Deserializer::skipColumns()]: Error. Invalid column size.");
+      return;
+    }
+    caret.inc(size);
+
+  }
+
+  if(!caret.canContinueAtChar(Utils::CONTROL_SECTION_END, 1)){
+    caret.setError("[oatpp::bob::Deserializer::skipColumns()]: Error. ')' - expected", ERROR_CODE_ARRAY_SCOPE_CLOSE);
+  }
+
+}
+
+void Deserializer::skipSizedContainer(oatpp::parser::Caret& caret) {
+
+  const bool indexed = caret.isAtChar(Utils::CONTROL_ARRAY_INDEXED);
+  caret.inc(); // 'M', 'A' or 'X'
+
+  v_uint32 size = (v_uint32) Utils::readInt32(caret, Utils::BO_TYPE::NETWORK);
+  Utils::readInt32(caret, Utils::BO_TYPE::NETWORK);
+  if(caret.hasError()) return;
+
+  if(size == 0 || size > caret.getDataSize() - caret.getPosition() ||
+     (!indexed && caret.getCurrData()[size - 1] != Utils::CONTROL_SECTION_END))
+  {
+    caret.setError("[oatpp::bob::Deserializer::skipSizedContainer()]: Error. Invalid container size.");
+    return;
+  }
+
+  caret.inc(size);
+
+}
+
+void Deserializer::skipPositionalObject(oatpp::parser::Caret& caret) {
+
+  caret.inc(); // 'P'
+
+  Utils::readInt32(caret, Utils::BO_TYPE::NETWORK);
+  const v_uint64 keysCount = Utils::readVarUInt(caret);
+  if(caret.hasError()) return;
+
+  for(v_uint64 i = 0; i < keysCount; i ++) {
+    skipKey(caret);
+    if(caret.hasError()) return;
+  }
+
+  while(!caret.isAtChar(Utils::CONTROL_SECTION_END) && caret.canContinue()) {
+    skipValue(caret);
+    if(caret.hasError()) return;
+  }
+
+  if(!caret.canContinueAtChar(Utils::CONTROL_SECTION_END, 1)){
+    caret.setError("[oatpp::bob::Deserializer::skipPositionalObject()]: Error. ')' - expected", ERROR_CODE_OBJECT_SCOPE_CLOSE);
+  }
+
+}
+
+void Deserializer::skipObjectWithIds(oatpp::parser::Caret& caret) {
+
+  caret.inc(); // '#'
+
+  while(!caret.isAtChar(Utils::CONTROL_SECTION_END) && caret.canContinue()) {
+    Utils::readVarUInt(caret);
+    if(caret.hasError()) return;
+    skipValue(caret);
+    if(caret.hasError()) return;
+  }
+
+  if(!caret.canContinueAtChar(Utils::CONTROL_SECTION_END, 1)){
+    caret.setError("[oatpp::bob::Deserializer::skipObjectWithIds()]: Error. ')' - expected", ERROR_CODE_OBJECT_SCOPE_CLOSE);
+  }
+
+}
+
 void Deserializer::skipValue(oatpp::parser::Caret& caret) {
 
   v_char8 c = *caret.getCurrData();
@@ -159,11 +402,24 @@ void Deserializer::skipValue(oatpp::parser::Caret& caret) {
     case Utils::TYPE_STRING_2:
     case Utils::TYPE_STRING_4: skipString(caret);
       break;
+    case Utils::TYPE_STRING_REFERENCE: caret.inc();
+      Utils::readVarUInt(caret);
+      break;
 
     case Utils::CONTROL_MAP_BEGIN: skipMap(caret);
       break;
     case Utils::CONTROL_ARRAY_BEGIN: skipArray(caret);
       break;
+    case Utils::CONTROL_COLUMNS_BEGIN: skipColumns(caret);
+      break;
+    case Utils::CONTROL_MAP_SIZED:
+    case Utils::CONTROL_ARRAY_SIZED:
+    case Utils::CONTROL_ARRAY_INDEXED: skipSizedContainer(caret);
+      break;
+    case Utils::CONTROL_OBJECT_POSITIONAL: skipPositionalObject(caret);
+      break;
+    case Utils::CONTROL_OBJECT_IDS: skipObjectWithIds(caret);
+      break;
 
     case Utils::TYPE_BOOL_TRUE: caret.inc();
       break;
@@ -550,6 +806,10 @@ oatpp::Void Deserializer::deserializeString(Deserializer* deserializer, oatpp::p
     return oatpp::Void(type);
   }
 
+  if(caret.isAtChar(Utils::TYPE_STRING_REFERENCE)) {
+    return readStringReference(caret);
+  }
+
   v_int64 size;
   if(caret.isAtChar(Utils::TYPE_STRING_1)) {
     caret.inc();
@@ -572,6 +832,7 @@ oatpp::Void Deserializer::deserializeString(Deserializer* deserializer, oatpp::p
 
   oatpp::String result(caret.getCurrData(), size);
   caret.inc(size);
+  AllocationCounter::recordValue(result);
   return result;
 
 }
@@ -585,6 +846,16 @@ oatpp::Void Deserializer::deserializeStringDebug(Deserializer* deserializer, oat
     return oatpp::Void(type);
   }
 
+  if(caret.isAtChar(Utils::TYPE_STRING_REFERENCE)) {
+    auto value = readStringReference(caret);
+    if(caret.hasError()) {
+      return nullptr;
+    }
+    oatpp::data::stream::BufferOutputStream ss(64);
+    ss << "[ref:" << (v_int64) value->size() << "]";
+    return ss.toString();
+  }
+
   oatpp::String typeName = "";
 
   v_int64 size;
@@ -625,10 +896,15 @@ const oatpp::Type* Deserializer::guessType(oatpp::parser::Caret& caret) {
     switch (c) {
       case Utils::TYPE_STRING_1:
       case Utils::TYPE_STRING_2:
-      case Utils::TYPE_STRING_4: return String::Class::getType();
+      case Utils::TYPE_STRING_4:
+      case Utils::TYPE_STRING_REFERENCE: return String::Class::getType();
 
-      case Utils::CONTROL_MAP_BEGIN: return oatpp::Fields<oatpp::Any>::Class::getType();
-      case Utils::CONTROL_ARRAY_BEGIN: return oatpp::Vector<oatpp::Any>::Class::getType();
+      case Utils::CONTROL_MAP_BEGIN:
+      case Utils::CONTROL_MAP_SIZED: return oatpp::Fields<oatpp::Any>::Class::getType();
+      case Utils::CONTROL_ARRAY_BEGIN:
+      case Utils::CONTROL_ARRAY_SIZED:
+      case Utils::CONTROL_ARRAY_INDEXED: return oatpp::Vector<oatpp::Any>::Class::getType();
+      case Utils::CONTROL_COLUMNS_BEGIN: return oatpp::Vector<oatpp::Fields<oatpp::Any>>::Class::getType();
 
       case Utils::TYPE_BOOL_TRUE: return oatpp::Boolean::Class::getType();
       case Utils::TYPE_BOOL_FALSE: return oatpp::Boolean::Class::getType();
@@ -650,6 +926,31 @@ const oatpp::Type* Deserializer::guessType(oatpp::parser::Caret& caret) {
   return nullptr;
 }
 
+bool Deserializer::isIntegralType(const Type* type) {
+  auto id = type->classId.id;
+  return id == oatpp::Int8::Class::CLASS_ID.id  || id == oatpp::UInt8::Class::CLASS_ID.id  ||
+         id == oatpp::Int16::Class::CLASS_ID.id || id == oatpp::UInt16::Class::CLASS_ID.id ||
+         id == oatpp::Int32::Class::CLASS_ID.id || id == oatpp::UInt32::Class::CLASS_ID.id ||
+         id == oatpp::Int64::Class::CLASS_ID.id || id == oatpp::UInt64::Class::CLASS_ID.id;
+}
+
+bool Deserializer::isAtInteger(oatpp::parser::Caret& caret) {
+  if(!caret.canContinue()) {
+    return false;
+  }
+  switch (*caret.getCurrData()) {
+    case Utils::TYPE_INT_1:
+    case Utils::TYPE_UINT_1:
+    case Utils::TYPE_INT_2:
+    case Utils::TYPE_UINT_2:
+    case Utils::TYPE_INT_4:
+    case Utils::TYPE_UINT_4:
+    case Utils::TYPE_INT_8:
+    case Utils::TYPE_UINT_8: return true;
+  }
+  return false;
+}
+
 oatpp::Void Deserializer::deserializeAny(Deserializer* deserializer, oatpp::parser::Caret& caret, const Type* const type) {
 
   if(caret.isAtChar(Utils::TYPE_NULL)) {
@@ -676,10 +977,26 @@ oatpp::Void Deserializer::deserializeEnum(Deserializer* deserializer, oatpp::par
   );
 
   oatpp::data::mapping::type::EnumInterpreterError e = oatpp::data::mapping::type::EnumInterpreterError::OK;
-  const auto& value = deserializer->deserialize(caret, polymorphicDispatcher->getInterpretationType());
-  if(caret.hasError()) {
-    return nullptr;
+  auto interpretationType = polymorphicDispatcher->getInterpretationType();
+
+  oatpp::Void value;
+  if(isAtInteger(caret) && (deserializer->m_config->enumsAsOrdinals || !isIntegralType(interpretationType))) {
+    auto ordinal = deserializeUInt32(deserializer, caret, oatpp::UInt32::Class::getType());
+    if(caret.hasError()) {
+      return nullptr;
+    }
+    value = deserializer->getEnumInterpretation(type, *static_cast<v_uint32*>(ordinal.get()));
+    if(!value) {
+      caret.setError("[oatpp::bob::Deserializer::deserializeEnum()]: Error. Enum ordinal is out of range.");
+      return nullptr;
+    }
+  } else {
+    value = deserializer->deserialize(caret, interpretationType);
+    if(caret.hasError()) {
+      return nullptr;
+    }
   }
+
   const auto& result = polymorphicDispatcher->fromInterpretation(value, e);
 
   if(e == oatpp::data::mapping::type::EnumInterpreterError::OK) {
@@ -705,12 +1022,18 @@ oatpp::Void Deserializer::deserializeCollection(Deserializer* deserializer, oatp
     return oatpp::Void(type);
   }
 
-  if(caret.canContinueAtChar(Utils::CONTROL_ARRAY_BEGIN, 1)) {
+  if(caret.isAtChar(Utils::CONTROL_COLUMNS_BEGIN)) {
+    return deserializeColumns(deserializer, caret, type);
+  }
+
+  ContainerHeader header;
+  if(readContainerBegin(caret, Utils::CONTROL_ARRAY_BEGIN, Utils::CONTROL_ARRAY_SIZED, header)) {
 
     auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::Collection::PolymorphicDispatcher*>(type->polymorphicDispatcher);
     auto collection = dispatcher->createObject();
 
     auto itemType = dispatcher->getItemType();
+    v_int64 itemsCount = 0;
 
     while(!caret.isAtChar(Utils::CONTROL_SECTION_END) && caret.canContinue()) {
 
@@ -720,6 +1043,7 @@ oatpp::Void Deserializer::deserializeCollection(Deserializer* deserializer, oatp
       }
 
       dispatcher->addItem(collection, item);
+      itemsCount ++;
 
     }
 
@@ -730,150 +1054,926 @@ oatpp::Void Deserializer::deserializeCollection(Deserializer* deserializer, oatp
       return nullptr;
     };
 
+    if(!readContainerEnd(caret, header, itemsCount)) {
+      return nullptr;
+    }
+
     return collection;
 
-  } else {
+  } else if(!caret.hasError()) {
     caret.setError("[oatpp::bob::Deserializer::deserializeCollection()]: Error. '[' - expected", ERROR_CODE_ARRAY_SCOPE_OPEN);
-    return nullptr;
   }
 
+  return nullptr;
+
 }
 
-oatpp::Void Deserializer::deserializeMap(Deserializer* deserializer, oatpp::parser::Caret& caret, const Type* const type) {
+std::vector<oatpp::Void> Deserializer::decodeColumn(Deserializer* deserializer,
+                                                    oatpp::parser::Caret& column,
+                                                    v_char8 columnType,
+                                                    v_buff_size rowsCount,
+                                                    const std::function<const Type*(v_buff_size)>& getType)
+{
 
-  if(caret.isAtChar(Utils::TYPE_NULL)){
-    caret.inc();
-    return oatpp::Void(type);
+  std::vector<oatpp::Void> values(rowsCount);
+
+  if(columnType == Utils::COLUMN_VALUES) {
+    for(v_buff_size i = 0; i < rowsCount; i ++) {
+      values[i] = deserializer->deserialize(column, getType(i));
+      if(column.hasError()) {
+        return {};
+      }
+    }
+    return values;
   }
 
-  if(caret.canContinueAtChar(Utils::CONTROL_MAP_BEGIN, 1)) {
+  v_buff_size width;
+  switch(columnType) {
+    case Utils::TYPE_INT_1:
+    case Utils::TYPE_UINT_1: width = 1; break;
+    case Utils::TYPE_INT_2:
+    case Utils::TYPE_UINT_2: width = 2; break;
+    case Utils::TYPE_INT_4:
+    case Utils::TYPE_UINT_4:
+    case Utils::TYPE_FLOAT_4: width = 4; break;
+    case Utils::TYPE_INT_8:
+    case Utils::TYPE_UINT_8:
+    case Utils::TYPE_FLOAT_8: width = 8; break;
+    case Utils::TYPE_BOOL_TRUE:
+    case Utils::TYPE_STRING_4: width = 0; break;
+    default:
+      column.setError("[oatpp::bob::Deserializer::decodeColumn()]: Error. Unknown column type.");
+      return {};
+  }
 
-    auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::Map::PolymorphicDispatcher*>(type->polymorphicDispatcher);
-    auto map = dispatcher->createObject();
+  /* null bitmap */
 
-    auto keyType = dispatcher->getKeyType();
-    if(keyType->classId != oatpp::String::Class::CLASS_ID){
-      throw std::runtime_error("[oatpp::bob::Deserializer::deserializeMap()]: Invalid json map key. Key should be String");
+  const v_buff_size bitmapSize = (rowsCount + 7) / 8;
+  if(column.getDataSize() - column.getPosition() < bitmapSize) {
+    column.setError("[oatpp::bob::Deserializer::decodeColumn()]: Error. Invalid column size.");
+    return {};
+  }
+  p_char8 bitmap = (p_char8) column.getCurrData();
+  column.inc(bitmapSize);
+
+  std::vector<v_buff_size> rows;
+  for(v_buff_size i = 0; i < rowsCount; i ++) {
+    if(bitmap[i / 8] & (1 << (i % 8))) {
+      rows.push_back(i);
     }
-    auto valueType = dispatcher->getValueType();
+  }
 
-    while (!caret.isAtChar(Utils::CONTROL_SECTION_END) && caret.canContinue()) {
+  const v_buff_size available = column.getDataSize() - column.getPosition();
+  p_char8 data = (p_char8) column.getCurrData();
 
-      auto key = Utils::readCString(caret);
-      if(caret.hasError()){
-        return nullptr;
-      }
+  /* cells are decoded with the regular deserializer methods - this handles type conversions */
+  v_char8 cell[9];
 
-      auto item = deserializer->deserialize(caret, valueType);
-      if(caret.hasError()){
-        return nullptr;
-      }
-      dispatcher->addItem(map, key, item);
+  if(width > 0) {
 
+    if(available < width * (v_buff_size) rows.size()) {
+      column.setError("[oatpp::bob::Deserializer::decodeColumn()]: Error. Invalid column size.");
+      return {};
     }
 
-    if(!caret.canContinueAtChar(Utils::CONTROL_SECTION_END, 1)){
-      if(!caret.hasError()){
-        caret.setError("[oatpp::bob::Deserializer::deserializeMap()]: Error. ')' - expected", ERROR_CODE_OBJECT_SCOPE_CLOSE);
+    cell[0] = columnType;
+    for(v_buff_size k = 0; k < (v_buff_size) rows.size(); k ++) {
+      std::memcpy(cell + 1, data + k * width, width);
+      oatpp::parser::Caret cellCaret((const char*) cell, width + 1);
+      values[rows[k]] = deserializer->deserialize(cellCaret, getType(rows[k]));
+      if(cellCaret.hasError()) {
+        column.setError("[oatpp::bob::Deserializer::decodeColumn()]: Error. Invalid column value.");
+        return {};
       }
-      return nullptr;
     }
 
-    return map;
-
-  } else {
-    caret.setError("[oatpp::bob::Deserializer::deserializeMap()]: Error. '{' - expected", ERROR_CODE_OBJECT_SCOPE_OPEN);
-  }
+  } else if(columnType == Utils::TYPE_BOOL_TRUE) {
 
-  return nullptr;
+    if(available < ((v_buff_size) rows.size() + 7) / 8) {
+      column.setError("[oatpp::bob::Deserializer::decodeColumn()]: Error. Invalid column size.");
+      return {};
+    }
 
-}
+    for(v_buff_size k = 0; k < (v_buff_size) rows.size(); k ++) {
+      cell[0] = (data[k / 8] & (1 << (k % 8))) ? Utils::TYPE_BOOL_TRUE : Utils::TYPE_BOOL_FALSE;
+      oatpp::parser::Caret cellCaret((const char*) cell, 1);
+      values[rows[k]] = deserializer->deserialize(cellCaret, getType(rows[k]));
+      if(cellCaret.hasError()) {
+        column.setError("[oatpp::bob::Deserializer::decodeColumn()]: Error. Invalid column value.");
+        return {};
+      }
+    }
 
-oatpp::Void Deserializer::deserializeObject(Deserializer* deserializer, oatpp::parser::Caret& caret, const Type* const type) {
+  } else {
 
-  if(caret.isAtChar(Utils::TYPE_NULL)){
-    caret.inc();
-    return oatpp::Void(type);
-  }
+    /* strings - end offsets, then the blob */
 
-  if(caret.canContinueAtChar(Utils::CONTROL_MAP_BEGIN, 1)) {
+    const v_buff_size offsetsSize = ((v_buff_size) rows.size() + 1) * 4;
+    if(available < offsetsSize) {
+      column.setError("[oatpp::bob::Deserializer::decodeColumn()]: Error. Invalid column size.");
+      return {};
+    }
 
-    auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::AbstractObject::PolymorphicDispatcher*>(type->polymorphicDispatcher);
-    auto object = dispatcher->createObject();
-    const auto& fieldsMap = dispatcher->getProperties()->getMap();
+    oatpp::parser::Caret offsetsCaret((const char*) data, offsetsSize);
+    const char* blob = (const char*) data + offsetsSize;
+    const v_buff_size blobSize = available - offsetsSize;
 
-    std::vector<std::pair<oatpp::BaseObject::Property*, oatpp::String>> polymorphs;
-    while (!caret.isAtChar(Utils::CONTROL_SECTION_END) && caret.canContinue()) {
+    v_uint32 start = (v_uint32) Utils::readInt32(offsetsCaret, Utils::BO_TYPE::NETWORK);
+    for(v_buff_size k = 0; k < (v_buff_size) rows.size(); k ++) {
 
-      auto key = Utils::readCString(caret);
-      if(caret.hasError()){
-        return nullptr;
+      v_uint32 end = (v_uint32) Utils::readInt32(offsetsCaret, Utils::BO_TYPE::NETWORK);
+      if(end < start || end > blobSize) {
+        column.setError("[oatpp::bob::Deserializer::decodeColumn()]: Error. Invalid string offset.");
+        return {};
       }
 
-      auto fieldIterator = fieldsMap.find(key);
-      if(fieldIterator != fieldsMap.end()) {
-
-        auto field = fieldIterator->second;
-
-        if(field->info.typeSelector && field->type == oatpp::Any::Class::getType()) {
-          auto label = caret.putLabel();
-          skipValue(caret);
-          polymorphs.emplace_back(field, label.toString()); // store polymorphs for later processing.
-        } else {
-          field->set(static_cast<oatpp::BaseObject *>(object.get()), deserializer->deserialize(caret, field->type));
-        }
-
-      } else if (deserializer->getConfig()->allowUnknownFields) {
-        skipValue(caret);
+      const Type* type = getType(rows[k]);
+      if(type == oatpp::String::Class::getType()) {
+        values[rows[k]] = oatpp::String(blob + start, end - start);
+        AllocationCounter::recordValue(values[rows[k]]);
       } else {
-        caret.setError("[oatpp::bob::Deserializer::readObject()]: Error. Unknown field", ERROR_CODE_OBJECT_SCOPE_UNKNOWN_FIELD);
-        return nullptr;
+        std::string encoded;
+        encoded.push_back((char) Utils::TYPE_STRING_4);
+        oatpp::data::stream::BufferOutputStream header(8);
+        Utils::writeInt32(&header, (v_int32) (end - start), Utils::BO_TYPE::NETWORK);
+        encoded.append((const char*) header.getData(), header.getCurrentPosition());
+        encoded.append(blob + start, end - start);
+        oatpp::parser::Caret cellCaret(encoded.data(), encoded.size());
+        values[rows[k]] = deserializer->deserialize(cellCaret, type);
+        if(cellCaret.hasError()) {
+          column.setError("[oatpp::bob::Deserializer::decodeColumn()]: Error. Invalid column value.");
+          return {};
+        }
       }
 
-    }
-
-    if(!caret.canContinueAtChar(Utils::CONTROL_SECTION_END, 1)){
-      if(!caret.hasError()){
-        caret.setError("[oatpp::bob::Deserializer::readObject()]: Error. ')' - expected", ERROR_CODE_OBJECT_SCOPE_CLOSE);
-      }
-      return nullptr;
-    }
+      start = end;
 
-    for(auto& p : polymorphs) {
-      oatpp::parser::Caret polyCaret(p.second);
-      auto selectedType = p.first->info.typeSelector->selectType(static_cast<oatpp::BaseObject *>(object.get()));
-      auto value = deserializer->deserialize(polyCaret, selectedType);
-      oatpp::Any any(value);
-      p.first->set(static_cast<oatpp::BaseObject *>(object.get()), oatpp::Void(any.getPtr(), p.first->type));
     }
 
-    return object;
-
-  } else {
-    caret.setError("[oatpp::bob::Deserializer::deserializeObject()]: Error. '{' - expected", ERROR_CODE_OBJECT_SCOPE_OPEN);
   }
 
-  return nullptr;
+  return values;
 
 }
 
-oatpp::Void Deserializer::deserialize(oatpp::parser::Caret& caret, const Type* const type) {
-  auto id = type->classId.id;
-  auto& method = m_methods[id];
-  if(method) {
-    return (*method)(this, caret, type);
-  } else {
+oatpp::Void Deserializer::deserializeColumns(Deserializer* deserializer, oatpp::parser::Caret& caret, const Type* const type) {
 
-    auto* interpretation = type->findInterpretation(m_config->enabledInterpretations);
-    if(interpretation) {
-      return interpretation->fromInterpretation(deserialize(caret, interpretation->getInterpretationType()));
-    }
+  caret.inc(); // 'C'
+
+  const v_uint64 rowsCount = Utils::readVarUInt(caret);
+  const v_uint64 columnsCount = Utils::readVarUInt(caret);
+  if(caret.hasError()) {
+    return nullptr;
+  }
+
+  /* each column takes at least 6 bytes - key, type and size */
+  if((columnsCount == 0 && rowsCount > 0) || columnsCount > (v_uint64) (caret.getDataSize() - caret.getPosition()) / 6) {
+    caret.setError("[oatpp::bob::Deserializer::deserializeColumns()]: Error. Invalid columns header.");
+    return nullptr;
+  }
+
+  auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::Collection::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+  auto itemType = dispatcher->getItemType();
+
+  const oatpp::data::mapping::type::__class::AbstractObject::PolymorphicDispatcher* objectDispatcher = nullptr;
+  const oatpp::data::mapping::type::__class::Map::PolymorphicDispatcher* mapDispatcher = nullptr;
+  bool anyItems = false;
+
+  const Type* rowType = itemType;
+  if(itemType->classId == oatpp::data::mapping::type::__class::AbstractObject::CLASS_ID) {
+    objectDispatcher = static_cast<const oatpp::data::mapping::type::__class::AbstractObject::PolymorphicDispatcher*>(itemType->polymorphicDispatcher);
+  } else {
+    if(itemType->classId == oatpp::data::mapping::type::__class::Any::CLASS_ID) {
+      anyItems = true;
+      rowType = oatpp::Fields<oatpp::Any>::Class::getType();
+    }
+    if(rowType->classId != oatpp::data::mapping::type::__class::AbstractPairList::CLASS_ID &&
+       rowType->classId != oatpp::data::mapping::type::__class::AbstractUnorderedMap::CLASS_ID)
+    {
+      caret.setError("[oatpp::bob::Deserializer::deserializeColumns()]: Error. Can't read columns to the collection of this type.");
+      return nullptr;
+    }
+    mapDispatcher = static_cast<const oatpp::data::mapping::type::__class::Map::PolymorphicDispatcher*>(rowType->polymorphicDispatcher);
+    if(mapDispatcher->getKeyType()->classId != oatpp::String::Class::CLASS_ID){
+      caret.setError("[oatpp::bob::Deserializer::deserializeColumns()]: Error. Invalid map key. Key should be String.");
+      return nullptr;
+    }
+  }
+
+  /* column headers are validated before any row is created - the rows count is bounded by the actual column sizes */
+
+  struct ColumnHeader {
+    oatpp::String key;
+    v_char8 columnType;
+    v_buff_size start;
+    v_buff_size end;
+  };
+  std::vector<ColumnHeader> headers;
+  headers.reserve((size_t) columnsCount);
+
+  for(v_uint64 c = 0; c < columnsCount; c ++) {
+
+    auto key = readKey(caret);
+    if(caret.hasError()) {
+      return nullptr;
+    }
+
+    if(!caret.canContinue()) {
+      caret.setError("[oatpp::bob::Deserializer::deserializeColumns()]: Error. Column type expected.");
+      return nullptr;
+    }
+    v_char8 columnType = *caret.getCurrData();
+    caret.inc();
+
+    v_uint32 size = (v_uint32) Utils::readInt32(caret, Utils::BO_TYPE::NETWORK);
+    if(caret.hasError()) {
+      return nullptr;
+    }
+    if(size > caret.getDataSize() - caret.getPosition()) {
+      caret.setError("[oatpp::bob::Deserializer::deserializeColumns()]: Error. Invalid column size.");
+      return nullptr;
+    }
+
+    /* values column - at least one byte per row, packed column - at least the null bitmap */
+    const v_uint64 minSize = columnType == Utils::COLUMN_VALUES ? rowsCount : rowsCount / 8 + (rowsCount % 8 != 0 ? 1 : 0);
+    if(size < minSize) {
+      caret.setError("[oatpp::bob::Deserializer::deserializeColumns()]: Error. Invalid rows count.");
+      return nullptr;
+    }
+
+    headers.push_back({key, columnType, caret.getPosition(), caret.getPosition() + size});
+    caret.inc(size);
+
+  }
+
+  if(!caret.canContinueAtChar(Utils::CONTROL_SECTION_END, 1)){
+    if(!caret.hasError()){
+      caret.setError("[oatpp::bob::Deserializer::deserializeColumns()]: Error. ')' - expected", ERROR_CODE_ARRAY_SCOPE_CLOSE);
+    }
+    return nullptr;
+  }
+
+  std::vector<oatpp::Void> rows((size_t) rowsCount);
+  for(auto& row : rows) {
+    row = objectDispatcher ? objectDispatcher->createObject() : mapDispatcher->createObject();
+    AllocationCounter::recordValue(row);
+  }
+
+  struct DeferredColumn {
+    oatpp::BaseObject::Property* property;
+    v_char8 columnType;
+    v_buff_size start;
+    v_buff_size end;
+  };
+  std::vector<DeferredColumn> polymorphs;
+
+  for(auto& header : headers) {
+
+    /* parse in place - values may contain references to the preceding data */
+    oatpp::parser::Caret column(caret.getData(), header.end);
+    column.setPosition(header.start);
+
+    if(objectDispatcher) {
+
+      const auto& fieldsMap = objectDispatcher->getProperties()->getMap();
+      auto fieldIterator = fieldsMap.find(header.key);
+
+      if(fieldIterator == fieldsMap.end()) {
+        if(deserializer->getConfig()->allowUnknownFields) {
+          if(deserializer->m_statistics) {
+            deserializer->m_statistics->recordSkipped(header.end - header.start);
+          }
+          continue;
+        }
+        caret.setError("[oatpp::bob::Deserializer::deserializeColumns()]: Error. Unknown field", ERROR_CODE_OBJECT_SCOPE_UNKNOWN_FIELD);
+        return nullptr;
+      }
+
+      auto property = fieldIterator->second;
+      if(property->info.typeSelector && property->type == oatpp::Any::Class::getType()) {
+        polymorphs.push_back({property, header.columnType, header.start, header.end}); // type selector may depend on the columns which follow.
+        continue;
+      }
+
+      auto values = decodeColumn(deserializer, column, header.columnType, rowsCount, [property](v_buff_size) {
+        return property->type;
+      });
+      if(column.hasError()) {
+        caret.setError(column.getErrorMessage(), column.getErrorCode());
+        return nullptr;
+      }
+      for(v_buff_size i = 0; i < (v_buff_size) rowsCount; i ++) {
+        if(values[i]) {
+          property->set(static_cast<oatpp::BaseObject*>(rows[i].get()), values[i]);
+        }
+      }
+
+    } else {
+
+      auto valueType = mapDispatcher->getValueType();
+      auto values = decodeColumn(deserializer, column, header.columnType, rowsCount, [valueType](v_buff_size) {
+        return valueType;
+      });
+      if(column.hasError()) {
+        caret.setError(column.getErrorMessage(), column.getErrorCode());
+        return nullptr;
+      }
+      for(v_buff_size i = 0; i < (v_buff_size) rowsCount; i ++) {
+        mapDispatcher->addItem(rows[i], header.key, values[i] ? values[i] : oatpp::Void(valueType));
+      }
+
+    }
+
+  }
+
+  for(auto& p : polymorphs) {
+    oatpp::parser::Caret column(caret.getData(), p.end);
+    column.setPosition(p.start);
+    auto property = p.property;
+    auto values = decodeColumn(deserializer, column, p.columnType, rowsCount, [property, &rows](v_buff_size i) {
+      return property->info.typeSelector->selectType(static_cast<oatpp::BaseObject*>(rows[i].get()));
+    });
+    if(column.hasError()) {
+      caret.setError(column.getErrorMessage(), column.getErrorCode());
+      return nullptr;
+    }
+    for(v_buff_size i = 0; i < (v_buff_size) rowsCount; i ++) {
+      oatpp::Any any(values[i]);
+      property->set(static_cast<oatpp::BaseObject*>(rows[i].get()), oatpp::Void(any.getPtr(), property->type));
+    }
+  }
+
+  auto collection = dispatcher->createObject();
+  for(auto& row : rows) {
+    if(anyItems) {
+      auto anyHandle = std::make_shared<oatpp::data::mapping::type::AnyHandle>(row.getPtr(), row.getValueType());
+      AllocationCounter::record(AllocationCounter::ANY_HANDLES, sizeof(oatpp::data::mapping::type::AnyHandle));
+      dispatcher->addItem(collection, oatpp::Void(anyHandle, itemType));
+    } else {
+      dispatcher->addItem(collection, row);
+    }
+  }
+
+  return collection;
+
+}
+
+oatpp::Void Deserializer::deserializeMap(Deserializer* deserializer, oatpp::parser::Caret& caret, const Type* const type) {
+
+  if(caret.isAtChar(Utils::TYPE_NULL)){
+    caret.inc();
+    return oatpp::Void(type);
+  }
+
+  ContainerHeader header;
+  if(readContainerBegin(caret, Utils::CONTROL_MAP_BEGIN, Utils::CONTROL_MAP_SIZED, header)) {
+
+    auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::Map::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+    auto map = dispatcher->createObject();
+
+    auto keyType = dispatcher->getKeyType();
+    if(keyType->classId != oatpp::String::Class::CLASS_ID){
+      throw std::runtime_error("[oatpp::bob::Deserializer::deserializeMap()]: Invalid json map key. Key should be String");
+    }
+    auto valueType = dispatcher->getValueType();
+    v_int64 itemsCount = 0;
+
+    while (!caret.isAtChar(Utils::CONTROL_SECTION_END) && caret.canContinue()) {
+
+      auto key = readKey(caret);
+      if(caret.hasError()){
+        return nullptr;
+      }
+
+      auto item = deserializer->deserialize(caret, valueType);
+      if(caret.hasError()){
+        return nullptr;
+      }
+      dispatcher->addItem(map, key, item);
+      itemsCount ++;
+
+    }
+
+    if(!caret.canContinueAtChar(Utils::CONTROL_SECTION_END, 1)){
+      if(!caret.hasError()){
+        caret.setError("[oatpp::bob::Deserializer::deserializeMap()]: Error. ')' - expected", ERROR_CODE_OBJECT_SCOPE_CLOSE);
+      }
+      return nullptr;
+    }
+
+    if(!readContainerEnd(caret, header, itemsCount)) {
+      return nullptr;
+    }
+
+    return map;
+
+  } else if(!caret.hasError()) {
+    caret.setError("[oatpp::bob::Deserializer::deserializeMap()]: Error. '{' - expected", ERROR_CODE_OBJECT_SCOPE_OPEN);
+  }
+
+  return nullptr;
+
+}
+
+void Deserializer::readObjectField(Deserializer* deserializer, oatpp::parser::Caret& caret, const oatpp::Void& object,
+                                   oatpp::BaseObject::Property* field,
+                                   std::vector<std::pair<oatpp::BaseObject::Property*, v_buff_size>>& polymorphs)
+{
+  if(field->info.typeSelector && field->type == oatpp::Any::Class::getType()) {
+    polymorphs.emplace_back(field, caret.getPosition()); // store polymorphs for later processing.
+    skipValue(caret);
+  } else {
+    field->set(static_cast<oatpp::BaseObject *>(object.get()), deserializer->deserialize(caret, field->type));
+  }
+}
+
+void Deserializer::readPolymorphs(Deserializer* deserializer, oatpp::parser::Caret& caret, const oatpp::Void& object,
+                                  const std::vector<std::pair<oatpp::BaseObject::Property*, v_buff_size>>& polymorphs)
+{
+  for(auto& p : polymorphs) {
+    /* parse in place - the value may contain references to the preceding data */
+    oatpp::parser::Caret polyCaret(caret.getData(), caret.getDataSize());
+    polyCaret.setPosition(p.second);
+    auto selectedType = p.first->info.typeSelector->selectType(static_cast<oatpp::BaseObject *>(object.get()));
+    auto value = deserializer->deserialize(polyCaret, selectedType);
+    oatpp::Any any(value);
+    p.first->set(static_cast<oatpp::BaseObject *>(object.get()), oatpp::Void(any.getPtr(), p.first->type));
+  }
+}
+
+oatpp::Void Deserializer::deserializeObjectWithIds(Deserializer* deserializer, oatpp::parser::Caret& caret, const Type* const type) {
+
+  auto fieldIds = deserializer->m_config->fieldIds;
+  auto fields = deserializer->m_fieldsById.get(type, [&fieldIds](const Type* t) {
+    auto result = std::make_shared<std::vector<oatpp::BaseObject::Property*>>();
+    const FieldIds::Ids* ids = fieldIds ? fieldIds->get(t) : nullptr;
+    if(ids) {
+      auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::AbstractObject::PolymorphicDispatcher*>(t->polymorphicDispatcher);
+      for(auto const& property : dispatcher->getProperties()->getList()) {
+        v_uint32 id = ids->at(property->name);
+        if(result->size() <= id) {
+          result->resize(id + 1, nullptr);
+        }
+        result->at(id) = property;
+      }
+    }
+    return result;
+  });
+
+  if(fields->empty()) {
+    caret.setError("[oatpp::bob::Deserializer::deserializeObjectWithIds()]: Error. No field ids for the type.");
+    return nullptr;
+  }
+
+  caret.inc(); // '#'
+
+  auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::AbstractObject::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+  auto object = dispatcher->createObject();
+
+  std::vector<std::pair<oatpp::BaseObject::Property*, v_buff_size>> polymorphs;
+
+  while(!caret.isAtChar(Utils::CONTROL_SECTION_END) && caret.canContinue()) {
+
+    const v_uint64 id = Utils::readVarUInt(caret);
+    if(caret.hasError()) {
+      return nullptr;
+    }
+
+    oatpp::BaseObject::Property* field = id < fields->size() ? (*fields)[id] : nullptr;
+    if(field) {
+      readObjectField(deserializer, caret, object, field, polymorphs);
+    } else if (deserializer->getConfig()->allowUnknownFields) {
+      deserializer->skipUnknownField(caret);
+    } else {
+      caret.setError("[oatpp::bob::Deserializer::deserializeObjectWithIds()]: Error. Unknown field", ERROR_CODE_OBJECT_SCOPE_UNKNOWN_FIELD);
+      return nullptr;
+    }
+    if(caret.hasError()) {
+      return nullptr;
+    }
+
+  }
+
+  if(!caret.canContinueAtChar(Utils::CONTROL_SECTION_END, 1)){
+    if(!caret.hasError()){
+      caret.setError("[oatpp::bob::Deserializer::deserializeObjectWithIds()]: Error. ')' - expected", ERROR_CODE_OBJECT_SCOPE_CLOSE);
+    }
+    return nullptr;
+  }
+
+  readPolymorphs(deserializer, caret, object, polymorphs);
+  return object;
+
+}
+
+oatpp::Void Deserializer::deserializePositionalObject(Deserializer* deserializer, oatpp::parser::Caret& caret, const Type* const type) {
+
+  caret.inc(); // 'P'
+
+  const v_uint32 fingerprint = (v_uint32) Utils::readInt32(caret, Utils::BO_TYPE::NETWORK);
+  const v_uint64 keysCount = Utils::readVarUInt(caret);
+  if(caret.hasError()) {
+    return nullptr;
+  }
+
+  if(keysCount > (v_uint64) (caret.getDataSize() - caret.getPosition())) {
+    caret.setError("[oatpp::bob::Deserializer::deserializePositionalObject()]: Error. Invalid keys count.");
+    return nullptr;
+  }
+
+  std::vector<oatpp::String> keys;
+  keys.reserve(keysCount);
+  for(v_uint64 i = 0; i < keysCount; i ++) {
+    keys.push_back(Utils::readCString(caret));
+    if(caret.hasError()) {
+      return nullptr;
+    }
+  }
+
+  Session* session = CURRENT_SESSION;
+  if(session && session->data != caret.getData()) {
+    session = nullptr;
+  }
+  if(session && keysCount > 0) {
+    session->schemas[fingerprint] = keys;
+  }
+
+  auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::AbstractObject::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+  auto object = dispatcher->createObject();
+
+  const v_uint32 expected = *deserializer->m_objectFingerprints.get(type, [](const Type* t) {
+    return std::make_shared<v_uint32>(Utils::computeObjectFingerprint(t));
+  });
+
+  std::vector<std::pair<oatpp::BaseObject::Property*, v_buff_size>> polymorphs;
+
+  if(fingerprint == expected) {
+
+    /* same schema - values follow in the property order */
+    for(auto const& property : dispatcher->getProperties()->getList()) {
+      if(caret.isAtChar(Utils::CONTROL_SECTION_END) || !caret.canContinue()) {
+        caret.setError("[oatpp::bob::Deserializer::deserializePositionalObject()]: Error. Invalid number of fields.");
+        return nullptr;
+      }
+      readObjectField(deserializer, caret, object, property, polymorphs);
+      if(caret.hasError()) {
+        return nullptr;
+      }
+    }
+
+  } else {
+
+    /* different schema - match values to properties by the keys written with the schema */
+    const std::vector<oatpp::String>* schema = keysCount > 0 ? &keys : nullptr;
+    if(schema == nullptr && session) {
+      auto it = session->schemas.find(fingerprint);
+      if(it != session->schemas.end()) {
+        schema = &it->second;
+      }
+    }
+    if(schema == nullptr) {
+      caret.setError("[oatpp::bob::Deserializer::deserializePositionalObject()]: Error. Schema mismatch and no keys to fall back to.");
+      return nullptr;
+    }
+
+    const auto& fieldsMap = dispatcher->getProperties()->getMap();
+    for(auto const& key : *schema) {
+
+      if(caret.isAtChar(Utils::CONTROL_SECTION_END) || !caret.canContinue()) {
+        caret.setError("[oatpp::bob::Deserializer::deserializePositionalObject()]: Error. Invalid number of fields.");
+        return nullptr;
+      }
+
+      auto fieldIterator = fieldsMap.find(key);
+      if(fieldIterator != fieldsMap.end()) {
+        readObjectField(deserializer, caret, object, fieldIterator->second, polymorphs);
+      } else if (deserializer->getConfig()->allowUnknownFields) {
+        deserializer->skipUnknownField(caret);
+      } else {
+        caret.setError("[oatpp::bob::Deserializer::deserializePositionalObject()]: Error. Unknown field", ERROR_CODE_OBJECT_SCOPE_UNKNOWN_FIELD);
+        return nullptr;
+      }
+      if(caret.hasError()) {
+        return nullptr;
+      }
+
+    }
+
+  }
+
+  if(!caret.canContinueAtChar(Utils::CONTROL_SECTION_END, 1)){
+    if(!caret.hasError()){
+      caret.setError("[oatpp::bob::Deserializer::deserializePositionalObject()]: Error. ')' - expected", ERROR_CODE_OBJECT_SCOPE_CLOSE);
+    }
+    return nullptr;
+  }
+
+  readPolymorphs(deserializer, caret, object, polymorphs);
+  return object;
+
+}
+
+oatpp::Void Deserializer::deserializeObject(Deserializer* deserializer, oatpp::parser::Caret& caret, const Type* const type) {
+
+  if(caret.isAtChar(Utils::TYPE_NULL)){
+    caret.inc();
+    return oatpp::Void(type);
+  }
+
+  if(caret.isAtChar(Utils::CONTROL_OBJECT_POSITIONAL)) {
+    return deserializePositionalObject(deserializer, caret, type);
+  }
+
+  if(caret.isAtChar(Utils::CONTROL_OBJECT_IDS)) {
+    return deserializeObjectWithIds(deserializer, caret, type);
+  }
+
+  ContainerHeader header;
+  if(readContainerBegin(caret, Utils::CONTROL_MAP_BEGIN, Utils::CONTROL_MAP_SIZED, header)) {
+
+    auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::AbstractObject::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+    auto object = dispatcher->createObject();
+    const auto& fieldsMap = dispatcher->getProperties()->getMap();
+
+    std::vector<std::pair<oatpp::BaseObject::Property*, v_buff_size>> polymorphs;
+    v_int64 itemsCount = 0;
+    while (!caret.isAtChar(Utils::CONTROL_SECTION_END) && caret.canContinue()) {
+
+      auto key = readKey(caret);
+      if(caret.hasError()){
+        return nullptr;
+      }
+      itemsCount ++;
+
+      auto fieldIterator = fieldsMap.find(key);
+      if(fieldIterator != fieldsMap.end()) {
+        readObjectField(deserializer, caret, object, fieldIterator->second, polymorphs);
+      } else if (deserializer->getConfig()->allowUnknownFields) {
+        deserializer->skipUnknownField(caret);
+      } else {
+        caret.setError("[oatpp::bob::Deserializer::readObject()]: Error. Unknown field", ERROR_CODE_OBJECT_SCOPE_UNKNOWN_FIELD);
+        return nullptr;
+      }
+
+    }
+
+    if(!caret.canContinueAtChar(Utils::CONTROL_SECTION_END, 1)){
+      if(!caret.hasError()){
+        caret.setError("[oatpp::bob::Deserializer::readObject()]: Error. ')' - expected", ERROR_CODE_OBJECT_SCOPE_CLOSE);
+      }
+      return nullptr;
+    }
+
+    if(!readContainerEnd(caret, header, itemsCount)) {
+      return nullptr;
+    }
+
+    readPolymorphs(deserializer, caret, object, polymorphs);
+    return object;
+
+  } else if(!caret.hasError()) {
+    caret.setError("[oatpp::bob::Deserializer::deserializeObject()]: Error. '{' - expected", ERROR_CODE_OBJECT_SCOPE_OPEN);
+  }
+
+  return nullptr;
+
+}
+
+oatpp::Void Deserializer::getEnumInterpretation(const Type* enumType, v_uint32 ordinal) {
+
+  auto interpretations = m_enumInterpretations.get(enumType, [](const Type* type) {
+    auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::AbstractEnum::PolymorphicDispatcher*>(
+      type->polymorphicDispatcher
+    );
+    auto result = std::make_shared<std::vector<oatpp::Void>>();
+    for(const auto& any : dispatcher->getInterpretedEnum()) {
+      auto anyHandle = static_cast<oatpp::data::mapping::type::AnyHandle*>(any.get());
+      result->emplace_back(anyHandle->ptr, anyHandle->type);
+    }
+    return result;
+  });
+
+  if(ordinal < interpretations->size()) {
+    return (*interpretations)[ordinal];
+  }
+  return nullptr;
+
+}
+
+void Deserializer::skipUnknownField(oatpp::parser::Caret& caret) {
+  if(m_statistics) {
+    const v_buff_size start = caret.getPosition();
+    skipValue(caret);
+    m_statistics->recordSkipped(caret.getPosition() - start);
+  } else {
+    skipValue(caret);
+  }
+}
+
+oatpp::Void Deserializer::deserialize(oatpp::parser::Caret& caret, const Type* const type) {
+  if(m_statistics) {
+    return deserializeMeasured(caret, type);
+  }
+  return deserializeValue(caret, type);
+}
+
+oatpp::Void Deserializer::deserializeMeasured(oatpp::parser::Caret& caret, const Type* const type) {
+
+  const v_buff_size start = caret.getPosition();
+
+  oatpp::Void result;
+  v_int64 nanos = 0;
+  if(m_statistics->isMeasuringTime()) {
+    auto begin = std::chrono::steady_clock::now();
+    result = deserializeValue(caret, type);
+    nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+  } else {
+    result = deserializeValue(caret, type);
+  }
+
+  if(!caret.hasError()) {
+    m_statistics->record(Statistics::DESERIALIZE, type, caret.getPosition() - start, nanos);
+  }
+
+  return result;
+
+}
+
+oatpp::Void Deserializer::deserializeValue(oatpp::parser::Caret& caret, const Type* const type) {
+  auto id = type->classId.id;
+  auto& method = m_methods[id];
+  if(method) {
+    auto result = (*method)(this, caret, type);
+    /* deserializeString() records only new strings - not the ones resolved by '@' references */
+    if(method != &Deserializer::deserializeString) {
+      AllocationCounter::recordValue(result);
+    }
+    return result;
+  } else {
+
+    auto* interpretation = type->findInterpretation(m_config->enabledInterpretations);
+    if(interpretation) {
+      auto result = interpretation->fromInterpretation(deserialize(caret, interpretation->getInterpretationType()));
+      AllocationCounter::recordValue(result);
+      return result;
+    }
 
     throw std::runtime_error("[oatpp::bob::Deserializer::deserialize()]: "
                              "Error. No deserialize method for type '" + std::string(type->classId.name) + "'");
   }
 }
 
+Deserializer::SessionScope::SessionScope(const char* data)
+  : m_previous(CURRENT_SESSION)
+{
+  m_session.data = data;
+  CURRENT_SESSION = &m_session;
+}
+
+Deserializer::SessionScope::~SessionScope() {
+  CURRENT_SESSION = m_previous;
+}
+
+oatpp::Void Deserializer::deserializeDocument(oatpp::parser::Caret& caret, const Type* const type) {
+  SessionScope scope(caret.getData());
+  return deserialize(caret, type);
+}
+
+std::vector<oatpp::Void> Deserializer::deserializeMany(oatpp::parser::Caret& caret, const Type* const type) {
+  std::vector<oatpp::Void> result;
+  SessionScope scope(caret.getData());
+  while(caret.canContinue()) {
+    auto item = deserialize(caret, type);
+    if(caret.hasError()) {
+      break;
+    }
+    result.push_back(std::move(item));
+  }
+  return result;
+}
+
+oatpp::Void Deserializer::deserializeSlice(oatpp::parser::Caret& caret, const Type* const type, v_buff_size offset, v_buff_size count) {
+
+  if(type->classId != oatpp::data::mapping::type::__class::AbstractVector::CLASS_ID &&
+     type->classId != oatpp::data::mapping::type::__class::AbstractList::CLASS_ID &&
+     type->classId != oatpp::data::mapping::type::__class::AbstractUnorderedSet::CLASS_ID)
+  {
+    throw std::runtime_error("[oatpp::bob::Deserializer::deserializeSlice()]: Error. Type should be a collection.");
+  }
+
+  if(caret.isAtChar(Utils::TYPE_NULL)){
+    caret.inc();
+    return oatpp::Void(type);
+  }
+
+  SessionScope scope(caret.getData());
+
+  auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::Collection::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+  auto itemType = dispatcher->getItemType();
+  auto slice = dispatcher->createObject();
+
+  if(offset < 0) offset = 0;
+  if(count < 0) count = 0;
+  if(count > std::numeric_limits<v_buff_size>::max() - offset) count = std::numeric_limits<v_buff_size>::max() - offset;
+
+  if(caret.isAtChar(Utils::CONTROL_COLUMNS_BEGIN)) {
+    /* columns have no per-row positions - decode all rows */
+    auto collection = deserializeColumns(this, caret, type);
+    if(caret.hasError()) {
+      return nullptr;
+    }
+    auto iterator = dispatcher->beginIteration(collection);
+    for(v_buff_size i = 0; !iterator->finished() && i < offset + count; i ++) {
+      if(i >= offset) {
+        dispatcher->addItem(slice, iterator->get());
+      }
+      iterator->next();
+    }
+    return slice;
+  }
+
+  ContainerHeader header;
+  if(!readContainerBegin(caret, Utils::CONTROL_ARRAY_BEGIN, Utils::CONTROL_ARRAY_SIZED, header)) {
+    if(!caret.hasError()) {
+      caret.setError("[oatpp::bob::Deserializer::deserializeSlice()]: Error. '[' - expected", ERROR_CODE_ARRAY_SCOPE_OPEN);
+    }
+    return nullptr;
+  }
+
+  v_buff_size index = 0;
+
+  if(header.stride > 0) {
+
+    /* jump to the nearest indexed element before the offset */
+
+    if(offset >= header.count) {
+      caret.setPosition(header.end);
+      return slice;
+    }
+
+    const v_buff_size entriesCount = (header.count + header.stride - 1) / header.stride;
+    const v_buff_size tableStart = header.end - entriesCount * 4;
+    const v_buff_size entry = offset / header.stride;
+    if(tableStart < header.valuesStart) {
+      caret.setError("[oatpp::bob::Deserializer::deserializeSlice()]: Error. Invalid array index.");
+      return nullptr;
+    }
+
+    oatpp::parser::Caret tableCaret(caret.getData(), header.end);
+    tableCaret.setPosition(tableStart + entry * 4);
+    v_buff_size position = header.valuesStart + (v_uint32) Utils::readInt32(tableCaret, Utils::BO_TYPE::NETWORK);
+    if(position >= tableStart) {
+      caret.setError("[oatpp::bob::Deserializer::deserializeSlice()]: Error. Invalid array index.");
+      return nullptr;
+    }
+
+    caret.setPosition(position);
+    index = entry * header.stride;
+
+  }
+
+  while(index < offset + count && !caret.isAtChar(Utils::CONTROL_SECTION_END) && caret.canContinue()) {
+
+    if(index < offset) {
+      skipValue(caret);
+    } else {
+      auto item = deserialize(caret, itemType);
+      if(caret.hasError()) {
+        return nullptr;
+      }
+      dispatcher->addItem(slice, item);
+    }
+
+    if(caret.hasError()) {
+      return nullptr;
+    }
+    index ++;
+
+  }
+
+  /* position the caret after the array */
+
+  if(header.end >= 0) {
+    caret.setPosition(header.end);
+    return slice;
+  }
+
+  while(!caret.isAtChar(Utils::CONTROL_SECTION_END) && caret.canContinue()) {
+    skipValue(caret);
+    if(caret.hasError()) {
+      return nullptr;
+    }
+  }
+
+  if(!caret.canContinueAtChar(Utils::CONTROL_SECTION_END, 1)){
+    caret.setError("[oatpp::bob::Deserializer::deserializeSlice()]: Error. ')' - expected", ERROR_CODE_ARRAY_SCOPE_CLOSE);
+    return nullptr;
+  }
+
+  return slice;
+
+}
+
 const std::shared_ptr<Deserializer::Config>& Deserializer::getConfig() {
   return m_config;
 }
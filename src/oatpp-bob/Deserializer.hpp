@@ -25,10 +25,16 @@
 #ifndef OATPP_BOB_DESERIALIZER_HPP
 #define OATPP_BOB_DESERIALIZER_HPP
 
+#include "./AllocationCounter.hpp"
+#include "./FieldIds.hpp"
+#include "./Statistics.hpp"
+#include "./TypeCache.hpp"
 #include "./Utils.hpp"
 #include "oatpp/core/parser/Caret.hpp"
 #include "oatpp/core/Types.hpp"
 
+#include <functional>
+#include <unordered_map>
 #include <vector>
 
 namespace oatpp { namespace bob {
@@ -115,6 +121,24 @@ public:
      */
     std::vector<std::string> enabledInterpretations = {};
 
+    /**
+     * Read integer values of enums as ordinals (index of the entry in the enum declaration).
+     * Enums with non-integer interpretation (ex.: `Enum<T>::AsString`) always accept ordinals.
+     */
+    bool enumsAsOrdinals = false;
+
+    /**
+     * Numeric ids of DTO properties. See &id:oatpp::bob::FieldIds;.
+     * Needed to read objects written with &id:oatpp::bob::Serializer::Config::fieldIds;.
+     */
+    std::shared_ptr<FieldIds> fieldIds;
+
+    /**
+     * Count deserialized values by type and skipped unknown fields. See &id:oatpp::bob::Statistics;.
+     * `nullptr` - no statistics.
+     */
+    std::shared_ptr<Statistics> statistics;
+
     /**
      * Pointer to anything extra.
      */
@@ -125,13 +149,70 @@ public:
 public:
   typedef oatpp::Void (*DeserializerMethod)(Deserializer*, oatpp::parser::Caret&, const Type* const);
 private:
+
+  /*
+   * Per-document state of the deserializer.
+   * Set for the current thread by deserializeDocument(). Used only when the caret is over `data`.
+   */
+  struct Session {
+    const char* data;
+    std::unordered_map<v_buff_size, oatpp::String> strings; // resolved string references by target position
+    std::unordered_map<v_uint32, std::vector<oatpp::String>> schemas; // keys of positional objects by schema fingerprint
+  };
+
+  static thread_local Session* CURRENT_SESSION;
+
+  class SessionScope {
+  private:
+    Session m_session;
+    Session* m_previous;
+  public:
+    SessionScope(const char* data);
+    ~SessionScope();
+  };
+
+  /*
+   * Header of a map or an array. `count` and `end` are `-1` for containers without size.
+   */
+  struct ContainerHeader {
+    v_int64 count;
+    v_buff_size end;
+    v_buff_size stride; // stride of the offset index - indexed arrays only.
+    v_buff_size valuesStart;
+  };
+
+private:
+  static oatpp::String readKey(oatpp::parser::Caret& caret);
+  static bool readContainerBegin(oatpp::parser::Caret& caret, v_char8 tag, v_char8 sizedTag, ContainerHeader& header);
+  static bool readContainerEnd(oatpp::parser::Caret& caret, const ContainerHeader& header, v_int64 count);
+  static oatpp::String readStringReference(oatpp::parser::Caret& caret);
   static void skipKey(oatpp::parser::Caret& caret);
   static void skipString(oatpp::parser::Caret& caret);
   static void skipMap(oatpp::parser::Caret& caret);
   static void skipArray(oatpp::parser::Caret& caret);
-  static void skipValue(oatpp::parser::Caret& caret);
+  static void skipColumns(oatpp::parser::Caret& caret);
+  static void skipSizedContainer(oatpp::parser::Caret& caret);
+  static void skipPositionalObject(oatpp::parser::Caret& caret);
+  static void skipObjectWithIds(oatpp::parser::Caret& caret);
 private:
   static const Type* guessType(oatpp::parser::Caret& caret);
+  static bool isIntegralType(const Type* type);
+  static bool isAtInteger(oatpp::parser::Caret& caret);
+  static void readObjectField(Deserializer* deserializer, oatpp::parser::Caret& caret, const oatpp::Void& object,
+                              oatpp::BaseObject::Property* field,
+                              std::vector<std::pair<oatpp::BaseObject::Property*, v_buff_size>>& polymorphs);
+  static void readPolymorphs(Deserializer* deserializer, oatpp::parser::Caret& caret, const oatpp::Void& object,
+                             const std::vector<std::pair<oatpp::BaseObject::Property*, v_buff_size>>& polymorphs);
+  void skipUnknownField(oatpp::parser::Caret& caret);
+  oatpp::Void deserializeValue(oatpp::parser::Caret& caret, const Type* const type);
+  oatpp::Void deserializeMeasured(oatpp::parser::Caret& caret, const Type* const type);
+  static oatpp::Void deserializeObjectWithIds(Deserializer* deserializer, oatpp::parser::Caret& caret, const Type* const type);
+  static oatpp::Void deserializePositionalObject(Deserializer* deserializer, oatpp::parser::Caret& caret, const Type* const type);
+  static std::vector<oatpp::Void> decodeColumn(Deserializer* deserializer,
+                                               oatpp::parser::Caret& column,
+                                               v_char8 columnType,
+                                               v_buff_size rowsCount,
+                                               const std::function<const Type*(v_buff_size)>& getType);
 public:
 
   static oatpp::Void deserializeInt8(Deserializer* deserializer, oatpp::parser::Caret& caret, const Type* const type);
@@ -157,9 +238,18 @@ public:
 
   static oatpp::Void deserializeObject(Deserializer* deserializer, oatpp::parser::Caret& caret, const Type* const type);
 
+  static oatpp::Void deserializeColumns(Deserializer* deserializer, oatpp::parser::Caret& caret, const Type* const type);
+
+private:
+  oatpp::Void getEnumInterpretation(const Type* enumType, v_uint32 ordinal);
 private:
   std::shared_ptr<Config> m_config;
+  Statistics* m_statistics;
   std::vector<DeserializerMethod> m_methods;
+private:
+  TypeCache<std::vector<oatpp::Void>> m_enumInterpretations;
+  TypeCache<v_uint32> m_objectFingerprints;
+  TypeCache<std::vector<oatpp::BaseObject::Property*>> m_fieldsById;
 public:
 
   /**
@@ -183,6 +273,46 @@ public:
    */
   oatpp::Void deserialize(oatpp::parser::Caret& caret, const Type* const type);
 
+  /**
+   * Deserialize the whole document. <br>
+   * Same as &l:Deserializer::deserialize ();, but references to the same string (see &id:oatpp::bob::Serializer::Config::stringDedupTableSize;)
+   * are resolved to the same `oatpp::String` instance.
+   * @param caret - &id:oatpp::parser::Caret;.
+   * @param type - &id:oatpp::data::mapping::type::Type;
+   * @return - `oatpp::Void` over deserialized object.
+   */
+  oatpp::Void deserializeDocument(oatpp::parser::Caret& caret, const Type* const type);
+
+  /**
+   * Deserialize concatenated documents until the end of the caret. <br>
+   * String references are resolved the same way as in &l:Deserializer::deserializeDocument (); - with one table for the whole batch.
+   * See &id:oatpp::bob::Serializer::serializeManyToStream;.
+   * @param caret - &id:oatpp::parser::Caret;.
+   * @param type - &id:oatpp::data::mapping::type::Type; of each document.
+   * @return - deserialized objects. On error the caret has the error set and the result has the objects read before the error.
+   */
+  std::vector<oatpp::Void> deserializeMany(oatpp::parser::Caret& caret, const Type* const type);
+
+  /**
+   * Deserialize a range of elements of the array. <br>
+   * For arrays written with the offset index (see &id:oatpp::bob::Serializer::Config::arrayIndexThreshold;)
+   * the elements before the range are not parsed. Elements of other arrays are skipped one by one. <br>
+   * The caret is positioned after the array. String references are resolved the same way as in &l:Deserializer::deserializeDocument ();.
+   * @param caret - &id:oatpp::parser::Caret;.
+   * @param type - collection type - ex.: `oatpp::Vector<T>::Class::getType()`.
+   * @param offset - index of the first element.
+   * @param count - max number of elements to read.
+   * @return - `oatpp::Void` over the collection with elements of the range.
+   */
+  oatpp::Void deserializeSlice(oatpp::parser::Caret& caret, const Type* const type, v_buff_size offset, v_buff_size count);
+
+  /**
+   * Skip the value at the caret without reading it. <br>
+   * The caret is positioned after the value, or has the error set if the value is malformed.
+   * @param caret - &id:oatpp::parser::Caret;.
+   */
+  static void skipValue(oatpp::parser::Caret& caret);
+
   /**
    * Get deserializer config.
    * @return
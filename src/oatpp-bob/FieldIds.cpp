@@ -0,0 +1,72 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "FieldIds.hpp"
+
+#include <unordered_set>
+
+namespace oatpp { namespace bob {
+
+void FieldIds::set(const oatpp::data::mapping::type::Type* objectType, const Ids& ids) {
+
+  if(objectType->classId != oatpp::data::mapping::type::__class::AbstractObject::CLASS_ID) {
+    throw std::runtime_error("[oatpp::bob::FieldIds::set()]: Error. Type is not an object.");
+  }
+
+  auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::AbstractObject::PolymorphicDispatcher*>(
+    objectType->polymorphicDispatcher
+  );
+  const auto& properties = dispatcher->getProperties()->getList();
+
+  if(ids.size() != properties.size()) {
+    throw std::runtime_error("[oatpp::bob::FieldIds::set()]: Error. Each property must have an id.");
+  }
+
+  std::unordered_set<v_uint32> used;
+  for(auto const& property : properties) {
+    auto it = ids.find(property->name);
+    if(it == ids.end()) {
+      throw std::runtime_error("[oatpp::bob::FieldIds::set()]: Error. Each property must have an id.");
+    }
+    if(it->second < 1 || it->second > MAX_FIELD_ID) {
+      throw std::runtime_error("[oatpp::bob::FieldIds::set()]: Error. Id is out of range.");
+    }
+    if(!used.insert(it->second).second) {
+      throw std::runtime_error("[oatpp::bob::FieldIds::set()]: Error. Duplicate id.");
+    }
+  }
+
+  m_types[objectType] = ids;
+
+}
+
+const FieldIds::Ids* FieldIds::get(const oatpp::data::mapping::type::Type* objectType) const {
+  auto it = m_types.find(objectType);
+  if(it == m_types.end()) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+}}
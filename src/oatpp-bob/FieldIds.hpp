@@ -0,0 +1,91 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_BOB_FIELDIDS_HPP
+#define OATPP_BOB_FIELDIDS_HPP
+
+#include "oatpp/core/Types.hpp"
+
+#include <string>
+#include <unordered_map>
+
+namespace oatpp { namespace bob {
+
+/**
+ * Numeric ids of DTO properties. <br>
+ * Objects of the registered types are written with varint ids instead of string keys -
+ * `'#'<varint id><value>...')'`, similar to the protobuf field numbers. <br>
+ * Set the same ids to &id:oatpp::bob::Serializer::Config::fieldIds; and &id:oatpp::bob::Deserializer::Config::fieldIds;.
+ * When the DTO changes, keep ids of the remaining properties and don't reuse ids of the removed ones -
+ * readers skip values with unknown ids (see &id:oatpp::bob::Deserializer::Config::allowUnknownFields;). <br>
+ * Register all types before the mappers are used.
+ */
+class FieldIds {
+public:
+
+  /**
+   * Max id of the property.
+   */
+  static constexpr v_uint32 MAX_FIELD_ID = 0xFFFF;
+
+  /**
+   * Property name -> property id.
+   */
+  typedef std::unordered_map<std::string, v_uint32> Ids;
+
+private:
+  std::unordered_map<const oatpp::data::mapping::type::Type*, Ids> m_types;
+public:
+
+  /**
+   * Set ids of the DTO properties. Every property of the DTO must have an id.
+   * Ids are unique within the DTO and are in range `[1, MAX_FIELD_ID]`.
+   * @param objectType - DTO type.
+   * @param ids - &l:FieldIds::Ids;.
+   * @throws - `std::runtime_error` if ids are invalid.
+   */
+  void set(const oatpp::data::mapping::type::Type* objectType, const Ids& ids);
+
+  /**
+   * Set ids of the DTO properties.
+   * @tparam Wrapper - DTO wrapper. Ex.: `oatpp::Object<MyDto>`.
+   * @param ids - &l:FieldIds::Ids;.
+   */
+  template<class Wrapper>
+  void set(const Ids& ids) {
+    set(Wrapper::Class::getType(), ids);
+  }
+
+  /**
+   * Get ids of the DTO properties.
+   * @param objectType - DTO type.
+   * @return - pointer to &l:FieldIds::Ids; or `nullptr` if the type has no ids.
+   */
+  const Ids* get(const oatpp::data::mapping::type::Type* objectType) const;
+
+};
+
+}}
+
+#endif // OATPP_BOB_FIELDIDS_HPP
@@ -0,0 +1,159 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "MappedFile.hpp"
+
+#include <stdexcept>
+
+#if defined(WIN32) || defined(_WIN32)
+  #include <fstream>
+#else
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+namespace oatpp { namespace bob {
+
+#if defined(WIN32) || defined(_WIN32)
+
+MappedFile::MappedFile(const oatpp::String& path, Access access)
+  : m_data(nullptr)
+  , m_size(0)
+{
+
+  (void) access;
+
+  std::ifstream file(path->c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+  if(!file.is_open()) {
+    throw std::runtime_error("[oatpp::bob::MappedFile::MappedFile()]: Error. Can't open file.");
+  }
+
+  m_size = (v_buff_size) file.tellg();
+  m_buffer.reset(new char[m_size > 0 ? m_size : 1]);
+  file.seekg(0, std::ios::beg);
+  if(!file.read(m_buffer.get(), m_size)) {
+    throw std::runtime_error("[oatpp::bob::MappedFile::MappedFile()]: Error. Can't read file.");
+  }
+  m_data = m_buffer.get();
+
+}
+
+MappedFile::~MappedFile() = default;
+
+void MappedFile::advise(v_buff_size offset, v_buff_size size, Access access) const {
+  (void) offset;
+  (void) size;
+  (void) access;
+}
+
+#else
+
+namespace {
+
+int toAdvice(MappedFile::Access access) {
+  switch(access) {
+    case MappedFile::Access::SEQUENTIAL: return MADV_SEQUENTIAL;
+    case MappedFile::Access::RANDOM: return MADV_RANDOM;
+    case MappedFile::Access::WILL_NEED: return MADV_WILLNEED;
+    default: return MADV_NORMAL;
+  }
+}
+
+}
+
+MappedFile::MappedFile(const oatpp::String& path, Access access)
+  : m_data(nullptr)
+  , m_size(0)
+{
+
+  int fd = ::open(path->c_str(), O_RDONLY);
+  if(fd < 0) {
+    throw std::runtime_error("[oatpp::bob::MappedFile::MappedFile()]: Error. Can't open file.");
+  }
+
+  struct stat info;
+  if(::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw std::runtime_error("[oatpp::bob::MappedFile::MappedFile()]: Error. Can't stat file.");
+  }
+
+  m_size = (v_buff_size) info.st_size;
+
+  if(m_size > 0) {
+    void* data = ::mmap(nullptr, (size_t) m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(data == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("[oatpp::bob::MappedFile::MappedFile()]: Error. Can't map file.");
+    }
+    m_data = (const char*) data;
+  }
+
+  /* the mapping stays valid after the descriptor is closed */
+  ::close(fd);
+
+  advise(0, m_size, access);
+
+}
+
+MappedFile::~MappedFile() {
+  if(m_data != nullptr) {
+    ::munmap((void*) m_data, (size_t) m_size);
+  }
+}
+
+void MappedFile::advise(v_buff_size offset, v_buff_size size, Access access) const {
+
+  if(m_data == nullptr || offset < 0 || offset >= m_size || size <= 0) {
+    return;
+  }
+
+  if(size > m_size - offset) {
+    size = m_size - offset;
+  }
+
+  /* madvise requires a page-aligned address */
+  static const v_buff_size pageSize = ::sysconf(_SC_PAGESIZE);
+  v_buff_size alignedOffset = offset - offset % pageSize;
+
+  ::madvise((void*) (m_data + alignedOffset), (size_t) (size + offset - alignedOffset), toAdvice(access));
+
+}
+
+#endif
+
+std::shared_ptr<MappedFile> MappedFile::createShared(const oatpp::String& path, Access access) {
+  return std::make_shared<MappedFile>(path, access);
+}
+
+const char* MappedFile::getData() const {
+  return m_data;
+}
+
+v_buff_size MappedFile::getSize() const {
+  return m_size;
+}
+
+}}
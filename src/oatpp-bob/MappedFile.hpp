@@ -0,0 +1,126 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_BOB_MAPPEDFILE_HPP
+#define OATPP_BOB_MAPPEDFILE_HPP
+
+#include "oatpp/core/Types.hpp"
+
+#include <memory>
+
+namespace oatpp { namespace bob {
+
+/**
+ * Read-only memory-mapped file. <br>
+ * The file is not loaded on open - pages are read by the OS on first access,
+ * so reading a part of a large file (ex.: with &id:oatpp::bob::ObjectMapper::readSliceFromFile;) touches only that part. <br>
+ * On platforms without `mmap` the file is read into memory.
+ */
+class MappedFile {
+public:
+
+  /**
+   * Expected access pattern - passed to `madvise`.
+   */
+  enum class Access : v_int32 {
+
+    /**
+     * No special treatment.
+     */
+    NORMAL = 0,
+
+    /**
+     * Pages are accessed in order - read ahead aggressively, free pages after they're read.
+     */
+    SEQUENTIAL = 1,
+
+    /**
+     * Pages are accessed in random order - don't read ahead.
+     */
+    RANDOM = 2,
+
+    /**
+     * Pages will be needed soon - start reading them in.
+     */
+    WILL_NEED = 3
+
+  };
+
+private:
+  const char* m_data;
+  v_buff_size m_size;
+#if defined(WIN32) || defined(_WIN32)
+  std::unique_ptr<char[]> m_buffer;
+#endif
+public:
+
+  /**
+   * Constructor. Maps the file.
+   * Throws `std::runtime_error` if the file can't be opened or mapped.
+   * @param path - path to the file.
+   * @param access - expected access pattern. See &l:MappedFile::Access;.
+   */
+  MappedFile(const oatpp::String& path, Access access = Access::NORMAL);
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /**
+   * Non-virtual destructor. Unmaps the file.
+   */
+  ~MappedFile();
+
+  /**
+   * Create shared MappedFile.
+   * @param path - path to the file.
+   * @param access - expected access pattern. See &l:MappedFile::Access;.
+   * @return - `std::shared_ptr` to MappedFile.
+   */
+  static std::shared_ptr<MappedFile> createShared(const oatpp::String& path, Access access = Access::NORMAL);
+
+  /**
+   * Give a hint about the access pattern of the range of the file.
+   * @param offset - offset of the range.
+   * @param size - size of the range.
+   * @param access - &l:MappedFile::Access;.
+   */
+  void advise(v_buff_size offset, v_buff_size size, Access access) const;
+
+  /**
+   * Get pointer to the mapped data.
+   * @return
+   */
+  const char* getData() const;
+
+  /**
+   * Get size of the file.
+   * @return
+   */
+  v_buff_size getSize() const;
+
+};
+
+}}
+
+#endif /* OATPP_BOB_MAPPEDFILE_HPP */
@@ -24,13 +24,49 @@
 
 #include "ObjectMapper.hpp"
 
+#include "./Stream.hpp"
+
+#include "oatpp/core/data/stream/BufferStream.hpp"
+
+#include <stdexcept>
+#include <unordered_map>
+
 namespace oatpp { namespace bob {
 
+namespace {
+
+/*
+ * Thread-local output buffer of the pooled mode - see ObjectMapper::setBufferPooling().
+ */
+struct PooledBuffer {
+
+  static constexpr v_buff_size TRIM_CAPACITY = 1024 * 1024; // larger buffers are released when much bigger than the expected output
+
+  oatpp::data::stream::BufferOutputStream stream;
+  std::unordered_map<const oatpp::data::mapping::type::Type*, v_buff_size> sizeHints; // recent output size per type
+  bool inUse = false;
+
+};
+
+thread_local PooledBuffer POOLED_BUFFER;
+
+/* grow the hint at once, let it decay slowly */
+void updateSizeHint(v_buff_size& hint, v_buff_size size) {
+  hint = size > hint ? size : hint - (hint - size) / 8;
+}
+
+}
+
+
 ObjectMapper::ObjectMapper(const std::shared_ptr<Serializer::Config>& serializerConfig,
                            const std::shared_ptr<Deserializer::Config>& deserializerConfig)
   : oatpp::data::mapping::ObjectMapper(getMapperInfo())
   , m_serializer(std::make_shared<Serializer>(serializerConfig))
   , m_deserializer(std::make_shared<Deserializer>(deserializerConfig))
+  , m_compressionBlockSize(64 * 1024)
+  , m_decompression(false)
+  , m_maxFrameSize(Codec::DEFAULT_MAX_FRAME_SIZE)
+  , m_bufferPooling(false)
 {}
 
 ObjectMapper::ObjectMapper(const std::shared_ptr<Serializer>& serializer,
@@ -38,6 +74,10 @@ ObjectMapper::ObjectMapper(const std::shared_ptr<Serializer>& serializer,
   : oatpp::data::mapping::ObjectMapper(getMapperInfo())
   , m_serializer(serializer)
   , m_deserializer(deserializer)
+  , m_compressionBlockSize(64 * 1024)
+  , m_decompression(false)
+  , m_maxFrameSize(Codec::DEFAULT_MAX_FRAME_SIZE)
+  , m_bufferPooling(false)
 {}
 
 std::shared_ptr<ObjectMapper> ObjectMapper::createShared(const std::shared_ptr<Serializer::Config>& serializerConfig,
@@ -50,12 +90,242 @@ std::shared_ptr<ObjectMapper> ObjectMapper::createShared(const std::shared_ptr<S
   return std::make_shared<ObjectMapper>(serializer, deserializer);
 }
 
+void ObjectMapper::setCompression(const std::shared_ptr<Codec>& codec, v_buff_size blockSize) {
+  if(blockSize <= 0 || blockSize > Codec::MAX_BLOCK_SIZE) {
+    throw std::invalid_argument("[oatpp::bob::ObjectMapper::setCompression()]: Error. "
+                                "blockSize must be in range (0, Codec::MAX_BLOCK_SIZE].");
+  }
+  m_codec = codec;
+  m_compressionBlockSize = blockSize;
+  if(codec) {
+    m_decompression = true;
+  }
+}
+
+std::shared_ptr<Codec> ObjectMapper::getCompression() {
+  return m_codec;
+}
+
+void ObjectMapper::setDecompression(bool enabled, v_buff_size maxFrameSize) {
+  m_decompression = enabled;
+  m_maxFrameSize = maxFrameSize;
+}
+
+bool ObjectMapper::isDecompression() {
+  return m_decompression;
+}
+
+void ObjectMapper::setBufferPooling(bool enabled) {
+  m_bufferPooling = enabled;
+}
+
+bool ObjectMapper::isBufferPooling() {
+  return m_bufferPooling;
+}
+
 void ObjectMapper::write(oatpp::data::stream::ConsistentOutputStream* stream, const oatpp::Void& variant) const {
-  m_serializer->serializeToStream(stream, variant);
+
+  /*
+   * oatpp::data::mapping::ObjectMapper::writeToString() (used by ResponseFactory and ApiController) is not virtual -
+   * it writes to a new BufferOutputStream. Reserve the output upfront so that it is written in a single allocation.
+   */
+  auto buffer = dynamic_cast<oatpp::data::stream::BufferOutputStream*>(stream);
+  if(buffer && !m_codec) {
+    if(m_bufferPooling) {
+      auto& hint = POOLED_BUFFER.sizeHints[variant.getValueType()];
+      const v_buff_size start = buffer->getCurrentPosition();
+      buffer->reserveBytesUpfront(hint);
+      m_serializer->serializeToStream(buffer, variant);
+      updateSizeHint(hint, buffer->getCurrentPosition() - start);
+    } else {
+      buffer->reserveBytesUpfront(m_serializer->computeSize(variant));
+      m_serializer->serializeToStream(buffer, variant);
+    }
+    return;
+  }
+
+  writeToStream(stream, variant);
+
+}
+
+void ObjectMapper::writeToStream(oatpp::data::stream::ConsistentOutputStream* stream, const oatpp::Void& variant) const {
+  if(m_codec) {
+    CompressingOutputStream compressingStream(stream, m_codec, m_compressionBlockSize);
+    m_serializer->serializeToStream(&compressingStream, variant);
+    compressingStream.finish();
+  } else {
+    m_serializer->serializeToStream(stream, variant);
+  }
+}
+
+oatpp::String ObjectMapper::writeToPooledBuffer(const oatpp::Void& variant) const {
+
+  PooledBuffer& buffer = POOLED_BUFFER;
+  auto& hint = buffer.sizeHints[variant.getValueType()];
+
+  buffer.inUse = true;
+  buffer.stream.setCurrentPosition(0);
+  buffer.stream.reserveBytesUpfront(hint);
+
+  try {
+    writeToStream(&buffer.stream, variant);
+  } catch (...) {
+    buffer.inUse = false;
+    throw;
+  }
+
+  buffer.inUse = false;
+
+  const v_buff_size size = buffer.stream.getCurrentPosition();
+  oatpp::String result((const char*) buffer.stream.getData(), size);
+
+  updateSizeHint(hint, size);
+
+  if(buffer.stream.getCapacity() > PooledBuffer::TRIM_CAPACITY && buffer.stream.getCapacity() > hint * 4) {
+    buffer.stream.reset(hint);
+  }
+
+  return result;
+
+}
+
+oatpp::String ObjectMapper::writeToString(const oatpp::Void& variant) const {
+  if(m_bufferPooling && !POOLED_BUFFER.inUse) { // nested calls fall back to the regular buffers
+    return writeToPooledBuffer(variant);
+  }
+  if(m_codec) {
+    return writeToBuffer(variant);
+  }
+  oatpp::String result(m_serializer->computeSize(variant));
+  FixedBufferOutputStream stream(const_cast<char*>(result->data()), result->size());
+  try {
+    m_serializer->serializeToStream(&stream, variant);
+  } catch (const std::runtime_error&) {
+    if(!stream.isOverflown()) {
+      throw;
+    }
+    return writeToBuffer(variant);
+  }
+  if(stream.getCurrentPosition() != (v_buff_size) result->size()) {
+    return writeToBuffer(variant);
+  }
+  return result;
+}
+
+oatpp::String ObjectMapper::writeToBuffer(const oatpp::Void& variant) const {
+  oatpp::data::stream::BufferOutputStream stream;
+  writeToStream(&stream, variant);
+  return stream.toString();
+}
+
+void ObjectMapper::writeMany(oatpp::data::stream::ConsistentOutputStream* stream, const std::vector<oatpp::Void>& items) const {
+  if(m_codec) {
+    CompressingOutputStream compressingStream(stream, m_codec, m_compressionBlockSize);
+    m_serializer->serializeManyToStream(&compressingStream, items);
+    compressingStream.finish();
+  } else {
+    m_serializer->serializeManyToStream(stream, items);
+  }
+}
+
+oatpp::String ObjectMapper::writeManyToString(const std::vector<oatpp::Void>& items) const {
+  if(m_codec) {
+    return writeManyToBuffer(items);
+  }
+  oatpp::String result(m_serializer->computeSize(items));
+  FixedBufferOutputStream stream(const_cast<char*>(result->data()), result->size());
+  try {
+    m_serializer->serializeManyToStream(&stream, items);
+  } catch (const std::runtime_error&) {
+    if(!stream.isOverflown()) {
+      throw;
+    }
+    return writeManyToBuffer(items);
+  }
+  if(stream.getCurrentPosition() != (v_buff_size) result->size()) {
+    return writeManyToBuffer(items);
+  }
+  return result;
+}
+
+oatpp::String ObjectMapper::writeManyToBuffer(const std::vector<oatpp::Void>& items) const {
+  oatpp::data::stream::BufferOutputStream stream;
+  writeMany(&stream, items);
+  return stream.toString();
+}
+
+std::shared_ptr<oatpp::data::stream::ReadCallback> ObjectMapper::createReadCallback(const oatpp::Void& variant) const {
+  return std::make_shared<SerializerReadCallback>(m_serializer, variant);
 }
 
 oatpp::Void ObjectMapper::read(oatpp::parser::Caret& caret, const oatpp::data::mapping::type::Type* const type) const {
-  return m_deserializer->deserialize(caret, type);
+
+  if(m_decompression && caret.canContinue() && (v_char8) caret.getCurrData()[0] == Codec::FRAME_BEGIN) {
+
+    auto data = Codec::readFrame(caret, m_codec, m_maxFrameSize);
+    if(caret.hasError()) {
+      return nullptr;
+    }
+
+    oatpp::parser::Caret frameCaret(data);
+    auto result = m_deserializer->deserializeDocument(frameCaret, type);
+    if(frameCaret.hasError()) {
+      caret.setError(frameCaret.getErrorMessage(), frameCaret.getErrorCode());
+      return nullptr;
+    }
+    return result;
+
+  }
+
+  return m_deserializer->deserializeDocument(caret, type);
+
+}
+
+std::vector<oatpp::Void> ObjectMapper::readMany(oatpp::parser::Caret& caret, const oatpp::data::mapping::type::Type* const type) const {
+
+  if(m_decompression && caret.canContinue() && (v_char8) caret.getCurrData()[0] == Codec::FRAME_BEGIN) {
+
+    auto data = Codec::readFrame(caret, m_codec, m_maxFrameSize);
+    if(caret.hasError()) {
+      return {};
+    }
+
+    oatpp::parser::Caret frameCaret(data);
+    auto result = m_deserializer->deserializeMany(frameCaret, type);
+    if(frameCaret.hasError()) {
+      caret.setError(frameCaret.getErrorMessage(), frameCaret.getErrorCode());
+    }
+    return result;
+
+  }
+
+  return m_deserializer->deserializeMany(caret, type);
+
+}
+
+oatpp::Void ObjectMapper::readSlice(oatpp::parser::Caret& caret, const oatpp::data::mapping::type::Type* const type,
+                                    v_buff_size offset, v_buff_size count) const
+{
+
+  if(m_decompression && caret.canContinue() && (v_char8) caret.getCurrData()[0] == Codec::FRAME_BEGIN) {
+
+    auto data = Codec::readFrame(caret, m_codec, m_maxFrameSize);
+    if(caret.hasError()) {
+      return nullptr;
+    }
+
+    oatpp::parser::Caret frameCaret(data);
+    auto result = m_deserializer->deserializeSlice(frameCaret, type, offset, count);
+    if(frameCaret.hasError()) {
+      caret.setError(frameCaret.getErrorMessage(), frameCaret.getErrorCode());
+      return nullptr;
+    }
+    return result;
+
+  }
+
+  return m_deserializer->deserializeSlice(caret, type, offset, count);
+
 }
 
 std::shared_ptr<Serializer> ObjectMapper::getSerializer() {
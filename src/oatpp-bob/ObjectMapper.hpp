@@ -27,9 +27,13 @@
 #define OATPP_BOB_OBJECTMAPPER_HPP
 
 #include "./Serializer.hpp"
+#include "./SerializerReadCallback.hpp"
 #include "./Deserializer.hpp"
+#include "./Codec.hpp"
+#include "./MappedFile.hpp"
 
 #include "oatpp/core/data/mapping/ObjectMapper.hpp"
+#include "oatpp/core/parser/ParsingError.hpp"
 
 namespace oatpp { namespace bob {
 
@@ -43,6 +47,16 @@ private:
 private:
   std::shared_ptr<Serializer> m_serializer;
   std::shared_ptr<Deserializer> m_deserializer;
+  std::shared_ptr<Codec> m_codec;
+  v_buff_size m_compressionBlockSize;
+  bool m_decompression;
+  v_buff_size m_maxFrameSize;
+  bool m_bufferPooling;
+private:
+  void writeToStream(oatpp::data::stream::ConsistentOutputStream* stream, const oatpp::Void& variant) const;
+  oatpp::String writeToPooledBuffer(const oatpp::Void& variant) const;
+  oatpp::String writeToBuffer(const oatpp::Void& variant) const;
+  oatpp::String writeManyToBuffer(const std::vector<oatpp::Void>& items) const;
 public:
 
   ObjectMapper(const std::shared_ptr<Serializer::Config>& serializerConfig,
@@ -64,10 +78,222 @@ public:
                const std::shared_ptr<Deserializer>& deserializer = std::make_shared<Deserializer>());
 
 
+  /**
+   * Enable compression of the output. <br>
+   * With compression enabled, &l:ObjectMapper::write (); writes a compressed frame - see &id:oatpp::bob::CompressingOutputStream;.
+   * Setting a codec also enables reading of compressed frames - see &l:ObjectMapper::setDecompression ();.
+   * @param codec - &id:oatpp::bob::Codec;. `nullptr` - disable compression.
+   * @param blockSize - size of the uncompressed block.
+   * Must be in range `(0, Codec::MAX_BLOCK_SIZE]`, otherwise `std::invalid_argument` is thrown.
+   */
+  void setCompression(const std::shared_ptr<Codec>& codec, v_buff_size blockSize = 64 * 1024);
+
+  /**
+   * Get compression codec.
+   * @return - &id:oatpp::bob::Codec; or `nullptr` if compression is disabled.
+   */
+  std::shared_ptr<Codec> getCompression();
+
+  /**
+   * Enable reading of compressed frames. Disabled by default - data starting with &id:oatpp::bob::Codec::FRAME_BEGIN; is rejected. <br>
+   * Frames are decompressed with the codec set by &l:ObjectMapper::setCompression (); or with the built-in codec of the frame.
+   * @param enabled
+   * @param maxFrameSize - max total size of the decompressed frame.
+   */
+  void setDecompression(bool enabled, v_buff_size maxFrameSize = Codec::DEFAULT_MAX_FRAME_SIZE);
+
+  /**
+   * Check if reading of compressed frames is enabled. See &l:ObjectMapper::setDecompression ();.
+   * @return
+   */
+  bool isDecompression();
+
+  /**
+   * Enable pooled output buffers for &l:ObjectMapper::writeToString ();. <br>
+   * In the pooled mode the object is serialized in a single pass to the thread-local buffer, which is then copied to the result string.
+   * The buffer keeps its capacity between calls and is reserved upfront from the recent output sizes of the same type.
+   * @param enabled
+   */
+  void setBufferPooling(bool enabled);
+
+  /**
+   * Check if pooled output buffers are enabled. See &l:ObjectMapper::setBufferPooling ();.
+   * @return
+   */
+  bool isBufferPooling();
+
+  /**
+   * Serialize object to the stream. <br>
+   * Writing to `oatpp::data::stream::BufferOutputStream` (ex.: `oatpp::data::mapping::ObjectMapper::writeToString()`
+   * called through the base class by `ResponseFactory` and `ApiController`) reserves the buffer upfront -
+   * by the exact size of the output, or by the recent output size of the type with buffer pooling enabled.
+   * @param stream - stream to write to.
+   * @param variant - object to serialize.
+   */
   void write(oatpp::data::stream::ConsistentOutputStream* stream, const oatpp::Void& variant) const override;
 
+  /**
+   * Serialize object to string.
+   * The exact size of the output is computed first, so the string is allocated once and written in place
+   * (unless compression or buffer pooling is enabled - see &l:ObjectMapper::setBufferPooling ();).
+   * If the second pass doesn't match the computed size (ex.: the object was modified concurrently), the object is serialized again to a growing buffer. <br>
+   * *Note: this method hides the non-virtual `oatpp::data::mapping::ObjectMapper::writeToString()`.
+   * Calls through the base class go to &l:ObjectMapper::write (); and pay for one more copy of the output.*
+   * @param variant - object to serialize.
+   * @return - serialized data.
+   */
+  oatpp::String writeToString(const oatpp::Void& variant) const;
+
+  /**
+   * Serialize objects as concatenated documents. See &id:oatpp::bob::Serializer::serializeManyToStream;. <br>
+   * With compression enabled the whole batch is written as one compressed frame.
+   * @param stream - stream to write to.
+   * @param items - objects to serialize.
+   */
+  void writeMany(oatpp::data::stream::ConsistentOutputStream* stream, const std::vector<oatpp::Void>& items) const;
+
+  /**
+   * Serialize objects as concatenated documents to string. The string is allocated once for the whole batch
+   * (unless compression is enabled).
+   * @param items - objects to serialize.
+   * @return - serialized data.
+   */
+  oatpp::String writeManyToString(const std::vector<oatpp::Void>& items) const;
+
+  /**
+   * Create pull-based serializer for the object. See &id:oatpp::bob::SerializerReadCallback;. <br>
+   * Use it as a body of the streaming response to send the object without buffering the whole encoding. <br>
+   * *Note: the output of the read callback is not compressed.*
+   * @param variant - object to serialize.
+   * @return - `std::shared_ptr` to &id:oatpp::data::stream::ReadCallback;.
+   */
+  std::shared_ptr<oatpp::data::stream::ReadCallback> createReadCallback(const oatpp::Void& variant) const;
+
   oatpp::Void read(oatpp::parser::Caret& caret, const oatpp::data::mapping::type::Type* const type) const override;
 
+  /**
+   * Read concatenated documents written with &l:ObjectMapper::writeMany ();. See &id:oatpp::bob::Deserializer::deserializeMany;.
+   * @param caret - &id:oatpp::parser::Caret;.
+   * @param type - type of each object.
+   * @return - deserialized objects.
+   */
+  std::vector<oatpp::Void> readMany(oatpp::parser::Caret& caret, const oatpp::data::mapping::type::Type* const type) const;
+
+  /**
+   * Read concatenated documents written with &l:ObjectMapper::writeMany ();.
+   * Throws `oatpp::parser::ParsingError` on error.
+   * @tparam Wrapper - type of each object.
+   * @param str - serialized data.
+   * @return - deserialized objects.
+   */
+  template<class Wrapper>
+  std::vector<Wrapper> readManyFromString(const oatpp::String& str) const {
+    oatpp::parser::Caret caret(str);
+    auto items = readMany(caret, Wrapper::Class::getType());
+    if(caret.hasError()) {
+      throw oatpp::parser::ParsingError(caret.getErrorMessage(), caret.getErrorCode(), caret.getPosition());
+    }
+    std::vector<Wrapper> result;
+    result.reserve(items.size());
+    for(auto& item : items) {
+      result.push_back(item.template cast<Wrapper>());
+    }
+    return result;
+  }
+
+  /**
+   * Read a range of elements of the array. See &id:oatpp::bob::Deserializer::deserializeSlice;.
+   * @param caret - &id:oatpp::parser::Caret;.
+   * @param type - collection type.
+   * @param offset - index of the first element.
+   * @param count - max number of elements to read.
+   * @return - `oatpp::Void` over the collection with elements of the range.
+   */
+  oatpp::Void readSlice(oatpp::parser::Caret& caret, const oatpp::data::mapping::type::Type* const type,
+                        v_buff_size offset, v_buff_size count) const;
+
+  /**
+   * Read a range of elements of the array. See &id:oatpp::bob::Deserializer::deserializeSlice;.
+   * @tparam Wrapper - collection type - ex.: `oatpp::Vector<oatpp::Object<MyDto>>`.
+   * @param str - serialized data.
+   * @param offset - index of the first element.
+   * @param count - max number of elements to read.
+   * @return - collection with elements of the range.
+   */
+  template<class Wrapper>
+  Wrapper readSliceFromString(const oatpp::String& str, v_buff_size offset, v_buff_size count) const {
+    auto type = Wrapper::Class::getType();
+    oatpp::parser::Caret caret(str);
+    auto result = readSlice(caret, type, offset, count).template cast<Wrapper>();
+    if(caret.hasError()) {
+      throw oatpp::parser::ParsingError(caret.getErrorMessage(), caret.getErrorCode(), caret.getPosition());
+    }
+    return result;
+  }
+
+  /**
+   * Read object from the memory-mapped file. <br>
+   * The document is parsed right in the mapped memory - the file is not loaded into a string first.
+   * Throws `oatpp::parser::ParsingError` on error.
+   * @tparam Wrapper - type of the object.
+   * @param file - &id:oatpp::bob::MappedFile;.
+   * @return - deserialized object.
+   */
+  template<class Wrapper>
+  Wrapper readFromFile(const MappedFile& file) const {
+    auto type = Wrapper::Class::getType();
+    oatpp::parser::Caret caret(file.getData(), file.getSize());
+    oatpp::Void result;
+    if(caret.canContinue()) {
+      result = read(caret, type);
+    } else {
+      caret.setError("[oatpp::bob::ObjectMapper::readFromFile()]: Error. File is empty.");
+    }
+    if(caret.hasError()) {
+      throw oatpp::parser::ParsingError(caret.getErrorMessage(), caret.getErrorCode(), caret.getPosition());
+    }
+    return result.template cast<Wrapper>();
+  }
+
+  /**
+   * Map the file and read object from it. See &l:ObjectMapper::readFromFile (const MappedFile& file);.
+   * @tparam Wrapper - type of the object.
+   * @param path - path to the file.
+   * @return - deserialized object.
+   */
+  template<class Wrapper>
+  Wrapper readFromFile(const oatpp::String& path) const {
+    MappedFile file(path, MappedFile::Access::SEQUENTIAL);
+    return readFromFile<Wrapper>(file);
+  }
+
+  /**
+   * Read a range of elements of the array stored in the memory-mapped file. <br>
+   * Only the pages of the file holding the requested elements (plus the array header and the index) are read
+   * when the array has the offset index - see &id:oatpp::bob::Serializer::Config::arrayIndexThreshold;. <br>
+   * Throws `oatpp::parser::ParsingError` on error.
+   * @tparam Wrapper - collection type - ex.: `oatpp::Vector<oatpp::Object<MyDto>>`.
+   * @param file - &id:oatpp::bob::MappedFile;. Open it with &id:oatpp::bob::MappedFile::Access::RANDOM; for paging.
+   * @param offset - index of the first element.
+   * @param count - max number of elements to read.
+   * @return - collection with elements of the range.
+   */
+  template<class Wrapper>
+  Wrapper readSliceFromFile(const MappedFile& file, v_buff_size offset, v_buff_size count) const {
+    auto type = Wrapper::Class::getType();
+    oatpp::parser::Caret caret(file.getData(), file.getSize());
+    oatpp::Void result;
+    if(caret.canContinue()) {
+      result = readSlice(caret, type, offset, count);
+    } else {
+      caret.setError("[oatpp::bob::ObjectMapper::readSliceFromFile()]: Error. File is empty.");
+    }
+    if(caret.hasError()) {
+      throw oatpp::parser::ParsingError(caret.getErrorMessage(), caret.getErrorCode(), caret.getPosition());
+    }
+    return result.template cast<Wrapper>();
+  }
+
 
   std::shared_ptr<Serializer> getSerializer();
 
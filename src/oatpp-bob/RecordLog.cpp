@@ -0,0 +1,181 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "RecordLog.hpp"
+
+#include "./Utils.hpp"
+
+#include <cstring>
+
+namespace oatpp { namespace bob {
+
+const v_char8 RecordLog::SYNC_MARKER[8] = {0x00, 'B', 'O', 'B', 'S', 'Y', 'N', 'C'};
+
+constexpr v_buff_size RecordLog::SYNC_MARKER_SIZE;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RecordLogWriter
+
+RecordLogWriter::RecordLogWriter(oatpp::data::stream::ConsistentOutputStream* stream,
+                                 const std::shared_ptr<ObjectMapper>& mapper,
+                                 v_buff_size syncInterval)
+  : m_stream(stream)
+  , m_mapper(mapper)
+  , m_syncInterval(syncInterval)
+  , m_position(0)
+  , m_lastSync(0)
+{
+  if(m_syncInterval > 0) {
+    m_stream->writeSimple(RecordLog::SYNC_MARKER, RecordLog::SYNC_MARKER_SIZE);
+    m_position += RecordLog::SYNC_MARKER_SIZE;
+  }
+}
+
+void RecordLogWriter::writeSyncIfNeeded() {
+  if(m_syncInterval > 0 && m_position - m_lastSync >= m_syncInterval) {
+    m_lastSync = m_position;
+    m_stream->writeSimple(RecordLog::SYNC_MARKER, RecordLog::SYNC_MARKER_SIZE);
+    m_position += RecordLog::SYNC_MARKER_SIZE;
+  }
+}
+
+void RecordLogWriter::append(const oatpp::Void& record) {
+  m_buffer.setCurrentPosition(0);
+  m_mapper->write(&m_buffer, record);
+  appendEncoded(m_buffer.getData(), m_buffer.getCurrentPosition());
+}
+
+void RecordLogWriter::appendEncoded(const void* data, v_buff_size size) {
+
+  if(size <= 0) {
+    throw std::runtime_error("[oatpp::bob::RecordLogWriter::appendEncoded()]: Error. Record can't be empty.");
+  }
+
+  writeSyncIfNeeded();
+
+  Utils::writeVarUInt(m_stream, (v_uint64) size);
+  m_stream->writeSimple(data, size);
+  m_position += Utils::getVarUIntSize((v_uint64) size) + size;
+
+}
+
+v_buff_size RecordLogWriter::getPosition() const {
+  return m_position;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RecordLogReader
+
+RecordLogReader::RecordLogReader(const char* data, v_buff_size size)
+  : m_data(data)
+  , m_size(size)
+  , m_position(0)
+  , m_error(nullptr)
+{}
+
+RecordLogReader::RecordLogReader(const oatpp::String& data)
+  : m_owner(data.getPtr())
+  , m_data(data->data())
+  , m_size(data->size())
+  , m_position(0)
+  , m_error(nullptr)
+{}
+
+RecordLogReader::RecordLogReader(const std::shared_ptr<MappedFile>& file)
+  : m_owner(file)
+  , m_data(file->getData())
+  , m_size(file->getSize())
+  , m_position(0)
+  , m_error(nullptr)
+{}
+
+bool RecordLogReader::isAtSyncMarker(v_buff_size position) const {
+  return m_size - position >= RecordLog::SYNC_MARKER_SIZE &&
+         std::memcmp(m_data + position, RecordLog::SYNC_MARKER, RecordLog::SYNC_MARKER_SIZE) == 0;
+}
+
+bool RecordLogReader::next(Record& record) {
+
+  m_error = nullptr;
+
+  while(m_position < m_size && m_data[m_position] == 0) {
+    if(!isAtSyncMarker(m_position)) {
+      m_error = "[oatpp::bob::RecordLogReader::next()]: Error. Invalid sync marker.";
+      return false;
+    }
+    m_position += RecordLog::SYNC_MARKER_SIZE;
+  }
+
+  if(m_position >= m_size) {
+    return false;
+  }
+
+  oatpp::parser::Caret caret(m_data, m_size);
+  caret.setPosition(m_position);
+  v_uint64 size = Utils::readVarUInt(caret);
+
+  if(caret.hasError() || size > (v_uint64) (m_size - caret.getPosition())) {
+    m_error = "[oatpp::bob::RecordLogReader::next()]: Error. Invalid record size.";
+    return false;
+  }
+
+  record.data = m_data + caret.getPosition();
+  record.size = (v_buff_size) size;
+  record.position = m_position;
+
+  m_position = caret.getPosition() + record.size;
+  return true;
+
+}
+
+bool RecordLogReader::resync() {
+  m_error = nullptr;
+  for(v_buff_size i = m_position + 1; i < m_size; i ++) {
+    if(isAtSyncMarker(i)) {
+      m_position = i;
+      return true;
+    }
+  }
+  m_position = m_size;
+  return false;
+}
+
+const char* RecordLogReader::getError() const {
+  return m_error;
+}
+
+v_buff_size RecordLogReader::getPosition() const {
+  return m_position;
+}
+
+oatpp::Void RecordLogReader::decode(const ObjectMapper& mapper, const Record& record, const oatpp::Type* type) {
+  oatpp::parser::Caret caret(record.data, record.size);
+  auto result = mapper.read(caret, type);
+  if(caret.hasError()) {
+    throw oatpp::parser::ParsingError(caret.getErrorMessage(), caret.getErrorCode(), record.position + caret.getPosition());
+  }
+  return result;
+}
+
+}}
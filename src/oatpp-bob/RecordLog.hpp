@@ -0,0 +1,225 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_BOB_RECORDLOG_HPP
+#define OATPP_BOB_RECORDLOG_HPP
+
+#include "./ObjectMapper.hpp"
+#include "./MappedFile.hpp"
+
+#include "oatpp/core/data/stream/BufferStream.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace oatpp { namespace bob {
+
+/**
+ * Framing of the record log - sequence of BOB documents. <br>
+ * Record is `<varint size><BOB document>`. Sync marker is `0x00 "BOBSYNC"` (size `0` never starts a record) -
+ * &l:RecordLogWriter; writes it every `syncInterval` bytes so that readers can resynchronize after a corrupted record.
+ */
+class RecordLog {
+public:
+
+  /**
+   * Sync marker.
+   */
+  static const v_char8 SYNC_MARKER[8];
+
+  /**
+   * Size of the sync marker.
+   */
+  static constexpr v_buff_size SYNC_MARKER_SIZE = 8;
+
+};
+
+/**
+ * Appends BOB records to the stream.
+ * Records are encoded to the scratch buffer which is reused for all records.
+ */
+class RecordLogWriter {
+private:
+  oatpp::data::stream::ConsistentOutputStream* m_stream;
+  std::shared_ptr<ObjectMapper> m_mapper;
+  v_buff_size m_syncInterval;
+  v_buff_size m_position;
+  v_buff_size m_lastSync;
+  oatpp::data::stream::BufferOutputStream m_buffer;
+private:
+  void writeSyncIfNeeded();
+public:
+
+  /**
+   * Constructor.
+   * @param stream - stream to write records to - ex.: `oatpp::data::stream::FileOutputStream`.
+   * @param mapper - &id:oatpp::bob::ObjectMapper; used to encode records.
+   * @param syncInterval - write sync marker before the record once this number of bytes was written since the previous marker.
+   * `0` - don't write sync markers.
+   */
+  RecordLogWriter(oatpp::data::stream::ConsistentOutputStream* stream,
+                  const std::shared_ptr<ObjectMapper>& mapper = std::make_shared<ObjectMapper>(),
+                  v_buff_size syncInterval = 0);
+
+  /**
+   * Encode and append record.
+   * @param record - object to encode.
+   */
+  void append(const oatpp::Void& record);
+
+  /**
+   * Append already encoded record.
+   * @param data - BOB document.
+   * @param size - size of the document.
+   */
+  void appendEncoded(const void* data, v_buff_size size);
+
+  /**
+   * Get number of bytes written.
+   * @return
+   */
+  v_buff_size getPosition() const;
+
+};
+
+/**
+ * Sequential reader of the record log. <br>
+ * Records are handed out as views over the log data - no copying.
+ */
+class RecordLogReader {
+public:
+
+  /**
+   * View of the record.
+   */
+  struct Record {
+
+    /**
+     * Pointer to the BOB document of the record.
+     */
+    const char* data;
+
+    /**
+     * Size of the document.
+     */
+    v_buff_size size;
+
+    /**
+     * Position of the record in the log.
+     */
+    v_buff_size position;
+
+  };
+
+private:
+  std::shared_ptr<void> m_owner;
+  const char* m_data;
+  v_buff_size m_size;
+  v_buff_size m_position;
+  const char* m_error;
+private:
+  bool isAtSyncMarker(v_buff_size position) const;
+  static oatpp::Void decode(const ObjectMapper& mapper, const Record& record, const oatpp::Type* type);
+public:
+
+  /**
+   * Constructor.
+   * @param data - log data. Must stay valid while the reader and its records are used.
+   * @param size - size of the data.
+   */
+  RecordLogReader(const char* data, v_buff_size size);
+
+  /**
+   * Constructor.
+   * @param data - log data.
+   */
+  RecordLogReader(const oatpp::String& data);
+
+  /**
+   * Constructor.
+   * @param file - memory-mapped log file. See &id:oatpp::bob::MappedFile;.
+   */
+  RecordLogReader(const std::shared_ptr<MappedFile>& file);
+
+  /**
+   * Read next record.
+   * @param record - &l:RecordLogReader::Record;.
+   * @return - `false` if there are no more records or the record is corrupted - see &l:RecordLogReader::getError ();.
+   */
+  bool next(Record& record);
+
+  /**
+   * Skip to the next sync marker. Use it to continue reading after a corrupted record.
+   * @return - `true` if the marker was found.
+   */
+  bool resync();
+
+  /**
+   * Get error of the last call to &l:RecordLogReader::next ();.
+   * @return - error message or `nullptr` if there is no error.
+   */
+  const char* getError() const;
+
+  /**
+   * Get current position in the log.
+   * @return
+   */
+  v_buff_size getPosition() const;
+
+  /**
+   * Decode record. Throws `oatpp::parser::ParsingError` on error.
+   * @tparam Wrapper - type of the object.
+   * @param mapper - &id:oatpp::bob::ObjectMapper;.
+   * @param record - &l:RecordLogReader::Record;.
+   * @return - decoded object.
+   */
+  template<class Wrapper>
+  static Wrapper read(const ObjectMapper& mapper, const Record& record) {
+    return decode(mapper, record, Wrapper::Class::getType()).template cast<Wrapper>();
+  }
+
+  /**
+   * Read and decode up to `maxCount` next records. Throws `oatpp::parser::ParsingError` on error.
+   * @tparam Wrapper - type of the object.
+   * @param mapper - &id:oatpp::bob::ObjectMapper;.
+   * @param maxCount - max number of records.
+   * @return - decoded objects. Empty when there are no more records.
+   */
+  template<class Wrapper>
+  std::vector<Wrapper> readBatch(const ObjectMapper& mapper, v_buff_size maxCount) {
+    std::vector<Wrapper> result;
+    /* record takes at least 2 bytes - non-zero size varint and the document */
+    result.reserve((std::size_t) std::max<v_buff_size>(0, std::min<v_buff_size>(maxCount, (m_size - m_position) / 2)));
+    Record record;
+    while((v_buff_size) result.size() < maxCount && next(record)) {
+      result.push_back(read<Wrapper>(mapper, record));
+    }
+    return result;
+  }
+
+};
+
+}}
+
+#endif /* OATPP_BOB_RECORDLOG_HPP */
@@ -24,17 +24,94 @@
 
 #include "Serializer.hpp"
 
+#include "./Stream.hpp"
 #include "./Utils.hpp"
 
+#include <chrono>
+#include <thread>
+
 namespace oatpp { namespace bob {
 
+thread_local Serializer::Session* Serializer::CURRENT_SESSION = nullptr;
+
+namespace {
+
+/* set for threads encoding chunks of a collection - nested collections are encoded sequentially */
+thread_local bool t_parallelWorker = false;
+
+/*
+ * Stream of the last value counted to Statistics - nested values are written to the same stream, so its position getter is resolved once.
+ * Reset by the top-level calls - stream addresses are reused.
+ */
+struct StatisticsStream {
+  oatpp::data::stream::ConsistentOutputStream* stream;
+  v_buff_size (*position)(oatpp::data::stream::ConsistentOutputStream*);
+  bool sizePass; // CountingOutputStream of computeSize() - not counted
+};
+
+thread_local StatisticsStream t_statisticsStream = {nullptr, nullptr, false};
+
+bool readIntegral(const oatpp::Void& value, v_int64& result) {
+  auto id = value.getValueType()->classId.id;
+  if(id == oatpp::Int8::Class::CLASS_ID.id) {
+    result = *static_cast<v_int8*>(value.get());
+  } else if(id == oatpp::UInt8::Class::CLASS_ID.id) {
+    result = *static_cast<v_uint8*>(value.get());
+  } else if(id == oatpp::Int16::Class::CLASS_ID.id) {
+    result = *static_cast<v_int16*>(value.get());
+  } else if(id == oatpp::UInt16::Class::CLASS_ID.id) {
+    result = *static_cast<v_uint16*>(value.get());
+  } else if(id == oatpp::Int32::Class::CLASS_ID.id) {
+    result = *static_cast<v_int32*>(value.get());
+  } else if(id == oatpp::UInt32::Class::CLASS_ID.id) {
+    result = *static_cast<v_uint32*>(value.get());
+  } else if(id == oatpp::Int64::Class::CLASS_ID.id) {
+    result = *static_cast<v_int64*>(value.get());
+  } else if(id == oatpp::UInt64::Class::CLASS_ID.id) {
+    result = (v_int64) *static_cast<v_uint64*>(value.get());
+  } else {
+    return false;
+  }
+  return true;
+}
+
+}
+
 Serializer::Serializer(const std::shared_ptr<Config>& config)
-  : m_config(config)
+  : m_userConfig(config)
+  , m_statistics(nullptr)
 {
-
   m_methods.resize(oatpp::data::mapping::type::ClassId::getClassCount(), nullptr);
+  applyConfig();
+}
+
+void Serializer::applyConfig() {
+
+  if(m_userConfig->arrayIndexStride < 1) {
+    throw std::runtime_error("[oatpp::bob::Serializer::applyConfig()]: Error. Invalid arrayIndexStride.");
+  }
 
-  setSerializerMethod(oatpp::data::mapping::type::__class::String::CLASS_ID, &Serializer::serializeString);
+  /* methods set with setSerializerMethod() are kept */
+  std::vector<SerializerMethod> customMethods(m_methods.size(), nullptr);
+  for(v_buff_size i = 0; i < (v_buff_size) m_methods.size(); i ++) {
+    SerializerMethod builtin = i < (v_buff_size) m_builtinMethods.size() ? m_builtinMethods[i] : nullptr;
+    if(m_methods[i] != builtin) {
+      customMethods[i] = m_methods[i];
+    }
+  }
+
+  m_config = std::make_shared<Config>(*m_userConfig);
+  m_statistics = m_config->statistics.get();
+
+  m_needsSession = m_config->useKeyTable || m_config->stringDedupTableSize > 0 ||
+                   (m_config->positionalObjects && m_config->embedObjectSchemas);
+  m_needsBackPatching = m_config->sizedContainers || m_config->arrayIndexThreshold > 0;
+
+  if(m_config->stringDedupTableSize > 0) {
+    setSerializerMethod(oatpp::data::mapping::type::__class::String::CLASS_ID, &Serializer::serializeStringDedup);
+  } else {
+    setSerializerMethod(oatpp::data::mapping::type::__class::String::CLASS_ID, &Serializer::serializeString);
+  }
   setSerializerMethod(oatpp::data::mapping::type::__class::Any::CLASS_ID, &Serializer::serializeAny);
 
   setSerializerMethod(oatpp::data::mapping::type::__class::Int8::CLASS_ID, &Serializer::serializeInt1);
@@ -53,16 +130,72 @@ Serializer::Serializer(const std::shared_ptr<Config>& config)
   setSerializerMethod(oatpp::data::mapping::type::__class::Float64::CLASS_ID, &Serializer::serializeFloat8);
   setSerializerMethod(oatpp::data::mapping::type::__class::Boolean::CLASS_ID, &Serializer::serializeBool);
 
-  setSerializerMethod(oatpp::data::mapping::type::__class::AbstractObject::CLASS_ID, &Serializer::serializeObject);
+  /* Select methods specialized for the config flags - no config checks in the loops */
+
+  m_selection.includeNullFields = m_config->includeNullFields;
+  m_selection.alwaysIncludeRequired = m_config->alwaysIncludeRequired;
+  m_selection.includeNullElements = m_config->includeNullFields || m_config->alwaysIncludeNullCollectionElements;
+  m_selection.keyTable = m_config->useKeyTable;
+
+  const bool keyTable = m_selection.keyTable;
+
+  if(m_config->positionalObjects) {
+    m_objectMethod = &Serializer::serializeObjectPositional;
+  } else if(m_selection.includeNullFields) {
+    m_objectMethod = keyTable ? &Serializer::serializeObjectImpl<true, false, true>
+                              : &Serializer::serializeObjectImpl<true, false, false>;
+  } else if(m_selection.alwaysIncludeRequired) {
+    m_objectMethod = keyTable ? &Serializer::serializeObjectImpl<false, true, true>
+                              : &Serializer::serializeObjectImpl<false, true, false>;
+  } else {
+    m_objectMethod = keyTable ? &Serializer::serializeObjectImpl<false, false, true>
+                              : &Serializer::serializeObjectImpl<false, false, false>;
+  }
+
+  m_keyedObjectMethod = m_objectMethod;
+  if(m_config->fieldIds) {
+    m_objectMethod = &Serializer::serializeObjectWithIds; // types without ids go to m_keyedObjectMethod
+  }
+
+  if(m_selection.includeNullElements) {
+    m_collectionMethod = &Serializer::serializeCollectionImpl<true>;
+    m_mapMethod = keyTable ? &Serializer::serializeMapImpl<true, true> : &Serializer::serializeMapImpl<true, false>;
+  } else {
+    m_collectionMethod = &Serializer::serializeCollectionImpl<false>;
+    m_mapMethod = keyTable ? &Serializer::serializeMapImpl<false, true> : &Serializer::serializeMapImpl<false, false>;
+  }
+
+  SerializerMethod objectMethod = m_objectMethod;
+  if(m_config->subtreeCache) {
+    objectMethod = &Serializer::serializeObjectCached;
+  }
+
+  setSerializerMethod(oatpp::data::mapping::type::__class::AbstractObject::CLASS_ID, objectMethod);
   setSerializerMethod(oatpp::data::mapping::type::__class::AbstractEnum::CLASS_ID, &Serializer::serializeEnum);
 
-  setSerializerMethod(oatpp::data::mapping::type::__class::AbstractVector::CLASS_ID, &Serializer::serializeCollection);
-  setSerializerMethod(oatpp::data::mapping::type::__class::AbstractList::CLASS_ID, &Serializer::serializeCollection);
-  setSerializerMethod(oatpp::data::mapping::type::__class::AbstractUnorderedSet::CLASS_ID, &Serializer::serializeCollection);
+  if(m_config->columnarObjectVectors) {
+    setSerializerMethod(oatpp::data::mapping::type::__class::AbstractVector::CLASS_ID, &Serializer::serializeVectorColumnar);
+  } else {
+    setSerializerMethod(oatpp::data::mapping::type::__class::AbstractVector::CLASS_ID, m_collectionMethod);
+  }
+  setSerializerMethod(oatpp::data::mapping::type::__class::AbstractList::CLASS_ID, m_collectionMethod);
+  setSerializerMethod(oatpp::data::mapping::type::__class::AbstractUnorderedSet::CLASS_ID, m_collectionMethod);
+
+  setSerializerMethod(oatpp::data::mapping::type::__class::AbstractPairList::CLASS_ID, m_mapMethod);
+  setSerializerMethod(oatpp::data::mapping::type::__class::AbstractUnorderedMap::CLASS_ID, m_mapMethod);
 
-  setSerializerMethod(oatpp::data::mapping::type::__class::AbstractPairList::CLASS_ID, &Serializer::serializeMap);
-  setSerializerMethod(oatpp::data::mapping::type::__class::AbstractUnorderedMap::CLASS_ID, &Serializer::serializeMap);
+  m_builtinMethods = m_methods;
 
+  for(v_buff_size i = 0; i < (v_buff_size) customMethods.size(); i ++) {
+    if(customMethods[i]) {
+      m_methods[i] = customMethods[i];
+    }
+  }
+
+}
+
+void Serializer::reloadConfig() {
+  applyConfig();
 }
 
 void Serializer::setSerializerMethod(const oatpp::data::mapping::type::ClassId& classId, SerializerMethod method) {
@@ -71,13 +204,148 @@ void Serializer::setSerializerMethod(const oatpp::data::mapping::type::ClassId&
     m_methods.resize(id + 1, nullptr);
   }
   m_methods[id] = method;
+  m_objectInfos.clear();
 }
 
 void Serializer::serializeKey(ConsistentOutputStream* stream, const char* data, v_buff_size size) {
+  if(size > 0 && (v_char8) data[0] == Utils::KEY_REFERENCE) {
+    throw std::runtime_error("[oatpp::bob::Serializer::serializeKey()]: Error. Key can't start with the 0xFF byte - it's reserved for key references.");
+  }
   stream->writeSimple(data, size);
   stream->writeCharSimple(0);
 }
 
+void Serializer::writeObjectKey(ConsistentOutputStream* stream, const ObjectField& field, bool nullTag) {
+
+  Session* session = CURRENT_SESSION;
+
+  if(session && session->stream == stream) {
+
+    const v_buff_size position = session->getPosition();
+    auto it = session->objectKeys.find(field.key);
+
+    if(it != session->objectKeys.end()) {
+      const v_uint64 distance = position - it->second;
+      if(it->second >= session->documentStart && 1 + Utils::getVarUIntSize(distance) < field.keySize) {
+        stream->writeCharSimple(Utils::KEY_REFERENCE);
+        Utils::writeVarUInt(stream, distance);
+        if(nullTag) {
+          stream->writeCharSimple(Utils::TYPE_NULL);
+        }
+        return;
+      }
+      it->second = position; // reference the latest occurrence - keeps distances short
+    } else {
+      session->objectKeys.insert({field.key, position});
+    }
+
+  }
+
+  stream->writeSimple(field.key, nullTag ? field.keySize + 1 : field.keySize);
+
+}
+
+void Serializer::writeMapKey(ConsistentOutputStream* stream, const char* data, v_buff_size size) {
+
+  Session* session = CURRENT_SESSION;
+
+  if(session && session->stream == stream) {
+
+    const v_buff_size position = session->getPosition();
+    std::string key(data, size);
+    auto it = session->mapKeys.find(key);
+
+    if(it != session->mapKeys.end()) {
+      const v_uint64 distance = position - it->second;
+      if(1 + Utils::getVarUIntSize(distance) < size + 1) {
+        stream->writeCharSimple(Utils::KEY_REFERENCE);
+        Utils::writeVarUInt(stream, distance);
+        return;
+      }
+      it->second = position;
+    } else if(session->mapKeys.size() < Session::MAX_MAP_KEYS) {
+      session->mapKeys.insert({std::move(key), position});
+    }
+
+  }
+
+  serializeKey(stream, data, size);
+
+}
+
+Serializer::PositionGetter Serializer::getPatchPositionGetter(ConsistentOutputStream* stream) {
+  if(dynamic_cast<oatpp::data::stream::BufferOutputStream*>(stream)) {
+    return [](ConsistentOutputStream* s) {
+      return static_cast<oatpp::data::stream::BufferOutputStream*>(s)->getCurrentPosition();
+    };
+  }
+  if(dynamic_cast<FixedBufferOutputStream*>(stream)) {
+    return [](ConsistentOutputStream* s) {
+      return static_cast<FixedBufferOutputStream*>(s)->getCurrentPosition();
+    };
+  }
+  auto counter = dynamic_cast<CountingOutputStream*>(stream);
+  if(counter && counter->getTarget() == nullptr) {
+    return [](ConsistentOutputStream* s) {
+      return static_cast<CountingOutputStream*>(s)->getSize();
+    };
+  }
+  return nullptr;
+}
+
+v_buff_size Serializer::getPatchPosition(ConsistentOutputStream* stream) {
+  auto getter = getPatchPositionGetter(stream);
+  return getter ? getter(stream) : -1;
+}
+
+v_buff_size Serializer::beginSizedContainer(ConsistentOutputStream* stream, v_char8 tag) {
+  v_buff_size start = getPatchPosition(stream);
+  if(start < 0) {
+    throw std::runtime_error("[oatpp::bob::Serializer::beginSizedContainer()]: Error. Stream doesn't support back-patching.");
+  }
+  v_char8 header[Utils::SIZED_CONTAINER_HEADER_SIZE] = {tag, 0, 0, 0, 0, 0, 0, 0, 0};
+  stream->writeSimple(header, Utils::SIZED_CONTAINER_HEADER_SIZE);
+  return start;
+}
+
+void Serializer::endSizedContainer(ConsistentOutputStream* stream, v_buff_size start, v_buff_size count) {
+
+  v_buff_size size = getPatchPosition(stream) - start - Utils::SIZED_CONTAINER_HEADER_SIZE;
+  if(size > 0xFFFFFFFF || count > 0xFFFFFFFF) {
+    throw std::runtime_error("[oatpp::bob::Serializer::endSizedContainer()]: Error. Container is too large.");
+  }
+
+  p_char8 data;
+  if(auto buffer = dynamic_cast<oatpp::data::stream::BufferOutputStream*>(stream)) {
+    data = buffer->getData();
+  } else if(auto buffer = dynamic_cast<FixedBufferOutputStream*>(stream)) {
+    data = buffer->getData();
+  } else {
+    return; // counting only
+  }
+
+  /* size and count in network byte order */
+  p_char8 header = data + start + 1;
+  for(v_int32 i = 0; i < 4; i ++) {
+    header[i] = (v_char8) (size >> (24 - i * 8));
+    header[4 + i] = (v_char8) (count >> (24 - i * 8));
+  }
+
+}
+
+void Serializer::serializeOrdinal(ConsistentOutputStream* stream, v_uint32 ordinal) {
+  if(ordinal < ((v_uint32)1 << 8)) {
+    stream->writeCharSimple(Utils::TYPE_UINT_1);
+    Utils::writeInt8(stream, (v_int8) ordinal);
+  } else if(ordinal < ((v_uint32)1 << 16)) {
+    stream->writeCharSimple(Utils::TYPE_UINT_2);
+    Utils::writeInt16(stream, (v_int16) ordinal, Utils::BO_TYPE::NETWORK);
+  } else {
+    stream->writeCharSimple(Utils::TYPE_UINT_4);
+    Utils::writeInt32(stream, (v_int32) ordinal, Utils::BO_TYPE::NETWORK);
+  }
+}
+
 void Serializer::serializeString(Serializer* serializer,
                                  ConsistentOutputStream* stream,
                                  const oatpp::Void& polymorph)
@@ -103,10 +371,62 @@ void Serializer::serializeString(Serializer* serializer,
     throw std::runtime_error("[oatpp::bob::Serializer::serializeString()]: Error. Invalid string size.");
   }
 
+  if((v_buff_size) str->size() >= serializer->m_config->stringReferenceThreshold) {
+    auto segmentedStream = dynamic_cast<SegmentedOutputStream*>(stream);
+    if(segmentedStream) {
+      segmentedStream->writeReference(polymorph.getPtr(), str->data(), str->size());
+      return;
+    }
+  }
+
   stream->writeSimple(str->data(), str->size());
 
 }
 
+void Serializer::serializeStringDedup(Serializer* serializer,
+                                      ConsistentOutputStream* stream,
+                                      const oatpp::Void& polymorph)
+{
+
+  Session* session = CURRENT_SESSION;
+
+  if(!polymorph || !session || session->stream != stream) {
+    serializeString(serializer, stream, polymorph);
+    return;
+  }
+
+  auto str = static_cast<std::string*>(polymorph.get());
+  const v_buff_size size = str->size();
+
+  if(size < 2) { // reference is at least 2 bytes
+    serializeString(serializer, stream, polymorph);
+    return;
+  }
+
+  if(session->strings.empty()) {
+    session->strings.resize(serializer->m_config->stringDedupTableSize);
+  }
+
+  auto& slot = session->strings[std::hash<std::string>()(*str) % session->strings.size()];
+  const v_buff_size position = session->getPosition();
+
+  if(slot.value && slot.position >= session->documentStart && (slot.value.get() == str || *slot.value == *str)) {
+    const v_uint64 distance = position - slot.position;
+    const v_buff_size encodedSize = size + (size < (1 << 8) ? 2 : (size < (1 << 16) ? 3 : 5));
+    if(1 + Utils::getVarUIntSize(distance) < encodedSize) {
+      stream->writeCharSimple(Utils::TYPE_STRING_REFERENCE);
+      Utils::writeVarUInt(stream, distance);
+      return;
+    }
+  }
+
+  /* references always point to a plain string - the latest one to keep distances short */
+  slot.position = position;
+  slot.value = std::static_pointer_cast<std::string>(polymorph.getPtr());
+  serializeString(serializer, stream, polymorph);
+
+}
+
 void Serializer::serializeBool(Serializer* serializer, ConsistentOutputStream* stream, const oatpp::Void& polymorph) {
   if(!polymorph) {
     stream->writeCharSimple(Utils::TYPE_NULL);
@@ -246,9 +566,14 @@ void Serializer::serializeEnum(Serializer* serializer,
   );
 
   oatpp::data::mapping::type::EnumInterpreterError e = oatpp::data::mapping::type::EnumInterpreterError::OK;
-  serializer->serialize(stream, polymorphicDispatcher->toInterpretation(polymorph, e));
+  const auto& interpretation = polymorphicDispatcher->toInterpretation(polymorph, e);
 
   if(e == oatpp::data::mapping::type::EnumInterpreterError::OK) {
+    if(interpretation && serializer->m_config->enumsAsOrdinals) {
+      serializeOrdinal(stream, serializer->getEnumOrdinal(polymorph.getValueType(), interpretation));
+    } else {
+      serializer->serialize(stream, interpretation);
+    }
     return;
   }
 
@@ -265,6 +590,14 @@ void Serializer::serializeCollection(Serializer* serializer,
                                      ConsistentOutputStream* stream,
                                      const oatpp::Void& polymorph)
 {
+  (*serializer->m_collectionMethod)(serializer, stream, polymorph);
+}
+
+template<bool includeNullElements>
+void Serializer::serializeCollectionImpl(Serializer* serializer,
+                                         ConsistentOutputStream* stream,
+                                         const oatpp::Void& polymorph)
+{
 
   if(!polymorph) {
     stream->writeCharSimple(Utils::TYPE_NULL);
@@ -275,27 +608,78 @@ void Serializer::serializeCollection(Serializer* serializer,
     polymorph.getValueType()->polymorphicDispatcher
   );
 
-  stream->writeCharSimple(Utils::CONTROL_ARRAY_BEGIN);
-  bool first = true;
+  const auto& config = serializer->m_config;
+  const v_buff_size collectionSize = dispatcher->getCollectionSize(polymorph);
+  const bool indexed = config->arrayIndexThreshold > 0 && collectionSize >= config->arrayIndexThreshold;
+  const bool sized = indexed || config->sizedContainers;
+  v_buff_size start = 0;
+  v_buff_size count = 0;
+
+  std::vector<v_buff_size> index;
+  PositionGetter position = nullptr;
+  v_buff_size valuesStart = 0;
+
+  if(indexed) {
+    start = beginSizedContainer(stream, Utils::CONTROL_ARRAY_INDEXED);
+    Utils::writeInt32(stream, config->arrayIndexStride, Utils::BO_TYPE::NETWORK);
+    position = getPatchPositionGetter(stream);
+    valuesStart = position(stream);
+    index.reserve(collectionSize / config->arrayIndexStride + 1);
+  } else if(sized) {
+    start = beginSizedContainer(stream, Utils::CONTROL_ARRAY_SIZED);
+  } else {
+    stream->writeCharSimple(Utils::CONTROL_ARRAY_BEGIN);
+  }
 
-  auto iterator = dispatcher->beginIteration(polymorph);
+  if(config->parallelThreads > 1 && !t_parallelWorker && collectionSize >= config->parallelCollectionThreshold) {
+    count = serializer->serializeItemsParallel(stream, polymorph, includeNullElements, indexed ? &index : nullptr);
+  } else {
 
-  while (!iterator->finished()) {
-    const auto& value = iterator->get();
-    if(value || serializer->getConfig()->includeNullFields || serializer->getConfig()->alwaysIncludeNullCollectionElements) {
-      serializer->serialize(stream, value);
+    auto iterator = dispatcher->beginIteration(polymorph);
+
+    while (!iterator->finished()) {
+      const auto& value = iterator->get();
+      if(isElementWritten(value, includeNullElements)) {
+        if(indexed && count % config->arrayIndexStride == 0) {
+          index.push_back(position(stream) - valuesStart);
+        }
+        serializer->serialize(stream, value);
+        count ++;
+      }
+      iterator->next();
     }
-    iterator->next();
+
   }
 
   stream->writeCharSimple(Utils::CONTROL_SECTION_END);
 
+  if(indexed) {
+    for(auto offset : index) {
+      if(offset > 0xFFFFFFFF) {
+        throw std::runtime_error("[oatpp::bob::Serializer::serializeCollection()]: Error. Container is too large.");
+      }
+      Utils::writeInt32(stream, (v_int32) offset, Utils::BO_TYPE::NETWORK);
+    }
+  }
+
+  if(sized) {
+    endSizedContainer(stream, start, count);
+  }
+
 }
 
 void Serializer::serializeMap(Serializer* serializer,
                               ConsistentOutputStream* stream,
                               const oatpp::Void& polymorph)
 {
+  (*serializer->m_mapMethod)(serializer, stream, polymorph);
+}
+
+template<bool includeNullElements, bool keyTable>
+void Serializer::serializeMapImpl(Serializer* serializer,
+                                  ConsistentOutputStream* stream,
+                                  const oatpp::Void& polymorph)
+{
 
   if(!polymorph) {
     stream->writeCharSimple(Utils::TYPE_NULL);
@@ -311,68 +695,442 @@ void Serializer::serializeMap(Serializer* serializer,
     throw std::runtime_error("[oatpp::bob::Serializer::serializeMap()]: Invalid json map key. Key should be String");
   }
 
-  stream->writeCharSimple(Utils::CONTROL_MAP_BEGIN);
-  bool first = true;
+  const bool sized = serializer->m_config->sizedContainers;
+  v_buff_size start = 0;
+  v_buff_size count = 0;
+
+  if(sized) {
+    start = beginSizedContainer(stream, Utils::CONTROL_MAP_SIZED);
+  } else {
+    stream->writeCharSimple(Utils::CONTROL_MAP_BEGIN);
+  }
 
   auto iterator = dispatcher->beginIteration(polymorph);
 
   while (!iterator->finished()) {
     const auto& value = iterator->getValue();
-    if(value || serializer->m_config->includeNullFields || serializer->m_config->alwaysIncludeNullCollectionElements) {
+    if(isElementWritten(value, includeNullElements)) {
       const auto& untypedKey = iterator->getKey();
-      const auto& key = oatpp::String(std::static_pointer_cast<std::string>(untypedKey.getPtr()));
-      serializeKey(stream, key->data(), key->size());
+      writeEntryKey(stream, static_cast<std::string*>(untypedKey.get()), keyTable);
       serializer->serialize(stream, value);
+      count ++;
     }
     iterator->next();
   }
 
   stream->writeCharSimple(Utils::CONTROL_SECTION_END);
 
+  if(sized) {
+    endSizedContainer(stream, start, count);
+  }
+
 }
 
 void Serializer::serializeObject(Serializer* serializer,
                                  ConsistentOutputStream* stream,
                                  const oatpp::Void& polymorph)
 {
+  (*serializer->m_objectMethod)(serializer, stream, polymorph);
+}
+
+template<bool includeNullFields, bool alwaysIncludeRequired, bool keyTable>
+void Serializer::serializeObjectImpl(Serializer* serializer,
+                                     ConsistentOutputStream* stream,
+                                     const oatpp::Void& polymorph)
+{
 
   if(!polymorph) {
     stream->writeCharSimple(Utils::TYPE_NULL);
     return;
   }
 
-  stream->writeCharSimple(Utils::CONTROL_MAP_BEGIN);
+  const bool sized = serializer->m_config->sizedContainers;
+  v_buff_size start = 0;
+  v_buff_size count = 0;
+
+  if(sized) {
+    start = beginSizedContainer(stream, Utils::CONTROL_MAP_SIZED);
+  } else {
+    stream->writeCharSimple(Utils::CONTROL_MAP_BEGIN);
+  }
 
-  auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::AbstractObject::PolymorphicDispatcher*>(
-    polymorph.getValueType()->polymorphicDispatcher
-  );
-  auto fields = dispatcher->getProperties()->getList();
   auto object = static_cast<oatpp::BaseObject*>(polymorph.get());
-  auto config = serializer->m_config;
+  auto info = serializer->getObjectInfo(polymorph.getValueType());
+
+  for (auto const& field : info->fields) {
+    const auto& value = getFieldValue(field.property, object);
+    if(isFieldWritten(field, value, includeNullFields, alwaysIncludeRequired)) {
+      if(writeFieldKey(stream, field, value, keyTable)) {
+        serializer->serialize(stream, value);
+      }
+      count ++;
+    }
+  }
 
-  for (auto const& field : fields) {
+  stream->writeCharSimple(Utils::CONTROL_SECTION_END);
 
-    oatpp::Void value;
-    if(field->info.typeSelector && field->type == oatpp::Any::Class::getType()) {
-      const auto& any = field->get(object).cast<oatpp::Any>();
-      value = any.retrieve(field->info.typeSelector->selectType(object));
-    } else {
-      value = field->get(object);
+  if(sized) {
+    endSizedContainer(stream, start, count);
+  }
+
+}
+
+void Serializer::serializeObjectPositional(Serializer* serializer,
+                                          ConsistentOutputStream* stream,
+                                          const oatpp::Void& polymorph)
+{
+
+  if(!polymorph) {
+    stream->writeCharSimple(Utils::TYPE_NULL);
+    return;
+  }
+
+  auto object = static_cast<oatpp::BaseObject*>(polymorph.get());
+  auto info = serializer->getObjectInfo(polymorph.getValueType());
+
+  stream->writeCharSimple(Utils::CONTROL_OBJECT_POSITIONAL);
+  Utils::writeInt32(stream, (v_int32) info->fingerprint, Utils::BO_TYPE::NETWORK);
+
+  Session* session = CURRENT_SESSION;
+  if(serializer->m_config->embedObjectSchemas && session && session->stream == stream &&
+     session->schemas.insert(info->fingerprint).second)
+  {
+    Utils::writeVarUInt(stream, info->fields.size());
+    for(auto const& field : info->fields) {
+      stream->writeSimple(field.key, field.keySize);
     }
+  } else {
+    Utils::writeVarUInt(stream, 0);
+  }
+
+  for(auto const& field : info->fields) {
+
+    const auto& value = getFieldValue(field.property, object);
 
-    if (value || config->includeNullFields || (field->info.required && config->alwaysIncludeRequired)) {
-      serializeKey(stream, field->name, std::strlen(field->name));
+    if(value || !field.nullTag) {
       serializer->serialize(stream, value);
+    } else {
+      stream->writeCharSimple(Utils::TYPE_NULL);
+    }
+
+  }
+
+  stream->writeCharSimple(Utils::CONTROL_SECTION_END);
+
+}
+
+void Serializer::serializeObjectWithIds(Serializer* serializer,
+                                        ConsistentOutputStream* stream,
+                                        const oatpp::Void& polymorph)
+{
+
+  if(!polymorph) {
+    stream->writeCharSimple(Utils::TYPE_NULL);
+    return;
+  }
+
+  auto info = serializer->getObjectInfo(polymorph.getValueType());
+  if(!info->hasIds) {
+    (*serializer->m_keyedObjectMethod)(serializer, stream, polymorph);
+    return;
+  }
+
+  const Selection& selection = serializer->m_selection;
+
+  auto object = static_cast<oatpp::BaseObject*>(polymorph.get());
+
+  stream->writeCharSimple(Utils::CONTROL_OBJECT_IDS);
+
+  for(auto const& field : info->fields) {
+    const auto& value = getFieldValue(field.property, object);
+    if(isFieldWritten(field, value, selection.includeNullFields, selection.alwaysIncludeRequired)) {
+      Utils::writeVarUInt(stream, field.id);
+      if(value || !field.nullTag) {
+        serializer->serialize(stream, value);
+      } else {
+        stream->writeCharSimple(Utils::TYPE_NULL);
+      }
+    }
+  }
+
+  stream->writeCharSimple(Utils::CONTROL_SECTION_END);
+
+}
+
+void Serializer::serializeObjectCached(Serializer* serializer,
+                                       ConsistentOutputStream* stream,
+                                       const oatpp::Void& polymorph)
+{
+
+  if(!polymorph) {
+    stream->writeCharSimple(Utils::TYPE_NULL);
+    return;
+  }
+
+  const auto& cache = serializer->m_config->subtreeCache;
+  auto lookup = cache->get(serializer, polymorph.get());
+
+  if(!lookup.registered) {
+    (*serializer->m_objectMethod)(serializer, stream, polymorph);
+    return;
+  }
+
+  if(!lookup.data) {
+    oatpp::data::stream::BufferOutputStream buffer;
+    {
+      /* cached encoding is self-contained - key references don't point outside of it */
+      Session session(&buffer);
+      SessionScope scope(serializer->m_needsSession ? &session : nullptr);
+      (*serializer->m_objectMethod)(serializer, &buffer, polymorph);
+    }
+    lookup.data = std::make_shared<std::string>((const char*) buffer.getData(), buffer.getCurrentPosition());
+    AllocationCounter::record(AllocationCounter::BUFFERS, buffer.getCapacity());
+    cache->store(serializer, polymorph.get(), lookup.version, lookup.data);
+  }
+
+  const auto& data = lookup.data;
+
+  if((v_buff_size) data->size() >= serializer->m_config->stringReferenceThreshold) {
+    auto segmentedStream = dynamic_cast<SegmentedOutputStream*>(stream);
+    if(segmentedStream) {
+      segmentedStream->writeReference(data, data->data(), data->size());
+      return;
+    }
+  }
+
+  stream->writeSimple(data->data(), data->size());
+
+}
+
+void Serializer::serializeVectorColumnar(Serializer* serializer,
+                                         ConsistentOutputStream* stream,
+                                         const oatpp::Void& polymorph)
+{
+
+  if(!polymorph) {
+    stream->writeCharSimple(Utils::TYPE_NULL);
+    return;
+  }
+
+  auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::Collection::PolymorphicDispatcher*>(
+    polymorph.getValueType()->polymorphicDispatcher
+  );
+
+  auto itemType = dispatcher->getItemType();
+  if(itemType->classId != oatpp::data::mapping::type::__class::AbstractObject::CLASS_ID) {
+    (*serializer->m_collectionMethod)(serializer, stream, polymorph);
+    return;
+  }
+
+  std::vector<oatpp::BaseObject*> rows;
+  rows.reserve(dispatcher->getCollectionSize(polymorph));
+  auto iterator = dispatcher->beginIteration(polymorph);
+  while (!iterator->finished()) {
+    const auto& value = iterator->get();
+    if(!value) {
+      (*serializer->m_collectionMethod)(serializer, stream, polymorph);
+      return;
+    }
+    rows.push_back(static_cast<oatpp::BaseObject*>(value.get()));
+    iterator->next();
+  }
+
+  auto info = serializer->getObjectInfo(itemType);
+
+  /* readers reject rows without columns */
+  if(rows.empty() || info->fields.empty()) {
+    (*serializer->m_collectionMethod)(serializer, stream, polymorph);
+    return;
+  }
+
+  stream->writeCharSimple(Utils::CONTROL_COLUMNS_BEGIN);
+  Utils::writeVarUInt(stream, rows.size());
+  Utils::writeVarUInt(stream, info->fields.size());
+
+  oatpp::data::stream::BufferOutputStream column;
+
+  for(auto const& field : info->fields) {
+
+    column.setCurrentPosition(0);
+    v_char8 columnType = serializer->serializeColumn(&column, field, rows);
+
+    if(column.getCurrentPosition() >= ((v_int64)1 << 31)) {
+      throw std::runtime_error("[oatpp::bob::Serializer::serializeVectorColumnar()]: Error. Column is too large.");
     }
 
+    stream->writeSimple(field.key, field.keySize);
+    stream->writeCharSimple(columnType);
+    Utils::writeInt32(stream, (v_int32) column.getCurrentPosition(), Utils::BO_TYPE::NETWORK);
+    stream->writeSimple(column.getData(), column.getCurrentPosition());
+
   }
 
   stream->writeCharSimple(Utils::CONTROL_SECTION_END);
+  AllocationCounter::record(AllocationCounter::BUFFERS, column.getCapacity());
+
+}
+
+v_char8 Serializer::serializeColumn(oatpp::data::stream::BufferOutputStream* column,
+                                    const ObjectField& field,
+                                    const std::vector<oatpp::BaseObject*>& rows)
+{
+
+  auto property = field.property;
+  const v_uint32 id = property->type->classId.id;
+
+  v_char8 columnType = Utils::COLUMN_VALUES;
+
+  if(property->info.typeSelector == nullptr && id < m_methods.size() && id < m_builtinMethods.size() &&
+     m_methods[id] != nullptr && m_methods[id] == m_builtinMethods[id])
+  {
+    if(id == oatpp::Int8::Class::CLASS_ID.id) columnType = Utils::TYPE_INT_1;
+    else if(id == oatpp::UInt8::Class::CLASS_ID.id) columnType = Utils::TYPE_UINT_1;
+    else if(id == oatpp::Int16::Class::CLASS_ID.id) columnType = Utils::TYPE_INT_2;
+    else if(id == oatpp::UInt16::Class::CLASS_ID.id) columnType = Utils::TYPE_UINT_2;
+    else if(id == oatpp::Int32::Class::CLASS_ID.id) columnType = Utils::TYPE_INT_4;
+    else if(id == oatpp::UInt32::Class::CLASS_ID.id) columnType = Utils::TYPE_UINT_4;
+    else if(id == oatpp::Int64::Class::CLASS_ID.id) columnType = Utils::TYPE_INT_8;
+    else if(id == oatpp::UInt64::Class::CLASS_ID.id) columnType = Utils::TYPE_UINT_8;
+    else if(id == oatpp::Float32::Class::CLASS_ID.id) columnType = Utils::TYPE_FLOAT_4;
+    else if(id == oatpp::Float64::Class::CLASS_ID.id) columnType = Utils::TYPE_FLOAT_8;
+    else if(id == oatpp::Boolean::Class::CLASS_ID.id) columnType = Utils::TYPE_BOOL_TRUE;
+    else if(id == oatpp::String::Class::CLASS_ID.id) columnType = Utils::TYPE_STRING_4;
+  }
+
+  if(columnType == Utils::COLUMN_VALUES) {
+    for(auto row : rows) {
+      serialize(column, getFieldValue(property, row));
+    }
+    return columnType;
+  }
+
+  /* null bitmap - bit is set for non-null values */
+
+  std::vector<oatpp::Void> values;
+  values.reserve(rows.size());
+  std::vector<v_char8> bitmap((rows.size() + 7) / 8, 0);
+  for(v_buff_size i = 0; i < (v_buff_size) rows.size(); i ++) {
+    auto value = property->get(rows[i]);
+    if(value) {
+      bitmap[i / 8] |= (v_char8) (1 << (i % 8));
+      values.push_back(value);
+    }
+  }
+  column->writeSimple(bitmap.data(), bitmap.size());
+
+  switch(columnType) {
+
+    case Utils::TYPE_INT_1:
+    case Utils::TYPE_UINT_1:
+      for(auto& v : values) Utils::writeInt8(column, *static_cast<v_int8*>(v.get()));
+      break;
+
+    case Utils::TYPE_INT_2:
+    case Utils::TYPE_UINT_2:
+      for(auto& v : values) Utils::writeInt16(column, *static_cast<v_int16*>(v.get()), Utils::BO_TYPE::NETWORK);
+      break;
+
+    case Utils::TYPE_INT_4:
+    case Utils::TYPE_UINT_4:
+      for(auto& v : values) Utils::writeInt32(column, *static_cast<v_int32*>(v.get()), Utils::BO_TYPE::NETWORK);
+      break;
+
+    case Utils::TYPE_INT_8:
+    case Utils::TYPE_UINT_8:
+      for(auto& v : values) Utils::writeInt64(column, *static_cast<v_int64*>(v.get()), Utils::BO_TYPE::NETWORK);
+      break;
+
+    case Utils::TYPE_FLOAT_4:
+      for(auto& v : values) Utils::writeFloat32(column, *static_cast<v_float32*>(v.get()), Utils::BO_TYPE::NETWORK);
+      break;
+
+    case Utils::TYPE_FLOAT_8:
+      for(auto& v : values) Utils::writeFloat64(column, *static_cast<v_float64*>(v.get()), Utils::BO_TYPE::NETWORK);
+      break;
+
+    case Utils::TYPE_BOOL_TRUE: {
+      std::vector<v_char8> bits((values.size() + 7) / 8, 0);
+      for(v_buff_size i = 0; i < (v_buff_size) values.size(); i ++) {
+        if(*static_cast<bool*>(values[i].get())) {
+          bits[i / 8] |= (v_char8) (1 << (i % 8));
+        }
+      }
+      column->writeSimple(bits.data(), bits.size());
+      break;
+    }
+
+    case Utils::TYPE_STRING_4: {
+      /* end offsets of the strings in the blob, then the blob */
+      v_int64 offset = 0;
+      Utils::writeInt32(column, 0, Utils::BO_TYPE::NETWORK);
+      for(auto& v : values) {
+        offset += static_cast<std::string*>(v.get())->size();
+        if(offset >= ((v_int64)1 << 32)) {
+          throw std::runtime_error("[oatpp::bob::Serializer::serializeColumn()]: Error. String column is too large.");
+        }
+        Utils::writeInt32(column, (v_int32) offset, Utils::BO_TYPE::NETWORK);
+      }
+      for(auto& v : values) {
+        auto str = static_cast<std::string*>(v.get());
+        column->writeSimple(str->data(), str->size());
+      }
+      break;
+    }
+
+    default:
+      break;
+
+  }
+
+  return columnType;
 
 }
 
 void Serializer::serialize(ConsistentOutputStream* stream,
                            const oatpp::Void& polymorph)
+{
+  if(m_statistics) {
+    serializeMeasured(stream, polymorph);
+  } else {
+    serializeValue(stream, polymorph);
+  }
+}
+
+void Serializer::serializeMeasured(ConsistentOutputStream* stream,
+                                   const oatpp::Void& polymorph)
+{
+
+  auto& last = t_statisticsStream;
+  if(last.stream != stream) {
+    auto counter = dynamic_cast<CountingOutputStream*>(stream);
+    last.stream = stream;
+    last.position = getPatchPositionGetter(stream);
+    last.sizePass = counter && counter->getTarget() == nullptr;
+  }
+
+  if(last.sizePass) {
+    serializeValue(stream, polymorph);
+    return;
+  }
+
+  const PositionGetter position = last.position;
+  const v_buff_size start = position ? position(stream) : 0;
+
+  v_int64 nanos = 0;
+  if(m_statistics->isMeasuringTime()) {
+    auto begin = std::chrono::steady_clock::now();
+    serializeValue(stream, polymorph);
+    nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+  } else {
+    serializeValue(stream, polymorph);
+  }
+
+  m_statistics->record(Statistics::SERIALIZE, polymorph.getValueType(), position ? position(stream) - start : 0, nanos);
+
+}
+
+void Serializer::serializeValue(ConsistentOutputStream* stream,
+                                const oatpp::Void& polymorph)
 {
   auto id = polymorph.getValueType()->classId.id;
   auto& method = m_methods[id];
@@ -392,14 +1150,356 @@ void Serializer::serialize(ConsistentOutputStream* stream,
   }
 }
 
+v_buff_size Serializer::serializeItemsParallel(ConsistentOutputStream* stream,
+                                               const oatpp::Void& collection,
+                                               bool includeNullElements,
+                                               std::vector<v_buff_size>* index)
+{
+
+  auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::Collection::PolymorphicDispatcher*>(
+    collection.getValueType()->polymorphicDispatcher
+  );
+
+  const v_buff_size collectionSize = dispatcher->getCollectionSize(collection);
+  const v_buff_size chunksCount = m_config->parallelThreads;
+  const v_buff_size chunkSize = (collectionSize + chunksCount - 1) / chunksCount;
+  const v_buff_size stride = m_config->arrayIndexStride;
+
+  struct ChunkResult {
+    v_buff_size count;
+    v_buff_size bytes;
+  };
+
+  /*
+   * Encode elements [chunk * chunkSize, (chunk + 1) * chunkSize) of the source collection with the chunk's own session -
+   * the output doesn't depend on whether chunks are encoded by workers or one after another.
+   * Each chunk iterates the source from the beginning - collections have no random access.
+   */
+  auto encodeChunk = [this, &collection, dispatcher, includeNullElements, index, stride, chunkSize, collectionSize]
+                     (v_buff_size chunk, ConsistentOutputStream* out, std::vector<v_buff_size>* chunkIndex) -> ChunkResult
+  {
+    Session session(out);
+    SessionScope scope(m_needsSession ? &session : nullptr);
+    const v_buff_size start = session.getPosition();
+    const v_buff_size first = chunk * chunkSize;
+    const v_buff_size end = std::min<v_buff_size>(first + chunkSize, collectionSize);
+
+    auto iterator = dispatcher->beginIteration(collection);
+    v_buff_size i = 0;
+    v_buff_size ordinal = 0; // number of elements written before the chunk - for the index stride
+    for(; i < first && !iterator->finished(); i ++) {
+      if(index && isElementWritten(iterator->get(), includeNullElements)) {
+        ordinal ++;
+      }
+      iterator->next();
+    }
+
+    ChunkResult result = {0, 0};
+    for(; i < end && !iterator->finished(); i ++) {
+      const auto& value = iterator->get();
+      if(isElementWritten(value, includeNullElements)) {
+        if(index && (ordinal + result.count) % stride == 0) {
+          chunkIndex->push_back(session.getPosition() - start);
+        }
+        serialize(session.stream, value);
+        result.count ++;
+      }
+      iterator->next();
+    }
+
+    result.bytes = session.getPosition() - start;
+    return result;
+  };
+
+  v_buff_size count = 0;
+  v_buff_size offset = 0;
+
+  auto counter = dynamic_cast<CountingOutputStream*>(stream);
+  if(counter && counter->getTarget() == nullptr) {
+    /* size pass of computeSize() - count the chunks on this thread, no buffers */
+    t_parallelWorker = true;
+    try {
+      for(v_buff_size chunk = 0; chunk < chunksCount; chunk ++) {
+        std::vector<v_buff_size> chunkIndex;
+        auto result = encodeChunk(chunk, stream, &chunkIndex);
+        if(index) {
+          for(auto position : chunkIndex) {
+            index->push_back(offset + position);
+          }
+        }
+        count += result.count;
+        offset += result.bytes;
+      }
+    } catch (...) {
+      t_parallelWorker = false;
+      throw;
+    }
+    t_parallelWorker = false;
+    return count;
+  }
+
+  std::vector<std::unique_ptr<oatpp::data::stream::BufferOutputStream>> buffers(chunksCount);
+  std::vector<ChunkResult> results(chunksCount);
+  std::vector<std::exception_ptr> errors(chunksCount);
+  std::vector<std::vector<v_buff_size>> chunkIndexes(chunksCount);
+
+  auto encodeBuffer = [&encodeChunk, &buffers, &results, &errors, &chunkIndexes](v_buff_size chunk) {
+    t_parallelWorker = true;
+    try {
+      buffers[chunk].reset(new oatpp::data::stream::BufferOutputStream());
+      results[chunk] = encodeChunk(chunk, buffers[chunk].get(), &chunkIndexes[chunk]);
+    } catch (...) {
+      errors[chunk] = std::current_exception();
+    }
+    t_parallelWorker = false;
+  };
+
+  std::vector<std::thread> threads;
+  v_buff_size started = 1;
+  try {
+    threads.reserve(chunksCount - 1);
+    for(; started < chunksCount; started ++) {
+      threads.emplace_back(encodeBuffer, started);
+    }
+  } catch (...) {
+    /* no more threads (ex.: std::system_error) - the remaining chunks are encoded on this thread */
+  }
+
+  encodeBuffer(0);
+  for(v_buff_size chunk = started; chunk < chunksCount; chunk ++) {
+    encodeBuffer(chunk);
+  }
+
+  for(auto& thread : threads) {
+    thread.join();
+  }
+
+  for(v_buff_size chunk = 0; chunk < chunksCount; chunk ++) {
+    if(errors[chunk]) {
+      std::rethrow_exception(errors[chunk]);
+    }
+  }
+
+  for(v_buff_size chunk = 0; chunk < chunksCount; chunk ++) {
+    if(index) {
+      for(auto position : chunkIndexes[chunk]) {
+        index->push_back(offset + position);
+      }
+    }
+    auto& buffer = buffers[chunk];
+    stream->writeSimple(buffer->getData(), buffer->getCurrentPosition());
+    offset += buffer->getCurrentPosition();
+    count += results[chunk].count;
+    AllocationCounter::record(AllocationCounter::BUFFERS, buffer->getCapacity());
+  }
+
+  return count;
+
+}
+
+v_uint32 Serializer::getEnumOrdinal(const Type* enumType, const oatpp::Void& interpretation) {
+
+  const EnumOrdinals* ordinals = m_enumOrdinals.get(enumType, [](const Type* type) {
+
+    auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::AbstractEnum::PolymorphicDispatcher*>(
+      type->polymorphicDispatcher
+    );
+
+    auto result = std::make_shared<EnumOrdinals>();
+    const auto& values = dispatcher->getInterpretedEnum();
+    for(v_uint32 i = 0; i < values.size(); i ++) {
+      auto anyHandle = static_cast<oatpp::data::mapping::type::AnyHandle*>(values[i].get());
+      oatpp::Void value(anyHandle->ptr, anyHandle->type);
+      v_int64 number;
+      if(value.getValueType() == oatpp::String::Class::getType()) {
+        result->strings[*static_cast<std::string*>(value.get())] = i;
+      } else if(readIntegral(value, number)) {
+        result->numbers[number] = i;
+      }
+    }
+    return result;
+
+  });
+
+  if(interpretation.getValueType() == oatpp::String::Class::getType()) {
+    auto it = ordinals->strings.find(*static_cast<std::string*>(interpretation.get()));
+    if(it != ordinals->strings.end()) {
+      return it->second;
+    }
+  } else {
+    v_int64 number;
+    if(readIntegral(interpretation, number)) {
+      auto it = ordinals->numbers.find(number);
+      if(it != ordinals->numbers.end()) {
+        return it->second;
+      }
+    }
+  }
+
+  throw std::runtime_error("[oatpp::bob::Serializer::getEnumOrdinal()]: Error. Can't find ordinal for Enum value.");
+
+}
+
+const Serializer::ObjectInfo* Serializer::getObjectInfo(const Type* objectType) {
+  return m_objectInfos.get(objectType, [this](const Type* type) {
+
+    auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::AbstractObject::PolymorphicDispatcher*>(
+      type->polymorphicDispatcher
+    );
+    const auto& properties = dispatcher->getProperties()->getList();
+
+    const FieldIds::Ids* ids = m_config->fieldIds ? m_config->fieldIds->get(type) : nullptr;
+
+    auto result = std::make_shared<ObjectInfo>();
+    result->hasIds = ids != nullptr;
+    std::vector<v_buff_size> offsets;
+    for(auto const& property : properties) {
+      offsets.push_back(result->keys.size());
+      result->keys.append(property->name);
+      result->keys.push_back(0);
+      result->keys.push_back(Utils::TYPE_NULL);
+    }
+
+    v_int32 index = 0;
+    for(auto const& property : properties) {
+
+      ObjectField field;
+      field.property = property;
+      field.key = result->keys.data() + offsets[index];
+      field.keySize = std::strlen(property->name) + 1;
+      field.id = ids ? ids->at(property->name) : 0;
+
+      /* built-in methods (except Enum) serialize `null` as a single null tag */
+      const v_uint32 id = property->type->classId.id;
+      field.nullTag = property->info.typeSelector == nullptr &&
+                      id < m_methods.size() && id < m_builtinMethods.size() &&
+                      m_methods[id] != nullptr && m_methods[id] == m_builtinMethods[id] &&
+                      property->type->classId != oatpp::data::mapping::type::__class::AbstractEnum::CLASS_ID;
+
+      result->fields.push_back(field);
+      index ++;
+
+    }
+
+    result->fingerprint = Utils::computeObjectFingerprint(type);
+
+    return result;
+
+  });
+}
+
+Serializer::Session::Session(ConsistentOutputStream* pStream)
+  : stream(pStream)
+  , positionBase(0)
+  , documentStart(0)
+{
+  /* use position of the known streams, wrap other streams in the CountingOutputStream */
+  if(dynamic_cast<oatpp::data::stream::BufferOutputStream*>(stream)) {
+    positionGetter = [](ConsistentOutputStream* s) {
+      return static_cast<oatpp::data::stream::BufferOutputStream*>(s)->getCurrentPosition();
+    };
+  } else if(dynamic_cast<FixedBufferOutputStream*>(stream)) {
+    positionGetter = [](ConsistentOutputStream* s) {
+      return static_cast<FixedBufferOutputStream*>(s)->getCurrentPosition();
+    };
+  } else if(dynamic_cast<SegmentedOutputStream*>(stream)) {
+    positionGetter = [](ConsistentOutputStream* s) {
+      return static_cast<SegmentedOutputStream*>(s)->getSize();
+    };
+  } else if(dynamic_cast<CountingOutputStream*>(stream)) {
+    positionGetter = [](ConsistentOutputStream* s) {
+      return static_cast<CountingOutputStream*>(s)->getSize();
+    };
+  } else {
+    counter.reset(new CountingOutputStream(stream));
+    stream = counter.get();
+    positionGetter = [](ConsistentOutputStream* s) {
+      return static_cast<CountingOutputStream*>(s)->getSize();
+    };
+  }
+}
+
+v_buff_size Serializer::Session::getPosition() {
+  return positionBase + positionGetter(stream);
+}
+
+void Serializer::Session::nextDocument() {
+  documentStart = getPosition();
+  if(!mapKeys.empty()) {
+    mapKeys.clear(); // the table is bounded by MAX_MAP_KEYS - don't let stale keys take the room
+  }
+  if(!schemas.empty()) {
+    schemas.clear();
+  }
+}
+
+Serializer::SessionScope::SessionScope(Session* session)
+  : m_previous(CURRENT_SESSION)
+{
+  CURRENT_SESSION = session;
+}
+
+Serializer::SessionScope::~SessionScope() {
+  CURRENT_SESSION = m_previous;
+}
+
 void Serializer::serializeToStream(ConsistentOutputStream* stream,
                                    const oatpp::Void& polymorph)
 {
-  serialize(stream, polymorph);
+  t_statisticsStream.stream = nullptr;
+  if(m_needsBackPatching && getPatchPositionGetter(stream) == nullptr) {
+    oatpp::data::stream::BufferOutputStream buffer;
+    serializeToStream(&buffer, polymorph);
+    stream->writeSimple(buffer.getData(), buffer.getCurrentPosition());
+    AllocationCounter::record(AllocationCounter::BUFFERS, buffer.getCapacity());
+    return;
+  }
+  if(m_needsSession) {
+    Session session(stream);
+    SessionScope scope(&session);
+    serialize(session.stream, polymorph);
+  } else {
+    serialize(stream, polymorph);
+  }
+}
+
+v_buff_size Serializer::computeSize(const oatpp::Void& polymorph) {
+  CountingOutputStream stream;
+  serializeToStream(&stream, polymorph);
+  return stream.getSize();
+}
+
+void Serializer::serializeManyToStream(ConsistentOutputStream* stream, const std::vector<oatpp::Void>& items) {
+  t_statisticsStream.stream = nullptr;
+  if(m_needsBackPatching && getPatchPositionGetter(stream) == nullptr) {
+    oatpp::data::stream::BufferOutputStream buffer;
+    serializeManyToStream(&buffer, items);
+    stream->writeSimple(buffer.getData(), buffer.getCurrentPosition());
+    AllocationCounter::record(AllocationCounter::BUFFERS, buffer.getCapacity());
+    return;
+  }
+  if(m_needsSession) {
+    Session session(stream);
+    SessionScope scope(&session);
+    for(auto& item : items) {
+      session.nextDocument();
+      serialize(session.stream, item);
+    }
+  } else {
+    for(auto& item : items) {
+      serialize(stream, item);
+    }
+  }
+}
+
+v_buff_size Serializer::computeSize(const std::vector<oatpp::Void>& items) {
+  CountingOutputStream stream;
+  serializeManyToStream(&stream, items);
+  return stream.getSize();
 }
 
 const std::shared_ptr<Serializer::Config>& Serializer::getConfig() {
-  return m_config;
+  return m_userConfig;
 }
 
 }}
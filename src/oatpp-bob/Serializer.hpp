@@ -27,13 +27,24 @@
 #define OATPP_BOB_SERIALIZER_HPP
 
 
+#include "./AllocationCounter.hpp"
+#include "./FieldIds.hpp"
+#include "./Statistics.hpp"
+#include "./SubtreeCache.hpp"
+#include "./TypeCache.hpp"
+
+#include "oatpp/core/data/stream/BufferStream.hpp"
 #include "oatpp/core/data/stream/Stream.hpp"
 #include "oatpp/core/Types.hpp"
 
+#include <unordered_map>
+#include <unordered_set>
+
 
 namespace oatpp { namespace bob {
 
 class Serializer {
+  friend class SerializerReadCallback;
 public:
   typedef oatpp::data::mapping::type::Type Type;
   typedef oatpp::data::mapping::type::BaseObject::Property Property;
@@ -44,6 +55,8 @@ public:
 public:
   /**
    * Serializer config.
+   * The serializer works with a copy of the config taken at construction -
+   * changes made to the config afterwards take effect after &l:Serializer::reloadConfig ();.
    */
   class Config : public oatpp::base::Countable {
   public:
@@ -86,6 +99,112 @@ public:
      */
     bool throwOnUnknownTypes = true;
 
+    /**
+     * Write enums as their ordinals (index of the entry in the enum declaration) instead of enum interpretations.
+     * Ordinal is written as unsigned integer of the minimal width - `uint1`, `uint2` or `uint4`.
+     */
+    bool enumsAsOrdinals = false;
+
+    /**
+     * Minimum size of a string payload to be written by reference (without copying)
+     * when serializing to &id:oatpp::bob::SegmentedOutputStream;.
+     */
+    v_buff_size stringReferenceThreshold = 512;
+
+    /**
+     * Number of threads used to serialize large collections (`Vector`, `List`, `UnorderedSet`).
+     * The collection is split into chunks, each chunk is encoded into its own buffer, and the buffers are written in order.
+     * The size pass of &l:Serializer::computeSize (); counts the chunks on the calling thread without buffers.
+     * `0` or `1` - collections are serialized on the calling thread.
+     */
+    v_int32 parallelThreads = 0;
+
+    /**
+     * Minimum number of elements in a collection to serialize it in parallel. See &l:Serializer::Config::parallelThreads;.
+     */
+    v_int64 parallelCollectionThreshold = 100000;
+
+    /**
+     * Cache of encoded objects. See &id:oatpp::bob::SubtreeCache;.
+     * `nullptr` - objects are always encoded.
+     */
+    std::shared_ptr<SubtreeCache> subtreeCache;
+
+    /**
+     * Numeric ids of DTO properties. See &id:oatpp::bob::FieldIds;.
+     * Objects of the registered types are written with the ids instead of the keys.
+     * `nullptr` - objects are always written with the keys.
+     */
+    std::shared_ptr<FieldIds> fieldIds;
+
+    /**
+     * Count serialized values by type. See &id:oatpp::bob::Statistics;.
+     * Bytes are counted for values written to buffers. The size computation pass of `writeToString` is not counted.
+     * `nullptr` - no statistics.
+     */
+    std::shared_ptr<Statistics> statistics;
+
+    /**
+     * Write repeated object and map keys as references to their previous occurrence in the document -
+     * `0xFF<varint distance>`, where distance is the number of bytes back to the referenced key. <br>
+     * References are relative, so any part of the document can be decoded on its own as long as it's read in place.
+     * Readers without support for key references can't read such documents.
+     */
+    bool useKeyTable = false;
+
+    /**
+     * Size of the per-document table of emitted strings. <br>
+     * When a string equal to the one in the table is serialized again, it's written as a reference to the previous occurrence -
+     * `'@'<varint distance>`, where distance is the number of bytes back to the referenced string.
+     * The table is direct-mapped by the string hash, so only the latest string per slot is remembered. <br>
+     * `0` - strings are not deduplicated.
+     */
+    v_int32 stringDedupTableSize = 0;
+
+    /**
+     * Write `Vector<Object<T>>` column-wise - field names once, then one column per field. <br>
+     * Numbers and booleans are packed into fixed-width arrays, strings are stored as an array of offsets plus a data blob,
+     * values of other types are written one after another. Vectors with `null` elements are written row-wise.
+     */
+    bool columnarObjectVectors = false;
+
+    /**
+     * Write maps, objects and arrays with their byte size and the number of elements -
+     * `'M'|'A'<4-byte size><4-byte count><body>')'`. Readers skip such containers without walking them. <br>
+     * Sizes are back-patched in place. Documents written to streams other than `BufferOutputStream` are buffered first.
+     */
+    bool sizedContainers = false;
+
+    /**
+     * Minimum number of elements in a collection to write it with the offset index -
+     * `'X'<4-byte size><4-byte count><4-byte stride><values>')'<4-byte offsets>`,
+     * where offsets are positions of every `stride`-th element relative to the beginning of the values. <br>
+     * Use &id:oatpp::bob::Deserializer::deserializeSlice; to read a range of elements without parsing the preceding ones.
+     * `0` - collections are not indexed.
+     */
+    v_int64 arrayIndexThreshold = 0;
+
+    /**
+     * Write offset of every N-th element to the array index. See &l:Serializer::Config::arrayIndexThreshold;.
+     */
+    v_int32 arrayIndexStride = 1;
+
+    /**
+     * Write objects without keys - `'P'<4-byte schema fingerprint><varint keys count><keys><values>')'`,
+     * where values of all properties (including `null`s) follow in the declaration order. <br>
+     * The fingerprint is computed from the property names and types (see &id:oatpp::bob::Utils::computeObjectFingerprint;).
+     * Readers with the same DTO read values by position. Readers with a different DTO fall back to keyed decoding -
+     * this needs the keys, see &l:Serializer::Config::embedObjectSchemas;. <br>
+     * Positional objects are never sized, and can't be read to `oatpp::Any`.
+     */
+    bool positionalObjects = false;
+
+    /**
+     * With &l:Serializer::Config::positionalObjects; - write keys of the type the first time it appears in the document.
+     * Other objects of the type in the document have no keys (`0` keys count).
+     */
+    bool embedObjectSchemas = false;
+
     /**
      * Enable type interpretations.
      */
@@ -102,11 +221,153 @@ public:
                                    ConsistentOutputStream*,
                                    const oatpp::Void&);
 
+private:
+
+  struct EnumOrdinals {
+    std::unordered_map<std::string, v_uint32> strings;
+    std::unordered_map<v_int64, v_uint32> numbers;
+  };
+
+  struct ObjectField {
+    Property* property;
+    const char* key; // "<name>\0" followed by the null tag.
+    v_buff_size keySize; // size of the key including '\0'.
+    bool nullTag; // `null` value is serialized as a single null tag - can be merged with the key.
+    v_uint32 id; // field id, see Config::fieldIds.
+  };
+
+  struct ObjectInfo {
+    std::string keys;
+    std::vector<ObjectField> fields;
+    v_uint32 fingerprint;
+    bool hasIds;
+  };
+
+  /*
+   * Per-document state of the serializer.
+   * Set for the current thread with SessionScope. Used only when the serializer writes to `stream`.
+   */
+  struct StringSlot {
+    v_buff_size position;
+    std::shared_ptr<std::string> value;
+  };
+
+  struct Session {
+
+    static constexpr v_buff_size MAX_MAP_KEYS = 4096;
+
+    Session(ConsistentOutputStream* pStream);
+
+    ConsistentOutputStream* stream;
+    v_buff_size (*positionGetter)(ConsistentOutputStream* stream);
+    v_buff_size positionBase;
+    v_buff_size documentStart; // entries remembered before this position belong to previous documents
+    std::unique_ptr<ConsistentOutputStream> counter;
+
+    std::unordered_map<const char*, v_buff_size> objectKeys; // keyed by ObjectField::key
+    std::unordered_map<std::string, v_buff_size> mapKeys;
+
+    std::vector<StringSlot> strings; // allocated on the first use
+
+    std::unordered_set<v_uint32> schemas; // fingerprints of the object schemas written to the document
+
+    v_buff_size getPosition();
+
+    /* start the next document of the batch - keeps allocated tables */
+    void nextDocument();
+
+  };
+
+  class SessionScope {
+  private:
+    Session* m_previous;
+  public:
+    SessionScope(Session* session);
+    ~SessionScope();
+  };
+
+  /*
+   * Which values are written - derived from the config by applyConfig().
+   * Shared by the serializer methods and SerializerReadCallback so that both follow the same rules.
+   */
+  struct Selection {
+    bool includeNullFields;
+    bool alwaysIncludeRequired;
+    bool includeNullElements;
+    bool keyTable;
+  };
+
+private:
+  static thread_local Session* CURRENT_SESSION;
+
 private:
   static void serializeKey(ConsistentOutputStream* stream, const char* data, v_buff_size size);
+  static void serializeOrdinal(ConsistentOutputStream* stream, v_uint32 ordinal);
+  static void writeObjectKey(ConsistentOutputStream* stream, const ObjectField& field, bool nullTag);
+  static void writeMapKey(ConsistentOutputStream* stream, const char* data, v_buff_size size);
+
+  static oatpp::Void getFieldValue(Property* property, oatpp::BaseObject* object) {
+    if(property->info.typeSelector && property->type == oatpp::Any::Class::getType()) {
+      const auto& any = property->get(object).cast<oatpp::Any>();
+      return any.retrieve(property->info.typeSelector->selectType(object));
+    }
+    return property->get(object);
+  }
+
+  static bool isFieldWritten(const ObjectField& field, const oatpp::Void& value, bool includeNullFields, bool alwaysIncludeRequired) {
+    return value || includeNullFields || (alwaysIncludeRequired && field.property->info.required);
+  }
+
+  static bool isElementWritten(const oatpp::Void& value, bool includeNullElements) {
+    return includeNullElements || value;
+  }
+
+  /* write the key of the field, merged with the null tag when possible. Returns `false` if the value is written too */
+  static bool writeFieldKey(ConsistentOutputStream* stream, const ObjectField& field, const oatpp::Void& value, bool keyTable) {
+    const bool nullTag = !value && field.nullTag;
+    if(keyTable) {
+      writeObjectKey(stream, field, nullTag);
+    } else {
+      stream->writeSimple(field.key, nullTag ? field.keySize + 1 : field.keySize);
+    }
+    return !nullTag;
+  }
+
+  static void writeEntryKey(ConsistentOutputStream* stream, const std::string* key, bool keyTable) {
+    if(keyTable) {
+      writeMapKey(stream, key->data(), key->size());
+    } else {
+      serializeKey(stream, key->data(), key->size());
+    }
+  }
+
+  typedef v_buff_size (*PositionGetter)(ConsistentOutputStream* stream);
+  static PositionGetter getPatchPositionGetter(ConsistentOutputStream* stream);
+  static v_buff_size getPatchPosition(ConsistentOutputStream* stream);
+  static v_buff_size beginSizedContainer(ConsistentOutputStream* stream, v_char8 tag);
+  static void endSizedContainer(ConsistentOutputStream* stream, v_buff_size start, v_buff_size count);
+private:
+
+  template<bool includeNullElements>
+  static void serializeCollectionImpl(Serializer* serializer, ConsistentOutputStream* stream, const oatpp::Void& polymorph);
+
+  template<bool includeNullElements, bool keyTable>
+  static void serializeMapImpl(Serializer* serializer, ConsistentOutputStream* stream, const oatpp::Void& polymorph);
+
+  template<bool includeNullFields, bool alwaysIncludeRequired, bool keyTable>
+  static void serializeObjectImpl(Serializer* serializer, ConsistentOutputStream* stream, const oatpp::Void& polymorph);
+
+  static void serializeObjectWithIds(Serializer* serializer, ConsistentOutputStream* stream, const oatpp::Void& polymorph);
+  static void serializeObjectCached(Serializer* serializer, ConsistentOutputStream* stream, const oatpp::Void& polymorph);
+
+  static void serializeObjectPositional(Serializer* serializer, ConsistentOutputStream* stream, const oatpp::Void& polymorph);
+
+  static void serializeVectorColumnar(Serializer* serializer, ConsistentOutputStream* stream, const oatpp::Void& polymorph);
+
 public:
 
   static void serializeString(Serializer* serializer, ConsistentOutputStream* stream, const oatpp::Void& polymorph);
+  static void serializeStringDedup(Serializer* serializer, ConsistentOutputStream* stream, const oatpp::Void& polymorph);
 
   static void serializeBool(Serializer* serializer, ConsistentOutputStream* stream, const oatpp::Void& polymorph);
   static void serializeInt1(Serializer* serializer, ConsistentOutputStream* stream, const oatpp::Void& polymorph);
@@ -130,9 +391,30 @@ public:
 
 private:
   void serialize(ConsistentOutputStream* stream, const oatpp::Void& polymorph);
+  void serializeValue(ConsistentOutputStream* stream, const oatpp::Void& polymorph);
+  void serializeMeasured(ConsistentOutputStream* stream, const oatpp::Void& polymorph);
+  v_buff_size serializeItemsParallel(ConsistentOutputStream* stream, const oatpp::Void& collection, bool includeNullElements,
+                                     std::vector<v_buff_size>* index);
+  v_uint32 getEnumOrdinal(const Type* enumType, const oatpp::Void& interpretation);
+  const ObjectInfo* getObjectInfo(const Type* objectType);
+  void applyConfig();
+  v_char8 serializeColumn(oatpp::data::stream::BufferOutputStream* column, const ObjectField& field, const std::vector<oatpp::BaseObject*>& rows);
 private:
-  std::shared_ptr<Config> m_config;
+  std::shared_ptr<Config> m_userConfig;
+  std::shared_ptr<const Config> m_config; // copy of m_userConfig taken by applyConfig()
+  Selection m_selection;
+  Statistics* m_statistics;
   std::vector<SerializerMethod> m_methods;
+  std::vector<SerializerMethod> m_builtinMethods;
+  SerializerMethod m_objectMethod;
+  SerializerMethod m_keyedObjectMethod;
+  SerializerMethod m_collectionMethod;
+  SerializerMethod m_mapMethod;
+  bool m_needsSession;
+  bool m_needsBackPatching;
+private:
+  TypeCache<EnumOrdinals> m_enumOrdinals;
+  TypeCache<ObjectInfo> m_objectInfos;
 public:
 
   Serializer(const std::shared_ptr<Config>& config = std::make_shared<Config>());
@@ -141,8 +423,43 @@ public:
 
   void serializeToStream(ConsistentOutputStream* stream, const oatpp::Void& polymorph);
 
+  /**
+   * Serialize values as concatenated documents. <br>
+   * Each document is self-contained (no references to the other documents), but per-document state
+   * (key and string tables, stream position tracking) is set up once for the whole batch.
+   * @param stream - stream to write to.
+   * @param items - values to serialize.
+   */
+  void serializeManyToStream(ConsistentOutputStream* stream, const std::vector<oatpp::Void>& items);
+
+  /**
+   * Compute the exact number of bytes the value will be serialized to.
+   * @param polymorph - value to serialize.
+   * @return - size in bytes.
+   */
+  v_buff_size computeSize(const oatpp::Void& polymorph);
+
+  /**
+   * Compute the exact number of bytes the values will be serialized to with &l:Serializer::serializeManyToStream ();.
+   * @param items - values to serialize.
+   * @return - size in bytes.
+   */
+  v_buff_size computeSize(const std::vector<oatpp::Void>& items);
+
+  /**
+   * Get the config the serializer was constructed with.
+   * Changes made to it take effect after &l:Serializer::reloadConfig ();.
+   * @return
+   */
   const std::shared_ptr<Config>& getConfig();
 
+  /**
+   * Apply changes made to the config returned by &l:Serializer::getConfig ();.
+   * Methods set with &l:Serializer::setSerializerMethod (); are kept. <br>
+   * *Note: not thread-safe - don't call it while the serializer is in use.*
+   */
+  void reloadConfig();
+
 };
 
 }}
@@ -0,0 +1,241 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "SerializerReadCallback.hpp"
+
+#include "./Utils.hpp"
+
+#include <cstring>
+
+namespace oatpp { namespace bob {
+
+SerializerReadCallback::SerializerReadCallback(const std::shared_ptr<Serializer>& serializer, const oatpp::Void& polymorph)
+  : m_serializer(serializer)
+  , m_selection(serializer->m_selection)
+  , m_root(polymorph)
+  , m_bufferReadPosition(0)
+  , m_session(&m_buffer)
+  , m_started(false)
+{}
+
+void SerializerReadCallback::writeValue(const oatpp::Void& polymorph) {
+
+  if(!polymorph) {
+    m_serializer->serialize(&m_buffer, polymorph); // null of the type with the custom method isn't necessarily the null tag
+    return;
+  }
+
+  auto type = polymorph.getValueType();
+  const v_uint32 id = type->classId.id;
+  auto serializer = m_serializer.get();
+
+  bool builtin = id < serializer->m_methods.size() && id < serializer->m_builtinMethods.size() &&
+                 serializer->m_methods[id] != nullptr && serializer->m_methods[id] == serializer->m_builtinMethods[id];
+
+  if(!builtin) {
+    serializer->serialize(&m_buffer, polymorph);
+    return;
+  }
+
+  if(type->classId == oatpp::data::mapping::type::__class::Any::CLASS_ID) {
+    auto anyHandle = static_cast<oatpp::data::mapping::type::AnyHandle*>(polymorph.get());
+    writeValue(oatpp::Void(anyHandle->ptr, anyHandle->type));
+    return;
+  }
+
+  if(serializer->m_needsBackPatching) {
+    /* container sizes and array indexes are back-patched - encode as a whole */
+    serializer->serialize(&m_buffer, polymorph);
+    return;
+  }
+
+  if(type->classId == oatpp::data::mapping::type::__class::AbstractVector::CLASS_ID && serializer->m_config->columnarObjectVectors &&
+     static_cast<const oatpp::data::mapping::type::__class::Collection::PolymorphicDispatcher*>(type->polymorphicDispatcher)
+       ->getItemType()->classId == oatpp::data::mapping::type::__class::AbstractObject::CLASS_ID)
+  {
+    /* columns are written with their sizes - encode as a whole */
+    serializer->serialize(&m_buffer, polymorph);
+    return;
+  }
+
+  if(type->classId == oatpp::data::mapping::type::__class::AbstractVector::CLASS_ID ||
+     type->classId == oatpp::data::mapping::type::__class::AbstractList::CLASS_ID ||
+     type->classId == oatpp::data::mapping::type::__class::AbstractUnorderedSet::CLASS_ID)
+  {
+    auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::Collection::PolymorphicDispatcher*>(
+      type->polymorphicDispatcher
+    );
+    m_buffer.writeCharSimple(Utils::CONTROL_ARRAY_BEGIN);
+    Frame frame;
+    frame.type = FRAME_COLLECTION;
+    frame.value = polymorph;
+    frame.collectionIterator = dispatcher->beginIteration(polymorph);
+    frame.objectInfo = nullptr;
+    frame.fieldIndex = 0;
+    m_stack.push_back(std::move(frame));
+    return;
+  }
+
+  if(type->classId == oatpp::data::mapping::type::__class::AbstractPairList::CLASS_ID ||
+     type->classId == oatpp::data::mapping::type::__class::AbstractUnorderedMap::CLASS_ID)
+  {
+    auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::Map::PolymorphicDispatcher*>(
+      type->polymorphicDispatcher
+    );
+    if(dispatcher->getKeyType()->classId != oatpp::String::Class::CLASS_ID){
+      throw std::runtime_error("[oatpp::bob::SerializerReadCallback::writeValue()]: Invalid map key. Key should be String");
+    }
+    m_buffer.writeCharSimple(Utils::CONTROL_MAP_BEGIN);
+    Frame frame;
+    frame.type = FRAME_MAP;
+    frame.value = polymorph;
+    frame.mapIterator = dispatcher->beginIteration(polymorph);
+    frame.objectInfo = nullptr;
+    frame.fieldIndex = 0;
+    m_stack.push_back(std::move(frame));
+    return;
+  }
+
+  if(type->classId == oatpp::data::mapping::type::__class::AbstractObject::CLASS_ID) {
+    const auto& cache = serializer->m_config->subtreeCache;
+    if(cache && cache->get(serializer, polymorph.get()).registered) {
+      serializer->serialize(&m_buffer, polymorph);
+      return;
+    }
+    auto info = serializer->getObjectInfo(type);
+    if(serializer->m_config->positionalObjects || (serializer->m_config->fieldIds && info->hasIds)) {
+      /* positional objects and objects with field ids have no keyed frame - encode as a whole */
+      serializer->serialize(&m_buffer, polymorph);
+      return;
+    }
+    m_buffer.writeCharSimple(Utils::CONTROL_MAP_BEGIN);
+    Frame frame;
+    frame.type = FRAME_OBJECT;
+    frame.value = polymorph;
+    frame.objectInfo = info;
+    frame.fieldIndex = 0;
+    m_stack.push_back(std::move(frame));
+    return;
+  }
+
+  serializer->serialize(&m_buffer, polymorph);
+
+}
+
+void SerializerReadCallback::writeNext() {
+
+  auto& frame = m_stack.back();
+
+  switch(frame.type) {
+
+    case FRAME_COLLECTION: {
+      auto& iterator = frame.collectionIterator;
+      while(!iterator->finished()) {
+        oatpp::Void value = iterator->get();
+        iterator->next();
+        if(Serializer::isElementWritten(value, m_selection.includeNullElements)) {
+          writeValue(value);
+          return;
+        }
+      }
+      break;
+    }
+
+    case FRAME_MAP: {
+      auto& iterator = frame.mapIterator;
+      while(!iterator->finished()) {
+        oatpp::Void value = iterator->getValue();
+        if(Serializer::isElementWritten(value, m_selection.includeNullElements)) {
+          const auto& untypedKey = iterator->getKey();
+          Serializer::writeEntryKey(&m_buffer, static_cast<std::string*>(untypedKey.get()), m_selection.keyTable);
+          iterator->next();
+          writeValue(value);
+          return;
+        }
+        iterator->next();
+      }
+      break;
+    }
+
+    case FRAME_OBJECT: {
+      auto object = static_cast<oatpp::BaseObject*>(frame.value.get());
+      const auto& fields = frame.objectInfo->fields;
+      while(frame.fieldIndex < fields.size()) {
+        const auto& field = fields[frame.fieldIndex ++];
+        oatpp::Void value = Serializer::getFieldValue(field.property, object);
+        if(Serializer::isFieldWritten(field, value, m_selection.includeNullFields, m_selection.alwaysIncludeRequired)) {
+          if(Serializer::writeFieldKey(&m_buffer, field, value, m_selection.keyTable)) {
+            writeValue(value);
+          }
+          return;
+        }
+      }
+      break;
+    }
+
+  }
+
+  m_buffer.writeCharSimple(Utils::CONTROL_SECTION_END);
+  m_stack.pop_back();
+
+}
+
+v_io_size SerializerReadCallback::read(void *buffer, v_buff_size count, async::Action& action) {
+
+  (void) action;
+
+  if(m_bufferReadPosition > 0) {
+    /* move unread data to the beginning of the buffer */
+    v_buff_size available = m_buffer.getCurrentPosition() - m_bufferReadPosition;
+    std::memmove(m_buffer.getData(), m_buffer.getData() + m_bufferReadPosition, available);
+    m_buffer.setCurrentPosition(available);
+    m_session.positionBase += m_bufferReadPosition;
+    m_bufferReadPosition = 0;
+  }
+
+  Serializer::SessionScope scope(m_serializer->m_needsSession ? &m_session : nullptr);
+
+  if(!m_started) {
+    m_started = true;
+    writeValue(m_root);
+    m_root = nullptr;
+  }
+
+  while(m_buffer.getCurrentPosition() < count && !m_stack.empty()) {
+    writeNext();
+  }
+
+  v_buff_size size = m_buffer.getCurrentPosition();
+  if(size > count) {
+    size = count;
+  }
+
+  std::memcpy(buffer, m_buffer.getData(), size);
+  m_bufferReadPosition = size;
+
+  return size;
+
+}
+
+}}
@@ -0,0 +1,97 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_BOB_SERIALIZERREADCALLBACK_HPP
+#define OATPP_BOB_SERIALIZERREADCALLBACK_HPP
+
+#include "./Serializer.hpp"
+
+#include "oatpp/core/data/stream/BufferStream.hpp"
+
+namespace oatpp { namespace bob {
+
+/**
+ * Pull-based serializer. <br>
+ * Encodes the value on demand - each call to `read` produces only as much of the encoding as was requested
+ * (plus at most one scalar value), so the memory used doesn't depend on the size of the document. <br>
+ * Objects, collections and maps handled by the built-in serializer methods are traversed incrementally,
+ * values with custom serializer methods are encoded as a whole. <br>
+ * With &id:oatpp::bob::Serializer::Config::sizedContainers; or &id:oatpp::bob::Serializer::Config::arrayIndexThreshold;
+ * enabled the root value is encoded as a whole - container sizes have to be known before the container is sent. <br>
+ * Can be used as a body of the streaming response - `oatpp::web::protocol::http::outgoing::StreamingBody` -
+ * with both the simple and the async APIs. Never returns `IOError::RETRY_*` - serialization doesn't block.
+ */
+class SerializerReadCallback : public oatpp::data::stream::ReadCallback {
+private:
+
+  enum FrameType : v_int32 {
+    FRAME_COLLECTION = 0,
+    FRAME_MAP = 1,
+    FRAME_OBJECT = 2
+  };
+
+  struct Frame {
+    FrameType type;
+    oatpp::Void value;
+    std::unique_ptr<oatpp::data::mapping::type::__class::Collection::Iterator> collectionIterator;
+    std::unique_ptr<oatpp::data::mapping::type::__class::Map::Iterator> mapIterator;
+    const Serializer::ObjectInfo* objectInfo;
+    v_uint32 fieldIndex;
+  };
+
+private:
+  void writeValue(const oatpp::Void& polymorph);
+  void writeNext();
+private:
+  std::shared_ptr<Serializer> m_serializer;
+  const Serializer::Selection m_selection;
+  oatpp::Void m_root;
+  std::vector<Frame> m_stack;
+  oatpp::data::stream::BufferOutputStream m_buffer;
+  v_buff_size m_bufferReadPosition;
+  Serializer::Session m_session;
+  bool m_started;
+public:
+
+  /**
+   * Constructor.
+   * @param serializer - &l:Serializer;.
+   * @param polymorph - value to serialize.
+   */
+  SerializerReadCallback(const std::shared_ptr<Serializer>& serializer, const oatpp::Void& polymorph);
+
+  /**
+   * Read next chunk of the encoding.
+   * @param buffer - buffer to read data to.
+   * @param count - size of the buffer.
+   * @param action - not used. Serialization never blocks.
+   * @return - actual number of bytes read. `0` - the encoding is complete.
+   */
+  v_io_size read(void *buffer, v_buff_size count, async::Action& action) override;
+
+};
+
+}}
+
+#endif // OATPP_BOB_SERIALIZERREADCALLBACK_HPP
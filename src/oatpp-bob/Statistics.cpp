@@ -0,0 +1,239 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "Statistics.hpp"
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+
+namespace oatpp { namespace bob {
+
+namespace {
+
+std::atomic<v_int64> STATISTICS_ID_COUNTER(0);
+
+/* guards thread registries against removal of shards by destroyed Statistics */
+std::mutex REGISTRY_LOCK;
+
+}
+
+/*
+ * Shards of the thread by Statistics id. Statistics are identified by id - not by address, which may be reused.
+ */
+struct Statistics::ThreadShards {
+
+  std::unordered_map<v_int64, std::shared_ptr<Shard>> shards;
+  v_int64 lastId = 0;
+  Shard* lastShard = nullptr;
+
+  ~ThreadShards() {
+    std::lock_guard<std::mutex> lock(REGISTRY_LOCK);
+    for(auto& entry : shards) {
+      entry.second->owner = nullptr;
+    }
+  }
+
+};
+
+Statistics::Shard::Shard()
+  : skippedFields(0)
+  , skippedBytes(0)
+  , owner(nullptr)
+{
+  for(v_int32 op = 0; op < 2; op ++) {
+    for(v_int32 i = 0; i < MAX_CLASSES; i ++) {
+      clear(classes[op][i]);
+    }
+    for(v_int32 i = 0; i < MAX_OBJECTS; i ++) {
+      clear(objects[i].counters[op]);
+    }
+    clear(otherObjects[op]);
+  }
+  for(v_int32 i = 0; i < MAX_CLASSES; i ++) {
+    classNames[i].store(nullptr, std::memory_order_relaxed);
+  }
+  for(v_int32 i = 0; i < MAX_OBJECTS; i ++) {
+    objects[i].type.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+Statistics::Statistics(bool measureTime)
+  : m_id(STATISTICS_ID_COUNTER.fetch_add(1) + 1)
+  , m_measureTime(measureTime)
+{}
+
+Statistics::~Statistics() {
+  /* remove shards from registries of the threads which are still running */
+  std::lock_guard<std::mutex> lock(REGISTRY_LOCK);
+  for(auto& shard : m_shards) {
+    if(shard->owner) {
+      shard->owner->shards.erase(m_id);
+    }
+  }
+}
+
+Statistics::Shard* Statistics::getShard() {
+
+  static thread_local ThreadShards THREAD_SHARDS;
+
+  /* lastId is never reset - ids are not reused, so the dangling lastShard of the destroyed statistics is never returned */
+  if(THREAD_SHARDS.lastId == m_id) {
+    return THREAD_SHARDS.lastShard;
+  }
+
+  std::lock_guard<std::mutex> registryLock(REGISTRY_LOCK);
+
+  auto& shard = THREAD_SHARDS.shards[m_id];
+  if(!shard) {
+    shard = std::make_shared<Shard>();
+    shard->owner = &THREAD_SHARDS;
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_shards.push_back(shard);
+  }
+
+  THREAD_SHARDS.lastId = m_id;
+  THREAD_SHARDS.lastShard = shard.get();
+  return shard.get();
+
+}
+
+void Statistics::recordObject(Shard* shard, Operation operation, const oatpp::data::mapping::type::Type* type, v_int64 bytes, v_int64 nanos) {
+
+  /* only the owning thread takes slots - lock-free linear probing */
+  v_uint64 hash = (v_uint64) reinterpret_cast<std::uintptr_t>(type) * 11400714819323198485ull;
+  v_int32 index = (v_int32) (hash >> 56) & (MAX_OBJECTS - 1);
+
+  for(v_int32 i = 0; i < MAX_OBJECTS; i ++) {
+    auto& slot = shard->objects[index];
+    auto slotType = slot.type.load(std::memory_order_relaxed);
+    if(slotType == type) {
+      add(slot.counters[operation], bytes, nanos);
+      return;
+    }
+    if(slotType == nullptr) {
+      slot.type.store(type, std::memory_order_release);
+      add(slot.counters[operation], bytes, nanos);
+      return;
+    }
+    index = (index + 1) & (MAX_OBJECTS - 1);
+  }
+
+  add(shard->otherObjects[operation], bytes, nanos);
+
+}
+
+void Statistics::record(Operation operation, const oatpp::data::mapping::type::Type* type, v_int64 bytes, v_int64 nanos) {
+
+  Shard* shard = getShard();
+
+  v_uint32 id = type->classId.id;
+  if(id >= MAX_CLASSES) {
+    id = MAX_CLASSES - 1;
+  }
+
+  auto& counters = shard->classes[operation][id];
+  if(counters.values.load(std::memory_order_relaxed) == 0) {
+    shard->classNames[id].store(id == MAX_CLASSES - 1 ? "other" : type->classId.name, std::memory_order_relaxed);
+  }
+  add(counters, bytes, nanos);
+
+  if(type->classId == oatpp::data::mapping::type::__class::AbstractObject::CLASS_ID) {
+    recordObject(shard, operation, type, bytes, nanos);
+  }
+
+}
+
+void Statistics::recordSkipped(v_int64 bytes) {
+  Shard* shard = getShard();
+  add(shard->skippedFields, 1);
+  add(shard->skippedBytes, bytes);
+}
+
+Statistics::Snapshot Statistics::getSnapshot() const {
+
+  Snapshot result;
+  result.skippedFields = 0;
+  result.skippedBytes = 0;
+
+  std::lock_guard<std::mutex> lock(m_lock);
+
+  std::vector<TypeCounters>* classesResult[2] = {&result.serialized, &result.deserialized};
+  std::vector<TypeCounters>* objectsResult[2] = {&result.serializedObjects, &result.deserializedObjects};
+
+  for(v_int32 op = 0; op < 2; op ++) {
+
+    for(v_int32 i = 0; i < MAX_CLASSES; i ++) {
+      TypeCounters counters = {"", 0, 0, 0};
+      for(auto const& shard : m_shards) {
+        const auto& c = shard->classes[op][i];
+        counters.values += c.values.load(std::memory_order_relaxed);
+        counters.bytes += c.bytes.load(std::memory_order_relaxed);
+        counters.nanos += c.nanos.load(std::memory_order_relaxed);
+        const char* name = shard->classNames[i].load(std::memory_order_relaxed);
+        if(name && counters.name.empty()) {
+          counters.name = name;
+        }
+      }
+      if(counters.values > 0) {
+        classesResult[op]->push_back(counters);
+      }
+    }
+
+    std::map<std::string, TypeCounters> objects;
+    auto addObjectCounters = [&objects](const std::string& name, const Counters& c) {
+      auto& counters = objects[name];
+      counters.name = name;
+      counters.values += c.values.load(std::memory_order_relaxed);
+      counters.bytes += c.bytes.load(std::memory_order_relaxed);
+      counters.nanos += c.nanos.load(std::memory_order_relaxed);
+    };
+    for(auto const& shard : m_shards) {
+      for(v_int32 i = 0; i < MAX_OBJECTS; i ++) {
+        auto type = shard->objects[i].type.load(std::memory_order_acquire);
+        if(type) {
+          const char* qualifier = type->nameQualifier;
+          addObjectCounters(qualifier ? qualifier : type->classId.name, shard->objects[i].counters[op]);
+        }
+      }
+      addObjectCounters("other", shard->otherObjects[op]);
+    }
+    for(auto const& entry : objects) {
+      if(entry.second.values > 0) {
+        objectsResult[op]->push_back(entry.second);
+      }
+    }
+
+  }
+
+  for(auto const& shard : m_shards) {
+    result.skippedFields += shard->skippedFields.load(std::memory_order_relaxed);
+    result.skippedBytes += shard->skippedBytes.load(std::memory_order_relaxed);
+  }
+
+  return result;
+
+}
+
+}}
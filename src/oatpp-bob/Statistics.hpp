@@ -0,0 +1,244 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_BOB_STATISTICS_HPP
+#define OATPP_BOB_STATISTICS_HPP
+
+#include "oatpp/core/Types.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace oatpp { namespace bob {
+
+/**
+ * Mapping statistics - number of values, bytes and time by type. <br>
+ * Set the same object to &id:oatpp::bob::Serializer::Config::statistics; and/or &id:oatpp::bob::Deserializer::Config::statistics;.
+ * Values are counted by `classId` and, for DTOs, by the DTO type. Bytes and time of a value include its nested values. <br>
+ * Each thread writes to its own set of counters - no locks or atomic read-modify-write on the hot path,
+ * only the first value counted by the thread takes a lock.
+ * Counters are monotonic - use the difference of two snapshots to get the rate.
+ */
+class Statistics {
+public:
+
+  /**
+   * Max number of classIds counted separately. Values of classes with greater ids are counted in the last slot.
+   */
+  static constexpr v_int32 MAX_CLASSES = 128;
+
+  /**
+   * Max number of DTO types counted separately by each thread. Further DTO types are counted as `"other"`.
+   */
+  static constexpr v_int32 MAX_OBJECTS = 256;
+
+  /**
+   * Counted operation.
+   */
+  enum Operation : v_int32 {
+
+    /**
+     * Value is serialized.
+     */
+    SERIALIZE = 0,
+
+    /**
+     * Value is deserialized.
+     */
+    DESERIALIZE = 1
+
+  };
+
+  /**
+   * Counters of the type.
+   */
+  struct TypeCounters {
+
+    /**
+     * Name of the class (`classId.name`) or of the DTO.
+     */
+    std::string name;
+
+    /**
+     * Number of values.
+     */
+    v_int64 values;
+
+    /**
+     * Number of bytes. `0` for values serialized to streams without the position (only buffers are measured).
+     */
+    v_int64 bytes;
+
+    /**
+     * Time in nanoseconds. `0` if time is not measured.
+     */
+    v_int64 nanos;
+
+  };
+
+  /**
+   * Snapshot of the statistics.
+   */
+  struct Snapshot {
+
+    /**
+     * Serialized values by classId.
+     */
+    std::vector<TypeCounters> serialized;
+
+    /**
+     * Deserialized values by classId.
+     */
+    std::vector<TypeCounters> deserialized;
+
+    /**
+     * Serialized DTOs by DTO type.
+     */
+    std::vector<TypeCounters> serializedObjects;
+
+    /**
+     * Deserialized DTOs by DTO type.
+     */
+    std::vector<TypeCounters> deserializedObjects;
+
+    /**
+     * Number of unknown fields skipped by the deserializer.
+     */
+    v_int64 skippedFields;
+
+    /**
+     * Bytes of unknown fields skipped by the deserializer.
+     */
+    v_int64 skippedBytes;
+
+  };
+
+private:
+
+  struct Counters {
+    std::atomic<v_int64> values;
+    std::atomic<v_int64> bytes;
+    std::atomic<v_int64> nanos;
+  };
+
+  /*
+   * Counters of a DTO type. The slot is taken by the owning thread - `type` is published with release store,
+   * so the snapshot never sees a slot half-taken.
+   */
+  struct ObjectSlot {
+    std::atomic<const oatpp::data::mapping::type::Type*> type;
+    Counters counters[2];
+  };
+
+  struct ThreadShards;
+
+  /*
+   * Counters of one thread. Written only by the owning thread.
+   * Atomics are accessed with relaxed loads and stores - they only make concurrent snapshots well-defined.
+   */
+  struct Shard {
+    Counters classes[2][MAX_CLASSES];
+    std::atomic<const char*> classNames[MAX_CLASSES];
+    ObjectSlot objects[MAX_OBJECTS]; // open addressing by type pointer
+    Counters otherObjects[2];
+    std::atomic<v_int64> skippedFields;
+    std::atomic<v_int64> skippedBytes;
+    ThreadShards* owner; // shards of the owning thread, nullptr once the thread has exited. Guarded by the registry lock.
+    Shard();
+  };
+
+private:
+  static void add(std::atomic<v_int64>& counter, v_int64 value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+  }
+  static void clear(Counters& counters) {
+    counters.values.store(0, std::memory_order_relaxed);
+    counters.bytes.store(0, std::memory_order_relaxed);
+    counters.nanos.store(0, std::memory_order_relaxed);
+  }
+  static void add(Counters& counters, v_int64 bytes, v_int64 nanos) {
+    add(counters.values, 1);
+    add(counters.bytes, bytes);
+    add(counters.nanos, nanos);
+  }
+private:
+  const v_int64 m_id;
+  const bool m_measureTime;
+  mutable std::mutex m_lock;
+  std::vector<std::shared_ptr<Shard>> m_shards;
+private:
+  Shard* getShard();
+  void recordObject(Shard* shard, Operation operation, const oatpp::data::mapping::type::Type* type, v_int64 bytes, v_int64 nanos);
+public:
+
+  /**
+   * Constructor.
+   * @param measureTime - measure time of values. Two clock reads per value.
+   */
+  Statistics(bool measureTime = true);
+
+  /**
+   * Non-virtual destructor. Releases counters of all threads.
+   */
+  ~Statistics();
+
+  Statistics(const Statistics&) = delete;
+  Statistics& operator=(const Statistics&) = delete;
+
+  /**
+   * Check if time of values is measured.
+   * @return
+   */
+  bool isMeasuringTime() const {
+    return m_measureTime;
+  }
+
+  /**
+   * Count value. Called by the serializer and the deserializer.
+   * @param operation - &l:Statistics::Operation;.
+   * @param type - type of the value.
+   * @param bytes - number of bytes of the value.
+   * @param nanos - time of the operation.
+   */
+  void record(Operation operation, const oatpp::data::mapping::type::Type* type, v_int64 bytes, v_int64 nanos);
+
+  /**
+   * Count skipped unknown field. Called by the deserializer.
+   * @param bytes - size of the skipped value.
+   */
+  void recordSkipped(v_int64 bytes);
+
+  /**
+   * Get snapshot of the counters summed over all threads. Only types with non-zero counters are listed.
+   * @return - &l:Statistics::Snapshot;.
+   */
+  Snapshot getSnapshot() const;
+
+};
+
+}}
+
+#endif // OATPP_BOB_STATISTICS_HPP
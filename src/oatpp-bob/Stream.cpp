@@ -0,0 +1,429 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "Stream.hpp"
+
+#include "./Utils.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+#if !defined(WIN32) && !defined(_WIN32)
+  #include <sys/socket.h>
+  #include <sys/uio.h>
+  #include <errno.h>
+#endif
+
+namespace oatpp { namespace bob {
+
+namespace {
+
+v_buff_size checkBlockSize(v_buff_size blockSize) {
+  if(blockSize <= 0 || blockSize > Codec::MAX_BLOCK_SIZE) {
+    throw std::invalid_argument("[oatpp::bob::CompressingOutputStream::CompressingOutputStream()]: Error. "
+                                "blockSize must be in range (0, Codec::MAX_BLOCK_SIZE].");
+  }
+  return blockSize;
+}
+
+}
+
+oatpp::data::stream::DefaultInitializedContext CountingOutputStream::DEFAULT_CONTEXT(oatpp::data::stream::StreamType::STREAM_INFINITE);
+
+CountingOutputStream::CountingOutputStream(oatpp::data::stream::ConsistentOutputStream* target)
+  : m_target(target)
+  , m_size(0)
+  , m_ioMode(oatpp::data::stream::IOMode::ASYNCHRONOUS)
+{}
+
+v_io_size CountingOutputStream::write(const void *data, v_buff_size count, async::Action& action) {
+  (void) action;
+  if(m_target) {
+    m_target->writeSimple(data, count);
+  }
+  m_size += count;
+  return count;
+}
+
+void CountingOutputStream::setOutputStreamIOMode(oatpp::data::stream::IOMode ioMode) {
+  m_ioMode = ioMode;
+}
+
+oatpp::data::stream::IOMode CountingOutputStream::getOutputStreamIOMode() {
+  return m_ioMode;
+}
+
+oatpp::data::stream::Context& CountingOutputStream::getOutputStreamContext() {
+  return DEFAULT_CONTEXT;
+}
+
+v_buff_size CountingOutputStream::getSize() const {
+  return m_size;
+}
+
+oatpp::data::stream::ConsistentOutputStream* CountingOutputStream::getTarget() const {
+  return m_target;
+}
+
+oatpp::data::stream::DefaultInitializedContext FixedBufferOutputStream::DEFAULT_CONTEXT(oatpp::data::stream::StreamType::STREAM_FINITE);
+
+FixedBufferOutputStream::FixedBufferOutputStream(void* data, v_buff_size capacity)
+  : m_data((p_char8) data)
+  , m_capacity(capacity)
+  , m_position(0)
+  , m_overflow(false)
+  , m_ioMode(oatpp::data::stream::IOMode::ASYNCHRONOUS)
+{}
+
+v_io_size FixedBufferOutputStream::write(const void *data, v_buff_size count, async::Action& action) {
+  (void) action;
+  if(count > m_capacity - m_position) {
+    m_overflow = true;
+    throw std::runtime_error("[oatpp::bob::FixedBufferOutputStream::write()]: Error. Buffer overflow.");
+  }
+  std::memcpy(m_data + m_position, data, count);
+  m_position += count;
+  return count;
+}
+
+void FixedBufferOutputStream::setOutputStreamIOMode(oatpp::data::stream::IOMode ioMode) {
+  m_ioMode = ioMode;
+}
+
+oatpp::data::stream::IOMode FixedBufferOutputStream::getOutputStreamIOMode() {
+  return m_ioMode;
+}
+
+oatpp::data::stream::Context& FixedBufferOutputStream::getOutputStreamContext() {
+  return DEFAULT_CONTEXT;
+}
+
+v_buff_size FixedBufferOutputStream::getCurrentPosition() const {
+  return m_position;
+}
+
+p_char8 FixedBufferOutputStream::getData() const {
+  return m_data;
+}
+
+bool FixedBufferOutputStream::isOverflown() const {
+  return m_overflow;
+}
+
+oatpp::data::stream::DefaultInitializedContext SegmentedOutputStream::DEFAULT_CONTEXT(oatpp::data::stream::StreamType::STREAM_INFINITE);
+
+SegmentedOutputStream::SegmentedOutputStream(v_buff_size chunkSize)
+  : m_chunkSize(chunkSize)
+  , m_size(0)
+  , m_inlineSegmentOpen(false)
+  , m_flushSegment(0)
+  , m_flushOffset(0)
+  , m_ioMode(oatpp::data::stream::IOMode::ASYNCHRONOUS)
+{}
+
+SegmentedOutputStream::Chunk& SegmentedOutputStream::getChunk(v_buff_size minCapacity) {
+  if(m_chunks.empty() || m_chunks.back().capacity - m_chunks.back().position < minCapacity) {
+    Chunk chunk;
+    chunk.capacity = minCapacity > m_chunkSize ? minCapacity : m_chunkSize;
+    chunk.data.reset(new v_char8[chunk.capacity]);
+    chunk.position = 0;
+    m_chunks.push_back(std::move(chunk));
+    m_inlineSegmentOpen = false;
+  }
+  return m_chunks.back();
+}
+
+v_io_size SegmentedOutputStream::write(const void *data, v_buff_size count, async::Action& action) {
+
+  (void) action;
+
+  if(count <= 0) {
+    return 0;
+  }
+
+  v_buff_size progress = 0;
+  while(progress < count) {
+
+    auto& chunk = getChunk(1);
+    v_buff_size size = chunk.capacity - chunk.position;
+    if(size > count - progress) {
+      size = count - progress;
+    }
+
+    p_char8 dst = chunk.data.get() + chunk.position;
+    std::memcpy(dst, (const char*) data + progress, size);
+    chunk.position += size;
+
+    if(m_inlineSegmentOpen) {
+      m_segments.back().size += size;
+    } else {
+      m_segments.push_back({dst, size});
+      m_inlineSegmentOpen = true;
+    }
+
+    progress += size;
+
+  }
+
+  m_size += count;
+  return count;
+
+}
+
+void SegmentedOutputStream::setOutputStreamIOMode(oatpp::data::stream::IOMode ioMode) {
+  m_ioMode = ioMode;
+}
+
+oatpp::data::stream::IOMode SegmentedOutputStream::getOutputStreamIOMode() {
+  return m_ioMode;
+}
+
+oatpp::data::stream::Context& SegmentedOutputStream::getOutputStreamContext() {
+  return DEFAULT_CONTEXT;
+}
+
+void SegmentedOutputStream::writeReference(const std::shared_ptr<void>& capture, const void* data, v_buff_size size) {
+  if(size <= 0) {
+    return;
+  }
+  m_captures.push_back(capture);
+  m_segments.push_back({data, size});
+  m_inlineSegmentOpen = false;
+  m_size += size;
+}
+
+const std::vector<SegmentedOutputStream::Segment>& SegmentedOutputStream::getSegments() const {
+  return m_segments;
+}
+
+v_buff_size SegmentedOutputStream::getSize() const {
+  return m_size;
+}
+
+oatpp::String SegmentedOutputStream::toString() const {
+  oatpp::String result(m_size);
+  p_char8 data = (p_char8) result->data();
+  for(const auto& segment : m_segments) {
+    std::memcpy(data, segment.data, segment.size);
+    data += segment.size;
+  }
+  return result;
+}
+
+v_io_size SegmentedOutputStream::flushToStream(oatpp::data::stream::OutputStream* stream) const {
+  v_io_size result = 0;
+  for(const auto& segment : m_segments) {
+    auto res = stream->writeExactSizeDataSimple(segment.data, segment.size);
+    if(res != segment.size) {
+      return res < 0 ? res : result + res;
+    }
+    result += res;
+  }
+  return result;
+}
+
+#if !defined(WIN32) && !defined(_WIN32)
+
+v_io_size SegmentedOutputStream::flushToFileDescriptor(int fd) {
+
+  static constexpr v_int32 MAX_VECTORS = 64;
+  struct iovec vectors[MAX_VECTORS];
+
+  v_io_size result = 0;
+
+#ifdef MSG_NOSIGNAL
+  bool socket = true; // sendmsg() with MSG_NOSIGNAL - writing to the closed socket doesn't raise SIGPIPE
+#endif
+
+  while(m_flushSegment < m_segments.size()) {
+
+    v_int32 count = 0;
+    for(size_t i = m_flushSegment; i < m_segments.size() && count < MAX_VECTORS; i ++) {
+      const auto& segment = m_segments[i];
+      v_buff_size offset = (i == m_flushSegment) ? m_flushOffset : 0;
+      vectors[count].iov_base = (char*) segment.data + offset;
+      vectors[count].iov_len = segment.size - offset;
+      count ++;
+    }
+
+    ssize_t res;
+
+#ifdef MSG_NOSIGNAL
+    if(socket) {
+      struct msghdr message;
+      std::memset(&message, 0, sizeof(message));
+      message.msg_iov = vectors;
+      message.msg_iovlen = count;
+      res = ::sendmsg(fd, &message, MSG_NOSIGNAL);
+      if(res < 0 && errno == ENOTSOCK) {
+        socket = false;
+        continue;
+      }
+    } else {
+      res = ::writev(fd, vectors, count);
+    }
+#else
+    res = ::writev(fd, vectors, count);
+#endif
+
+    if(res < 0) {
+      if(errno == EINTR) {
+        continue;
+      }
+      if(result > 0) {
+        return result;
+      }
+      if(errno == EAGAIN || errno == EWOULDBLOCK) {
+        return oatpp::IOError::RETRY_WRITE;
+      }
+      return oatpp::IOError::BROKEN_PIPE;
+    }
+
+    result += res;
+
+    while(res > 0) {
+      v_buff_size left = m_segments[m_flushSegment].size - m_flushOffset;
+      if(res >= left) {
+        res -= left;
+        m_flushSegment ++;
+        m_flushOffset = 0;
+      } else {
+        m_flushOffset += res;
+        res = 0;
+      }
+    }
+
+  }
+
+  return result;
+
+}
+
+#endif
+
+void SegmentedOutputStream::reset() {
+  m_chunks.clear();
+  m_segments.clear();
+  m_captures.clear();
+  m_size = 0;
+  m_inlineSegmentOpen = false;
+  m_flushSegment = 0;
+  m_flushOffset = 0;
+}
+
+oatpp::data::stream::DefaultInitializedContext CompressingOutputStream::DEFAULT_CONTEXT(oatpp::data::stream::StreamType::STREAM_INFINITE);
+
+CompressingOutputStream::CompressingOutputStream(oatpp::data::stream::ConsistentOutputStream* target,
+                                                 const std::shared_ptr<Codec>& codec,
+                                                 v_buff_size blockSize)
+  : m_target(target)
+  , m_codec(codec)
+  , m_block(new v_char8[checkBlockSize(blockSize)])
+  , m_compressed(new v_char8[codec->getMaxCompressedSize(blockSize)])
+  , m_blockSize(blockSize)
+  , m_position(0)
+  , m_headerWritten(false)
+  , m_finished(false)
+  , m_ioMode(oatpp::data::stream::IOMode::ASYNCHRONOUS)
+{}
+
+void CompressingOutputStream::writeHeader() {
+  v_char8 header[2] = {Codec::FRAME_BEGIN, m_codec->getId()};
+  m_target->writeSimple(header, 2);
+  m_headerWritten = true;
+}
+
+void CompressingOutputStream::flushBlock() {
+
+  if(!m_headerWritten) {
+    writeHeader();
+  }
+
+  if(m_position == 0) {
+    return;
+  }
+
+  auto size = m_codec->compress(m_block.get(), m_position, m_compressed.get(), m_codec->getMaxCompressedSize(m_blockSize));
+
+  Utils::writeVarUInt(m_target, m_position);
+  if(size > 0 && size < m_position) {
+    Utils::writeVarUInt(m_target, size);
+    m_target->writeSimple(m_compressed.get(), size);
+  } else {
+    Utils::writeVarUInt(m_target, m_position);
+    m_target->writeSimple(m_block.get(), m_position);
+  }
+
+  m_position = 0;
+
+}
+
+v_io_size CompressingOutputStream::write(const void *data, v_buff_size count, async::Action& action) {
+
+  (void) action;
+
+  if(m_finished) {
+    throw std::runtime_error("[oatpp::bob::CompressingOutputStream::write()]: Error. The frame is already finished.");
+  }
+
+  v_buff_size progress = 0;
+  while(progress < count) {
+    v_buff_size size = m_blockSize - m_position;
+    if(size > count - progress) {
+      size = count - progress;
+    }
+    std::memcpy(m_block.get() + m_position, (const char*) data + progress, size);
+    m_position += size;
+    progress += size;
+    if(m_position == m_blockSize) {
+      flushBlock();
+    }
+  }
+
+  return count;
+
+}
+
+void CompressingOutputStream::setOutputStreamIOMode(oatpp::data::stream::IOMode ioMode) {
+  m_ioMode = ioMode;
+}
+
+oatpp::data::stream::IOMode CompressingOutputStream::getOutputStreamIOMode() {
+  return m_ioMode;
+}
+
+oatpp::data::stream::Context& CompressingOutputStream::getOutputStreamContext() {
+  return DEFAULT_CONTEXT;
+}
+
+void CompressingOutputStream::finish() {
+  if(m_finished) {
+    return;
+  }
+  flushBlock();
+  Utils::writeVarUInt(m_target, 0);
+  m_finished = true;
+}
+
+}}
@@ -0,0 +1,321 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_BOB_STREAM_HPP
+#define OATPP_BOB_STREAM_HPP
+
+#include "./Codec.hpp"
+
+#include "oatpp/core/data/stream/Stream.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace oatpp { namespace bob {
+
+/**
+ * Output stream which counts bytes written and either discards them or forwards them to the target stream.
+ * Used to compute the exact size of serialized data, and to track the write position on streams which don't expose it.
+ */
+class CountingOutputStream : public oatpp::data::stream::ConsistentOutputStream {
+public:
+  static oatpp::data::stream::DefaultInitializedContext DEFAULT_CONTEXT;
+private:
+  oatpp::data::stream::ConsistentOutputStream* m_target;
+  v_buff_size m_size;
+  oatpp::data::stream::IOMode m_ioMode;
+public:
+
+  /**
+   * Constructor.
+   * @param target - stream to forward data to. `nullptr` - discard data.
+   */
+  CountingOutputStream(oatpp::data::stream::ConsistentOutputStream* target = nullptr);
+
+  /**
+   * Count bytes and forward them to the target stream (if any).
+   * @param data - data to write.
+   * @param count - number of bytes.
+   * @param action - ignored.
+   * @return - `count`.
+   */
+  v_io_size write(const void *data, v_buff_size count, async::Action& action) override;
+
+  void setOutputStreamIOMode(oatpp::data::stream::IOMode ioMode) override;
+
+  oatpp::data::stream::IOMode getOutputStreamIOMode() override;
+
+  oatpp::data::stream::Context& getOutputStreamContext() override;
+
+  /**
+   * Get number of bytes written so far.
+   * @return
+   */
+  v_buff_size getSize() const;
+
+  /**
+   * Get the target stream.
+   * @return - target stream or `nullptr` if data is discarded.
+   */
+  oatpp::data::stream::ConsistentOutputStream* getTarget() const;
+
+};
+
+/**
+ * Output stream over a preallocated buffer of fixed size.
+ * Throws `std::runtime_error` on attempt to write past the end of the buffer.
+ */
+class FixedBufferOutputStream : public oatpp::data::stream::ConsistentOutputStream {
+public:
+  static oatpp::data::stream::DefaultInitializedContext DEFAULT_CONTEXT;
+private:
+  p_char8 m_data;
+  v_buff_size m_capacity;
+  v_buff_size m_position;
+  bool m_overflow;
+  oatpp::data::stream::IOMode m_ioMode;
+public:
+
+  /**
+   * Constructor.
+   * @param data - buffer to write to.
+   * @param capacity - size of the buffer.
+   */
+  FixedBufferOutputStream(void* data, v_buff_size capacity);
+
+  v_io_size write(const void *data, v_buff_size count, async::Action& action) override;
+
+  void setOutputStreamIOMode(oatpp::data::stream::IOMode ioMode) override;
+
+  oatpp::data::stream::IOMode getOutputStreamIOMode() override;
+
+  oatpp::data::stream::Context& getOutputStreamContext() override;
+
+  /**
+   * Get number of bytes written so far.
+   * @return
+   */
+  v_buff_size getCurrentPosition() const;
+
+  /**
+   * Get pointer to the buffer.
+   * @return
+   */
+  p_char8 getData() const;
+
+  /**
+   * Check if there was an attempt to write past the end of the buffer.
+   * @return
+   */
+  bool isOverflown() const;
+
+};
+
+/**
+ * Output stream which collects data as a list of segments (scatter/gather output).
+ * Regular writes are copied into inline chunks, while data written with &l:SegmentedOutputStream::writeReference (); -
+ * ex.: large string payloads - is referenced without copying.
+ * The list of segments can be passed to `writev()` as is - see &l:SegmentedOutputStream::flushToFileDescriptor ();.
+ */
+class SegmentedOutputStream : public oatpp::data::stream::ConsistentOutputStream {
+public:
+  static oatpp::data::stream::DefaultInitializedContext DEFAULT_CONTEXT;
+public:
+
+  /**
+   * Segment of data.
+   */
+  struct Segment {
+
+    /**
+     * Pointer to data.
+     */
+    const void* data;
+
+    /**
+     * Size of data.
+     */
+    v_buff_size size;
+
+  };
+
+private:
+
+  struct Chunk {
+    std::unique_ptr<v_char8[]> data;
+    v_buff_size capacity;
+    v_buff_size position;
+  };
+
+private:
+  v_buff_size m_chunkSize;
+  std::vector<Chunk> m_chunks;
+  std::vector<Segment> m_segments;
+  std::vector<std::shared_ptr<void>> m_captures;
+  v_buff_size m_size;
+  bool m_inlineSegmentOpen;
+  size_t m_flushSegment;
+  v_buff_size m_flushOffset;
+  oatpp::data::stream::IOMode m_ioMode;
+private:
+  Chunk& getChunk(v_buff_size minCapacity);
+public:
+
+  /**
+   * Constructor.
+   * @param chunkSize - size of the chunks used for inline data.
+   */
+  SegmentedOutputStream(v_buff_size chunkSize = 4096);
+
+  /**
+   * Copy data to the inline chunk.
+   * @param data
+   * @param count
+   * @param action
+   * @return - `count`.
+   */
+  v_io_size write(const void *data, v_buff_size count, async::Action& action) override;
+
+  void setOutputStreamIOMode(oatpp::data::stream::IOMode ioMode) override;
+
+  oatpp::data::stream::IOMode getOutputStreamIOMode() override;
+
+  oatpp::data::stream::Context& getOutputStreamContext() override;
+
+  /**
+   * Append data as a separate segment without copying it.
+   * @param capture - object owning the data. Kept alive till the stream is reset or destroyed.
+   * @param data - pointer to data.
+   * @param size - size of data.
+   */
+  void writeReference(const std::shared_ptr<void>& capture, const void* data, v_buff_size size);
+
+  /**
+   * Get list of segments.
+   * @return
+   */
+  const std::vector<Segment>& getSegments() const;
+
+  /**
+   * Get total size of data in all segments.
+   * @return
+   */
+  v_buff_size getSize() const;
+
+  /**
+   * Copy all segments to a single string.
+   * @return
+   */
+  oatpp::String toString() const;
+
+  /**
+   * Write all segments to the stream.
+   * @param stream - &id:oatpp::data::stream::OutputStream;.
+   * @return - number of bytes written, or error.
+   */
+  v_io_size flushToStream(oatpp::data::stream::OutputStream* stream) const;
+
+#if !defined(WIN32) && !defined(_WIN32)
+
+  /**
+   * Write segments to the file descriptor (ex.: socket) with `writev()`, without flattening them. <br>
+   * Sockets are written with `sendmsg()` and `MSG_NOSIGNAL`, so the closed connection doesn't raise `SIGPIPE`.
+   * Where `MSG_NOSIGNAL` is not available (ex.: macOS), the caller must ignore `SIGPIPE` or set `SO_NOSIGPIPE` on the socket. <br>
+   * Can be called repeatedly with non-blocking descriptors - the write continues from where the previous call stopped.
+   * @param fd - file descriptor.
+   * @return - number of bytes written, &id:oatpp::IOError::RETRY_WRITE; if the descriptor is not ready,
+   * or &id:oatpp::IOError::BROKEN_PIPE; on error. `0` - when all data is written.
+   */
+  v_io_size flushToFileDescriptor(int fd);
+
+#endif
+
+  /**
+   * Drop all segments and captured data.
+   */
+  void reset();
+
+};
+
+/**
+ * Output stream which compresses data in blocks and writes a compressed frame to the target stream. <br>
+ * Each block is compressed and forwarded as soon as it is filled, so compression runs along with serialization
+ * and memory usage is bounded by the block size. Call &l:CompressingOutputStream::finish (); once all data is written. <br>
+ * Frame: `'Z' <codec id> <block>... <0>`, where block is `<raw size> <data size> <data>` (sizes are varints).
+ * Blocks which don't compress are stored as is (`data size == raw size`).
+ */
+class CompressingOutputStream : public oatpp::data::stream::ConsistentOutputStream {
+public:
+  static oatpp::data::stream::DefaultInitializedContext DEFAULT_CONTEXT;
+private:
+  oatpp::data::stream::ConsistentOutputStream* m_target;
+  std::shared_ptr<Codec> m_codec;
+  std::unique_ptr<v_char8[]> m_block;
+  std::unique_ptr<v_char8[]> m_compressed;
+  v_buff_size m_blockSize;
+  v_buff_size m_position;
+  bool m_headerWritten;
+  bool m_finished;
+  oatpp::data::stream::IOMode m_ioMode;
+private:
+  void writeHeader();
+  void flushBlock();
+public:
+
+  /**
+   * Constructor.
+   * @param target - stream to write the compressed frame to.
+   * @param codec - &id:oatpp::bob::Codec;.
+   * @param blockSize - size of the uncompressed block.
+   * Must be in range `(0, Codec::MAX_BLOCK_SIZE]`, otherwise `std::invalid_argument` is thrown.
+   */
+  CompressingOutputStream(oatpp::data::stream::ConsistentOutputStream* target,
+                          const std::shared_ptr<Codec>& codec,
+                          v_buff_size blockSize = 64 * 1024);
+
+  /**
+   * Buffer data and compress it block by block.
+   * @param data
+   * @param count
+   * @param action
+   * @return - `count`.
+   */
+  v_io_size write(const void *data, v_buff_size count, async::Action& action) override;
+
+  void setOutputStreamIOMode(oatpp::data::stream::IOMode ioMode) override;
+
+  oatpp::data::stream::IOMode getOutputStreamIOMode() override;
+
+  oatpp::data::stream::Context& getOutputStreamContext() override;
+
+  /**
+   * Compress the remaining data and write the end of the frame.
+   */
+  void finish();
+
+};
+
+}}
+
+#endif //OATPP_BOB_STREAM_HPP
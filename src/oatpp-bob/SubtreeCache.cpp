@@ -0,0 +1,131 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "SubtreeCache.hpp"
+
+#include <cstdint>
+
+namespace oatpp { namespace bob {
+
+SubtreeCache::SubtreeCache()
+  : m_lockedLookups(0)
+{
+  for(v_int32 i = 0; i < FILTER_WORDS; i ++) {
+    m_filter[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+v_uint64 SubtreeCache::getFilterBit(const void* object, v_int32& word) {
+  const v_uint64 hash = (v_uint64) reinterpret_cast<std::uintptr_t>(object) * 11400714819323198485ull;
+  const v_uint32 bit = (v_uint32) (hash >> 52); // 12 bits - FILTER_WORDS * 64
+  word = (v_int32) (bit >> 6);
+  return (v_uint64) 1 << (bit & 63);
+}
+
+void SubtreeCache::put(const oatpp::Void& object, v_int64 version) {
+  if(!object) {
+    throw std::runtime_error("[oatpp::bob::SubtreeCache::put()]: Error. Object is null.");
+  }
+  std::lock_guard<std::mutex> lock(m_lock);
+  auto& entry = m_entries[object.get()];
+  if(entry.object.expired() || entry.version != version) {
+    entry.data = nullptr;
+    entry.encoder = nullptr;
+  }
+  entry.object = object.getPtr();
+  entry.version = version;
+  v_int32 word;
+  v_uint64 bit = getFilterBit(object.get(), word);
+  m_filter[word].fetch_or(bit, std::memory_order_release);
+}
+
+void SubtreeCache::remove(const oatpp::Void& object) {
+  std::lock_guard<std::mutex> lock(m_lock);
+  m_entries.erase(object.get());
+}
+
+void SubtreeCache::clear() {
+  std::lock_guard<std::mutex> lock(m_lock);
+  m_entries.clear();
+  for(v_int32 i = 0; i < FILTER_WORDS; i ++) {
+    m_filter[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+v_buff_size SubtreeCache::getSize() {
+  std::lock_guard<std::mutex> lock(m_lock);
+  return m_entries.size();
+}
+
+v_int64 SubtreeCache::getLockedLookups() {
+  std::lock_guard<std::mutex> lock(m_lock);
+  return m_lockedLookups;
+}
+
+SubtreeCache::Lookup SubtreeCache::get(const void* encoder, const void* object) {
+
+  Lookup result;
+  result.registered = false;
+  result.version = 0;
+
+  v_int32 word;
+  v_uint64 bit = getFilterBit(object, word);
+  if((m_filter[word].load(std::memory_order_acquire) & bit) == 0) {
+    return result;
+  }
+
+  std::lock_guard<std::mutex> lock(m_lock);
+  m_lockedLookups ++;
+
+  auto it = m_entries.find(object);
+  if(it == m_entries.end()) {
+    return result;
+  }
+
+  if(it->second.object.expired()) {
+    /* the object is gone - the address may be reused by another object */
+    m_entries.erase(it);
+    return result;
+  }
+
+  result.registered = true;
+  result.version = it->second.version;
+  if(it->second.encoder == encoder) {
+    result.data = it->second.data;
+  }
+
+  return result;
+
+}
+
+void SubtreeCache::store(const void* encoder, const void* object, v_int64 version, const std::shared_ptr<std::string>& data) {
+  std::lock_guard<std::mutex> lock(m_lock);
+  auto it = m_entries.find(object);
+  if(it != m_entries.end() && it->second.version == version && !it->second.object.expired()) {
+    it->second.encoder = encoder;
+    it->second.data = data;
+  }
+}
+
+}}
@@ -0,0 +1,151 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_BOB_SUBTREECACHE_HPP
+#define OATPP_BOB_SUBTREECACHE_HPP
+
+#include "oatpp/core/Types.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace oatpp { namespace bob {
+
+/**
+ * Cache of encoded objects (memoized subtrees). <br>
+ * Objects are cached by identity and are opt-in - only objects added with &l:SubtreeCache::put (); are memoized.
+ * The caller supplies a version of the object. Once the object is changed, call `put` with a new version -
+ * the next serialization will re-encode it. <br>
+ * Set the cache to &id:oatpp::bob::Serializer::Config::subtreeCache; to enable it.
+ * The cache can be shared between serializers - encodings made by different serializers are kept apart. <br>
+ * Lookups of objects which were never added are answered by the lock-free filter of the added addresses -
+ * only added objects (and rare filter collisions) take the lock.
+ */
+class SubtreeCache {
+public:
+
+  /**
+   * Result of the cache lookup.
+   */
+  struct Lookup {
+
+    /**
+     * `true` if the object was added to the cache.
+     */
+    bool registered;
+
+    /**
+     * Current version of the object.
+     */
+    v_int64 version;
+
+    /**
+     * Encoded object. `nullptr` if the object wasn't encoded yet for the current version.
+     */
+    std::shared_ptr<std::string> data;
+
+  };
+
+private:
+
+  struct Entry {
+    std::weak_ptr<void> object;
+    v_int64 version;
+    const void* encoder;
+    std::shared_ptr<std::string> data;
+  };
+
+  /* bits of the added addresses - cleared only by clear() */
+  static constexpr v_int32 FILTER_WORDS = 64;
+
+private:
+  static v_uint64 getFilterBit(const void* object, v_int32& word);
+private:
+  std::atomic<v_uint64> m_filter[FILTER_WORDS];
+  std::mutex m_lock;
+  std::unordered_map<const void*, Entry> m_entries;
+  v_int64 m_lockedLookups;
+public:
+
+  /**
+   * Constructor.
+   */
+  SubtreeCache();
+
+  SubtreeCache(const SubtreeCache&) = delete;
+  SubtreeCache& operator=(const SubtreeCache&) = delete;
+
+  /**
+   * Add object to the cache or update its version.
+   * @param object - object to memoize.
+   * @param version - version of the object supplied by the caller.
+   */
+  void put(const oatpp::Void& object, v_int64 version);
+
+  /**
+   * Remove object from the cache.
+   * @param object
+   */
+  void remove(const oatpp::Void& object);
+
+  /**
+   * Remove all objects.
+   */
+  void clear();
+
+  /**
+   * Get number of objects in the cache.
+   * @return
+   */
+  v_buff_size getSize();
+
+  /**
+   * Get number of lookups which passed the filter and took the lock. For diagnostics.
+   * @return
+   */
+  v_int64 getLockedLookups();
+
+  /**
+   * Find encoded object.
+   * @param encoder - serializer which will use the encoding.
+   * @param object - object.
+   * @return - &l:SubtreeCache::Lookup;.
+   */
+  Lookup get(const void* encoder, const void* object);
+
+  /**
+   * Store encoding of the object. Ignored if the object version was changed since the lookup.
+   * @param encoder - serializer which made the encoding.
+   * @param object - object.
+   * @param version - object version from &l:SubtreeCache::Lookup;.
+   * @param data - encoded object.
+   */
+  void store(const void* encoder, const void* object, v_int64 version, const std::shared_ptr<std::string>& data);
+
+};
+
+}}
+
+#endif // OATPP_BOB_SUBTREECACHE_HPP
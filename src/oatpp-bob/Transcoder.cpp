@@ -0,0 +1,1038 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "Transcoder.hpp"
+
+#include "./Codec.hpp"
+
+#include "oatpp/core/data/stream/BufferStream.hpp"
+#include "oatpp/core/parser/ParsingError.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace oatpp { namespace bob {
+
+constexpr v_int32 Transcoder::MAX_DEPTH;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// BOB -> JSON
+
+bool Transcoder::readCString(oatpp::parser::Caret& caret, const char*& data, v_buff_size& size) {
+  data = caret.getCurrData();
+  auto end = (const char*) std::memchr(data, 0, caret.getDataSize() - caret.getPosition());
+  if(end == nullptr) {
+    caret.setError("[oatpp::bob::Transcoder::readCString()]: Error. Invalid key.");
+    return false;
+  }
+  size = end - data;
+  caret.inc(size + 1);
+  return true;
+}
+
+bool Transcoder::readKey(oatpp::parser::Caret& caret, const char*& data, v_buff_size& size) {
+
+  if(!caret.isAtChar(Utils::KEY_REFERENCE)) {
+    return readCString(caret, data, size);
+  }
+
+  const v_buff_size position = caret.getPosition();
+  caret.inc();
+  v_uint64 distance = Utils::readVarUInt(caret);
+  if(caret.hasError()) {
+    return false;
+  }
+
+  if(distance == 0 || distance > (v_uint64) position) {
+    caret.setError("[oatpp::bob::Transcoder::readKey()]: Error. Invalid key reference.");
+    return false;
+  }
+
+  /* referenced key must be a plain key located before the reference */
+  oatpp::parser::Caret keyCaret(caret.getData(), position);
+  keyCaret.setPosition(position - distance);
+  if(keyCaret.isAtChar(Utils::KEY_REFERENCE) || !readCString(keyCaret, data, size)) {
+    caret.setError("[oatpp::bob::Transcoder::readKey()]: Error. Invalid key reference.");
+    return false;
+  }
+
+  return true;
+
+}
+
+bool Transcoder::readString(oatpp::parser::Caret& caret, const char*& data, v_buff_size& size) {
+
+  if(caret.isAtChar(Utils::TYPE_STRING_REFERENCE)) {
+
+    const v_buff_size position = caret.getPosition();
+    caret.inc();
+    v_uint64 distance = Utils::readVarUInt(caret);
+    if(caret.hasError()) {
+      return false;
+    }
+
+    if(distance == 0 || distance > (v_uint64) position) {
+      caret.setError("[oatpp::bob::Transcoder::readString()]: Error. Invalid string reference.");
+      return false;
+    }
+
+    /* referenced string must be a plain string located before the reference */
+    oatpp::parser::Caret stringCaret(caret.getData(), position);
+    stringCaret.setPosition(position - distance);
+    if(!stringCaret.isAtOneOfChars("sS$") || !readString(stringCaret, data, size)) {
+      caret.setError("[oatpp::bob::Transcoder::readString()]: Error. Invalid string reference.");
+      return false;
+    }
+    return true;
+
+  }
+
+  if(caret.canContinueAtChar(Utils::TYPE_STRING_1, 1)) {
+    size = (v_uint8) Utils::readInt8(caret);
+  } else if(caret.canContinueAtChar(Utils::TYPE_STRING_2, 1)) {
+    size = (v_uint16) Utils::readInt16(caret, Utils::BO_TYPE::NETWORK);
+  } else if(caret.canContinueAtChar(Utils::TYPE_STRING_4, 1)) {
+    size = (v_uint32) Utils::readInt32(caret, Utils::BO_TYPE::NETWORK);
+  } else {
+    caret.setError("[oatpp::bob::Transcoder::readString()]: Error. String expected.");
+    return false;
+  }
+
+  if(caret.hasError()) {
+    return false;
+  }
+
+  if(size > caret.getDataSize() - caret.getPosition()) {
+    caret.setError("[oatpp::bob::Transcoder::readString()]: Error. Invalid string size.");
+    return false;
+  }
+
+  data = caret.getCurrData();
+  caret.inc(size);
+  return true;
+
+}
+
+v_buff_size Transcoder::readSizedContainerHeader(oatpp::parser::Caret& caret) {
+
+  const bool indexed = caret.isAtChar(Utils::CONTROL_ARRAY_INDEXED);
+  caret.inc(); // 'M', 'A' or 'X'
+
+  v_uint32 size = (v_uint32) Utils::readInt32(caret, Utils::BO_TYPE::NETWORK);
+  Utils::readInt32(caret, Utils::BO_TYPE::NETWORK);
+  const v_buff_size end = caret.getPosition() + size;
+  if(indexed) {
+    Utils::readInt32(caret, Utils::BO_TYPE::NETWORK);
+  }
+
+  if(caret.hasError()) {
+    return -1;
+  }
+
+  if(end > caret.getDataSize() || end <= caret.getPosition()) {
+    caret.setError("[oatpp::bob::Transcoder::readSizedContainerHeader()]: Error. Invalid container header.");
+    return -1;
+  }
+
+  return end;
+
+}
+
+void Transcoder::writeJsonString(ConsistentOutputStream* stream, const char* data, v_buff_size size) {
+
+  static const char* const HEX = "0123456789abcdef";
+
+  stream->writeCharSimple('"');
+
+  v_buff_size begin = 0;
+  for(v_buff_size i = 0; i < size; i ++) {
+
+    v_char8 c = (v_char8) data[i];
+    if(c >= 0x20 && c != '"' && c != '\\') {
+      continue;
+    }
+
+    stream->writeSimple(data + begin, i - begin);
+    begin = i + 1;
+
+    switch(c) {
+      case '"': stream->writeSimple("\\\"", 2); break;
+      case '\\': stream->writeSimple("\\\\", 2); break;
+      case '\b': stream->writeSimple("\\b", 2); break;
+      case '\f': stream->writeSimple("\\f", 2); break;
+      case '\n': stream->writeSimple("\\n", 2); break;
+      case '\r': stream->writeSimple("\\r", 2); break;
+      case '\t': stream->writeSimple("\\t", 2); break;
+      default: {
+        char escaped[6] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 15]};
+        stream->writeSimple(escaped, 6);
+      }
+    }
+
+  }
+
+  stream->writeSimple(data + begin, size - begin);
+  stream->writeCharSimple('"');
+
+}
+
+void Transcoder::transcodeBobMap(oatpp::parser::Caret& caret, ConsistentOutputStream* stream, v_int32 depth) {
+
+  v_buff_size end = -1;
+  if(caret.isAtChar(Utils::CONTROL_MAP_SIZED)) {
+    end = readSizedContainerHeader(caret);
+    if(caret.hasError()) return;
+  } else {
+    caret.inc(); // '{'
+  }
+
+  stream->writeCharSimple('{');
+
+  bool first = true;
+  while(caret.canContinue() && !caret.isAtChar(Utils::CONTROL_SECTION_END)) {
+
+    const char* key;
+    v_buff_size keySize;
+    if(!readKey(caret, key, keySize)) return;
+
+    if(!first) {
+      stream->writeCharSimple(',');
+    }
+    first = false;
+
+    writeJsonString(stream, key, keySize);
+    stream->writeCharSimple(':');
+
+    transcodeBobValue(caret, stream, depth + 1);
+    if(caret.hasError()) return;
+
+  }
+
+  if(!caret.canContinueAtChar(Utils::CONTROL_SECTION_END, 1)) {
+    caret.setError("[oatpp::bob::Transcoder::transcodeBobMap()]: Error. ')' - expected");
+    return;
+  }
+
+  stream->writeCharSimple('}');
+
+  if(end >= 0) {
+    if(caret.getPosition() != end) {
+      caret.setError("[oatpp::bob::Transcoder::transcodeBobMap()]: Error. Invalid container size.");
+      return;
+    }
+  }
+
+}
+
+void Transcoder::transcodeBobArray(oatpp::parser::Caret& caret, ConsistentOutputStream* stream, v_int32 depth) {
+
+  v_buff_size end = -1;
+  if(caret.isAtOneOfChars("AX")) {
+    end = readSizedContainerHeader(caret);
+    if(caret.hasError()) return;
+  } else {
+    caret.inc(); // '['
+  }
+
+  stream->writeCharSimple('[');
+
+  bool first = true;
+  while(caret.canContinue() && !caret.isAtChar(Utils::CONTROL_SECTION_END)) {
+
+    if(!first) {
+      stream->writeCharSimple(',');
+    }
+    first = false;
+
+    transcodeBobValue(caret, stream, depth + 1);
+    if(caret.hasError()) return;
+
+  }
+
+  if(!caret.canContinueAtChar(Utils::CONTROL_SECTION_END, 1)) {
+    caret.setError("[oatpp::bob::Transcoder::transcodeBobArray()]: Error. ')' - expected");
+    return;
+  }
+
+  stream->writeCharSimple(']');
+
+  if(end >= 0) {
+    if(caret.getPosition() > end) {
+      caret.setError("[oatpp::bob::Transcoder::transcodeBobArray()]: Error. Invalid container size.");
+      return;
+    }
+    caret.setPosition(end); // skip the offset index
+  }
+
+}
+
+bool Transcoder::openColumn(Column& column, const char* data, v_buff_size start, v_buff_size end, v_uint64 rowsCount) {
+
+  column.position = 0;
+  column.end = end;
+
+  switch(column.type) {
+    case Utils::COLUMN_VALUES:
+      column.position = start;
+      return true;
+    case Utils::TYPE_INT_1:
+    case Utils::TYPE_UINT_1: column.width = 1; break;
+    case Utils::TYPE_INT_2:
+    case Utils::TYPE_UINT_2: column.width = 2; break;
+    case Utils::TYPE_INT_4:
+    case Utils::TYPE_UINT_4:
+    case Utils::TYPE_FLOAT_4: column.width = 4; break;
+    case Utils::TYPE_INT_8:
+    case Utils::TYPE_UINT_8:
+    case Utils::TYPE_FLOAT_8: column.width = 8; break;
+    case Utils::TYPE_BOOL_TRUE:
+    case Utils::TYPE_STRING_4: column.width = 0; break;
+    default:
+      return false;
+  }
+
+  const v_buff_size bitmapSize = (v_buff_size) (rowsCount / 8 + (rowsCount % 8 != 0 ? 1 : 0));
+  if(end - start < bitmapSize) {
+    return false;
+  }
+
+  column.bitmap = (const v_char8*) data + start;
+  column.data = column.bitmap + bitmapSize;
+
+  v_buff_size valuesCount = 0;
+  for(v_uint64 i = 0; i < rowsCount; i ++) {
+    if(column.bitmap[i / 8] & (1 << (i % 8))) {
+      valuesCount ++;
+    }
+  }
+
+  const v_buff_size available = end - start - bitmapSize;
+
+  if(column.width > 0) {
+    return available >= column.width * valuesCount;
+  }
+
+  if(column.type == Utils::TYPE_BOOL_TRUE) {
+    return available >= (valuesCount + 7) / 8;
+  }
+
+  /* strings - end offsets, then the blob */
+  const v_buff_size offsetsSize = (valuesCount + 1) * 4;
+  if(available < offsetsSize) {
+    return false;
+  }
+  column.blob = (const char*) column.data + offsetsSize;
+  column.blobSize = available - offsetsSize;
+  return true;
+
+}
+
+void Transcoder::transcodeBobColumns(oatpp::parser::Caret& caret, ConsistentOutputStream* stream, v_int32 depth) {
+
+  caret.inc(); // 'C'
+
+  const v_uint64 rowsCount = Utils::readVarUInt(caret);
+  const v_uint64 columnsCount = Utils::readVarUInt(caret);
+  if(caret.hasError()) {
+    return;
+  }
+
+  /* each column takes at least 6 bytes - key, type and size. Rows are bounded by the column sizes below */
+  if((columnsCount == 0 && rowsCount > 0) || columnsCount > (v_uint64) (caret.getDataSize() - caret.getPosition()) / 6) {
+    caret.setError("[oatpp::bob::Transcoder::transcodeBobColumns()]: Error. Invalid columns header.");
+    return;
+  }
+
+  std::vector<Column> columns(columnsCount);
+
+  for(auto& column : columns) {
+
+    if(!readKey(caret, column.key, column.keySize)) return;
+
+    if(!caret.canContinue()) {
+      caret.setError("[oatpp::bob::Transcoder::transcodeBobColumns()]: Error. Column type expected.");
+      return;
+    }
+    column.type = *caret.getCurrData();
+    caret.inc();
+
+    v_uint32 size = (v_uint32) Utils::readInt32(caret, Utils::BO_TYPE::NETWORK);
+    if(caret.hasError()) return;
+    if(size > caret.getDataSize() - caret.getPosition()) {
+      caret.setError("[oatpp::bob::Transcoder::transcodeBobColumns()]: Error. Invalid column size.");
+      return;
+    }
+
+    /* values column - at least one byte per row, packed column - at least the null bitmap */
+    const v_uint64 minSize = column.type == Utils::COLUMN_VALUES ? rowsCount : rowsCount / 8 + (rowsCount % 8 != 0 ? 1 : 0);
+    if(size < minSize) {
+      caret.setError("[oatpp::bob::Transcoder::transcodeBobColumns()]: Error. Invalid rows count.");
+      return;
+    }
+
+    const v_buff_size start = caret.getPosition();
+    caret.inc(size);
+
+    if(!openColumn(column, caret.getData(), start, start + size, rowsCount)) {
+      caret.setError("[oatpp::bob::Transcoder::transcodeBobColumns()]: Error. Invalid column.");
+      return;
+    }
+
+  }
+
+  if(!caret.canContinueAtChar(Utils::CONTROL_SECTION_END, 1)) {
+    caret.setError("[oatpp::bob::Transcoder::transcodeBobColumns()]: Error. ')' - expected");
+    return;
+  }
+
+  /* rows - one value from every column */
+
+  v_char8 cell[9];
+
+  stream->writeCharSimple('[');
+
+  for(v_uint64 i = 0; i < rowsCount; i ++) {
+
+    if(i > 0) {
+      stream->writeCharSimple(',');
+    }
+    stream->writeCharSimple('{');
+
+    for(v_buff_size c = 0; c < (v_buff_size) columns.size(); c ++) {
+
+      auto& column = columns[c];
+
+      if(c > 0) {
+        stream->writeCharSimple(',');
+      }
+      writeJsonString(stream, column.key, column.keySize);
+      stream->writeCharSimple(':');
+
+      if(column.type == Utils::COLUMN_VALUES) {
+        /* parse in place - values may contain references to the preceding data */
+        oatpp::parser::Caret valueCaret(caret.getData(), column.end);
+        valueCaret.setPosition(column.position);
+        transcodeBobValue(valueCaret, stream, depth + 1);
+        if(valueCaret.hasError()) {
+          caret.setError(valueCaret.getErrorMessage(), valueCaret.getErrorCode());
+          return;
+        }
+        column.position = valueCaret.getPosition();
+        continue;
+      }
+
+      if(!(column.bitmap[i / 8] & (1 << (i % 8)))) {
+        stream->writeSimple("null", 4);
+        continue;
+      }
+
+      const v_buff_size k = column.position ++;
+
+      if(column.width > 0) {
+        cell[0] = column.type;
+        std::memcpy(cell + 1, column.data + k * column.width, column.width);
+        oatpp::parser::Caret cellCaret((const char*) cell, column.width + 1);
+        transcodeBobValue(cellCaret, stream, depth + 1);
+      } else if(column.type == Utils::TYPE_BOOL_TRUE) {
+        if(column.data[k / 8] & (1 << (k % 8))) {
+          stream->writeSimple("true", 4);
+        } else {
+          stream->writeSimple("false", 5);
+        }
+      } else {
+        oatpp::parser::Caret offsetsCaret((const char*) column.data + k * 4, 8);
+        v_uint32 start = (v_uint32) Utils::readInt32(offsetsCaret, Utils::BO_TYPE::NETWORK);
+        v_uint32 end = (v_uint32) Utils::readInt32(offsetsCaret, Utils::BO_TYPE::NETWORK);
+        if(end < start || end > column.blobSize) {
+          caret.setError("[oatpp::bob::Transcoder::transcodeBobColumns()]: Error. Invalid string offset.");
+          return;
+        }
+        writeJsonString(stream, column.blob + start, end - start);
+      }
+
+    }
+
+    stream->writeCharSimple('}');
+
+  }
+
+  stream->writeCharSimple(']');
+
+}
+
+void Transcoder::transcodeBobValue(oatpp::parser::Caret& caret, ConsistentOutputStream* stream, v_int32 depth) {
+
+  if(!caret.canContinue()) {
+    caret.setError("[oatpp::bob::Transcoder::transcodeBobValue()]: Error. Unexpected end of data.");
+    return;
+  }
+
+  if(depth > MAX_DEPTH) {
+    caret.setError("[oatpp::bob::Transcoder::transcodeBobValue()]: Error. Max depth exceeded.");
+    return;
+  }
+
+  v_char8 c = *caret.getCurrData();
+
+  switch(c) {
+
+    case Utils::TYPE_NULL:
+      caret.inc();
+      stream->writeSimple("null", 4);
+      return;
+
+    case Utils::TYPE_STRING_1:
+    case Utils::TYPE_STRING_2:
+    case Utils::TYPE_STRING_4:
+    case Utils::TYPE_STRING_REFERENCE: {
+      const char* data;
+      v_buff_size size;
+      if(readString(caret, data, size)) {
+        writeJsonString(stream, data, size);
+      }
+      return;
+    }
+
+    case Utils::TYPE_BOOL_TRUE:
+      caret.inc();
+      stream->writeSimple("true", 4);
+      return;
+    case Utils::TYPE_BOOL_FALSE:
+      caret.inc();
+      stream->writeSimple("false", 5);
+      return;
+
+    case Utils::CONTROL_MAP_BEGIN:
+    case Utils::CONTROL_MAP_SIZED:
+      transcodeBobMap(caret, stream, depth);
+      return;
+    case Utils::CONTROL_ARRAY_BEGIN:
+    case Utils::CONTROL_ARRAY_SIZED:
+    case Utils::CONTROL_ARRAY_INDEXED:
+      transcodeBobArray(caret, stream, depth);
+      return;
+    case Utils::CONTROL_COLUMNS_BEGIN:
+      transcodeBobColumns(caret, stream, depth);
+      return;
+
+    default:
+      break;
+
+  }
+
+  caret.inc();
+
+  switch(c) {
+
+    case Utils::TYPE_INT_1: {
+      v_int64 value = Utils::readInt8(caret);
+      if(!caret.hasError()) stream->writeAsString(value);
+      return;
+    }
+    case Utils::TYPE_UINT_1: {
+      v_uint64 value = (v_uint8) Utils::readInt8(caret);
+      if(!caret.hasError()) stream->writeAsString(value);
+      return;
+    }
+    case Utils::TYPE_INT_2: {
+      v_int64 value = Utils::readInt16(caret, Utils::BO_TYPE::NETWORK);
+      if(!caret.hasError()) stream->writeAsString(value);
+      return;
+    }
+    case Utils::TYPE_UINT_2: {
+      v_uint64 value = (v_uint16) Utils::readInt16(caret, Utils::BO_TYPE::NETWORK);
+      if(!caret.hasError()) stream->writeAsString(value);
+      return;
+    }
+    case Utils::TYPE_INT_4: {
+      v_int64 value = Utils::readInt32(caret, Utils::BO_TYPE::NETWORK);
+      if(!caret.hasError()) stream->writeAsString(value);
+      return;
+    }
+    case Utils::TYPE_UINT_4: {
+      v_uint64 value = (v_uint32) Utils::readInt32(caret, Utils::BO_TYPE::NETWORK);
+      if(!caret.hasError()) stream->writeAsString(value);
+      return;
+    }
+    case Utils::TYPE_INT_8: {
+      v_int64 value = Utils::readInt64(caret, Utils::BO_TYPE::NETWORK);
+      if(!caret.hasError()) stream->writeAsString(value);
+      return;
+    }
+    case Utils::TYPE_UINT_8: {
+      v_uint64 value = (v_uint64) Utils::readInt64(caret, Utils::BO_TYPE::NETWORK);
+      if(!caret.hasError()) stream->writeAsString(value);
+      return;
+    }
+
+    case Utils::TYPE_FLOAT_4: {
+      v_float32 value = Utils::readFloat32(caret, Utils::BO_TYPE::NETWORK);
+      if(!caret.hasError()) stream->writeAsString(value);
+      return;
+    }
+    case Utils::TYPE_FLOAT_8: {
+      v_float64 value = Utils::readFloat64(caret, Utils::BO_TYPE::NETWORK);
+      if(!caret.hasError()) stream->writeAsString(value);
+      return;
+    }
+
+    default:
+      caret.setError("[oatpp::bob::Transcoder::transcodeBobValue()]: Error. Invalid state.");
+
+  }
+
+}
+
+void Transcoder::bobToJson(oatpp::parser::Caret& caret, ConsistentOutputStream* stream, v_buff_size maxFrameSize) {
+
+  if(maxFrameSize > 0 && caret.canContinue() && (v_char8) caret.getCurrData()[0] == Codec::FRAME_BEGIN) {
+
+    auto data = Codec::readFrame(caret, nullptr, maxFrameSize);
+    if(caret.hasError()) {
+      return;
+    }
+
+    oatpp::parser::Caret frameCaret(data);
+    transcodeBobValue(frameCaret, stream, 0);
+    if(frameCaret.hasError()) {
+      caret.setError(frameCaret.getErrorMessage(), frameCaret.getErrorCode());
+    }
+    return;
+
+  }
+
+  transcodeBobValue(caret, stream, 0);
+
+}
+
+oatpp::String Transcoder::bobToJson(const oatpp::String& bob, v_buff_size maxFrameSize) {
+  oatpp::parser::Caret caret(bob);
+  oatpp::data::stream::BufferOutputStream stream(bob->size() * 2);
+  bobToJson(caret, &stream, maxFrameSize);
+  if(caret.hasError()) {
+    throw oatpp::parser::ParsingError(caret.getErrorMessage(), caret.getErrorCode(), caret.getPosition());
+  }
+  return stream.toString();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// JSON -> BOB
+
+namespace {
+
+v_int32 parseHex4(const char* data) {
+  v_int32 result = 0;
+  for(v_int32 i = 0; i < 4; i ++) {
+    char c = data[i];
+    result <<= 4;
+    if(c >= '0' && c <= '9') result |= c - '0';
+    else if(c >= 'a' && c <= 'f') result |= c - 'a' + 10;
+    else if(c >= 'A' && c <= 'F') result |= c - 'A' + 10;
+    else return -1;
+  }
+  return result;
+}
+
+void appendUtf8(std::string& buffer, v_uint32 code) {
+  if(code < 0x80) {
+    buffer.push_back((char) code);
+  } else if(code < 0x800) {
+    buffer.push_back((char) (0xC0 | (code >> 6)));
+    buffer.push_back((char) (0x80 | (code & 0x3F)));
+  } else if(code < 0x10000) {
+    buffer.push_back((char) (0xE0 | (code >> 12)));
+    buffer.push_back((char) (0x80 | ((code >> 6) & 0x3F)));
+    buffer.push_back((char) (0x80 | (code & 0x3F)));
+  } else {
+    buffer.push_back((char) (0xF0 | (code >> 18)));
+    buffer.push_back((char) (0x80 | ((code >> 12) & 0x3F)));
+    buffer.push_back((char) (0x80 | ((code >> 6) & 0x3F)));
+    buffer.push_back((char) (0x80 | (code & 0x3F)));
+  }
+}
+
+}
+
+bool Transcoder::readJsonString(oatpp::parser::Caret& caret, std::string& buffer, const char*& data, v_buff_size& size) {
+
+  caret.inc(); // '"'
+
+  const char* begin = caret.getCurrData();
+  const v_buff_size available = caret.getDataSize() - caret.getPosition();
+
+  /* strings without escapes are passed as is */
+  v_buff_size i = 0;
+  while(i < available && begin[i] != '"' && begin[i] != '\\') {
+    i ++;
+  }
+
+  if(i == available) {
+    caret.setError("[oatpp::bob::Transcoder::readJsonString()]: Error. '\"' - expected");
+    return false;
+  }
+
+  if(begin[i] == '"') {
+    data = begin;
+    size = i;
+    caret.inc(i + 1);
+    return true;
+  }
+
+  buffer.assign(begin, i);
+
+  while(i < available && begin[i] != '"') {
+
+    if(begin[i] != '\\') {
+      buffer.push_back(begin[i ++]);
+      continue;
+    }
+
+    if(i + 1 >= available) {
+      break;
+    }
+
+    char c = begin[i + 1];
+    i += 2;
+
+    switch(c) {
+      case '"': buffer.push_back('"'); break;
+      case '\\': buffer.push_back('\\'); break;
+      case '/': buffer.push_back('/'); break;
+      case 'b': buffer.push_back('\b'); break;
+      case 'f': buffer.push_back('\f'); break;
+      case 'n': buffer.push_back('\n'); break;
+      case 'r': buffer.push_back('\r'); break;
+      case 't': buffer.push_back('\t'); break;
+      case 'u': {
+        v_int32 code = available - i >= 4 ? parseHex4(begin + i) : -1;
+        if(code < 0) {
+          caret.setError("[oatpp::bob::Transcoder::readJsonString()]: Error. Invalid escape sequence.");
+          return false;
+        }
+        i += 4;
+        if(code >= 0xD800 && code <= 0xDBFF) {
+          v_int32 low = available - i >= 6 && begin[i] == '\\' && begin[i + 1] == 'u' ? parseHex4(begin + i + 2) : -1;
+          if(low < 0xDC00 || low > 0xDFFF) {
+            caret.setError("[oatpp::bob::Transcoder::readJsonString()]: Error. Invalid surrogate pair.");
+            return false;
+          }
+          i += 6;
+          code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+        } else if(code >= 0xDC00 && code <= 0xDFFF) {
+          caret.setError("[oatpp::bob::Transcoder::readJsonString()]: Error. Invalid surrogate pair.");
+          return false;
+        }
+        appendUtf8(buffer, (v_uint32) code);
+        break;
+      }
+      default:
+        caret.setError("[oatpp::bob::Transcoder::readJsonString()]: Error. Invalid escape sequence.");
+        return false;
+    }
+
+  }
+
+  if(i >= available) {
+    caret.setError("[oatpp::bob::Transcoder::readJsonString()]: Error. '\"' - expected");
+    return false;
+  }
+
+  data = buffer.data();
+  size = buffer.size();
+  caret.inc(i + 1);
+  return true;
+
+}
+
+void Transcoder::writeBobString(ConsistentOutputStream* stream, const char* data, v_buff_size size) {
+  if(size < ((v_int64)1 << 8)) {
+    stream->writeCharSimple(Utils::TYPE_STRING_1);
+    Utils::writeInt8(stream, size);
+  } else if(size < ((v_int64)1 << 16)) {
+    stream->writeCharSimple(Utils::TYPE_STRING_2);
+    Utils::writeInt16(stream, size, Utils::BO_TYPE::NETWORK);
+  } else if(size < ((v_int64)1 << 32)) {
+    stream->writeCharSimple(Utils::TYPE_STRING_4);
+    Utils::writeInt32(stream, size, Utils::BO_TYPE::NETWORK);
+  } else {
+    throw std::runtime_error("[oatpp::bob::Transcoder::writeBobString()]: Error. Invalid string size.");
+  }
+  stream->writeSimple(data, size);
+}
+
+void Transcoder::writeBobInteger(ConsistentOutputStream* stream, v_int64 value) {
+  if(value >= -128 && value <= 127) {
+    stream->writeCharSimple(Utils::TYPE_INT_1);
+    Utils::writeInt8(stream, (v_int8) value);
+  } else if(value >= -32768 && value <= 32767) {
+    stream->writeCharSimple(Utils::TYPE_INT_2);
+    Utils::writeInt16(stream, (v_int16) value, Utils::BO_TYPE::NETWORK);
+  } else if(value >= -2147483648LL && value <= 2147483647LL) {
+    stream->writeCharSimple(Utils::TYPE_INT_4);
+    Utils::writeInt32(stream, (v_int32) value, Utils::BO_TYPE::NETWORK);
+  } else {
+    stream->writeCharSimple(Utils::TYPE_INT_8);
+    Utils::writeInt64(stream, value, Utils::BO_TYPE::NETWORK);
+  }
+}
+
+void Transcoder::transcodeJsonNumber(oatpp::parser::Caret& caret, ConsistentOutputStream* stream, std::string& buffer) {
+
+  const char* begin = caret.getCurrData();
+  const v_buff_size available = caret.getDataSize() - caret.getPosition();
+
+  v_buff_size size = 0;
+  bool isInteger = true;
+  while(size < available) {
+    char c = begin[size];
+    if(c == '.' || c == 'e' || c == 'E' || c == '+') {
+      isInteger = false;
+    } else if((c < '0' || c > '9') && c != '-') {
+      break;
+    }
+    size ++;
+  }
+
+  if(isInteger) {
+
+    const bool negative = begin[0] == '-';
+    v_buff_size i = negative ? 1 : 0;
+    v_uint64 value = 0;
+    bool overflow = false;
+
+    if(i == size) {
+      caret.setError("[oatpp::bob::Transcoder::transcodeJsonNumber()]: Error. Invalid number.");
+      return;
+    }
+
+    for(; i < size; i ++) {
+      if(begin[i] == '-') {
+        caret.setError("[oatpp::bob::Transcoder::transcodeJsonNumber()]: Error. Invalid number.");
+        return;
+      }
+      v_uint64 digit = begin[i] - '0';
+      if(value > (UINT64_MAX - digit) / 10) {
+        overflow = true;
+        break;
+      }
+      value = value * 10 + digit;
+    }
+
+    if(!overflow) {
+      if(!negative && value <= (v_uint64) INT64_MAX) {
+        writeBobInteger(stream, (v_int64) value);
+        caret.inc(size);
+        return;
+      }
+      if(!negative) {
+        stream->writeCharSimple(Utils::TYPE_UINT_8);
+        Utils::writeInt64(stream, (v_int64) value, Utils::BO_TYPE::NETWORK);
+        caret.inc(size);
+        return;
+      }
+      if(value <= (v_uint64) INT64_MAX + 1) {
+        writeBobInteger(stream, (v_int64) (0 - value));
+        caret.inc(size);
+        return;
+      }
+    }
+
+    /* out of the integer range - write as float */
+
+  }
+
+  buffer.assign(begin, size); // null-terminated copy for strtod
+  char* end;
+  v_float64 value = std::strtod(buffer.c_str(), &end);
+  if(size == 0 || end != buffer.c_str() + size) {
+    caret.setError("[oatpp::bob::Transcoder::transcodeJsonNumber()]: Error. Invalid number.");
+    return;
+  }
+
+  stream->writeCharSimple(Utils::TYPE_FLOAT_8);
+  Utils::writeFloat64(stream, value, Utils::BO_TYPE::NETWORK);
+  caret.inc(size);
+
+}
+
+void Transcoder::transcodeJsonValue(oatpp::parser::Caret& caret, ConsistentOutputStream* stream, std::string& buffer, v_int32 depth) {
+
+  caret.skipBlankChars();
+
+  if(!caret.canContinue()) {
+    caret.setError("[oatpp::bob::Transcoder::transcodeJsonValue()]: Error. Unexpected end of data.");
+    return;
+  }
+
+  if(depth > MAX_DEPTH) {
+    caret.setError("[oatpp::bob::Transcoder::transcodeJsonValue()]: Error. Max depth exceeded.");
+    return;
+  }
+
+  const char* data;
+  v_buff_size size;
+
+  switch(*caret.getCurrData()) {
+
+    case '{': {
+
+      caret.inc();
+      stream->writeCharSimple(Utils::CONTROL_MAP_BEGIN);
+
+      caret.skipBlankChars();
+      if(caret.canContinueAtChar('}', 1)) {
+        stream->writeCharSimple(Utils::CONTROL_SECTION_END);
+        return;
+      }
+
+      while(true) {
+
+        caret.skipBlankChars();
+        if(!caret.isAtChar('"')) {
+          caret.setError("[oatpp::bob::Transcoder::transcodeJsonValue()]: Error. '\"' - expected");
+          return;
+        }
+        if(!readJsonString(caret, buffer, data, size)) return;
+        if(std::memchr(data, 0, size) != nullptr || (size > 0 && (v_char8) data[0] == Utils::KEY_REFERENCE)) {
+          caret.setError("[oatpp::bob::Transcoder::transcodeJsonValue()]: Error. Key can't be written to BOB.");
+          return;
+        }
+        stream->writeSimple(data, size);
+        stream->writeCharSimple(0);
+
+        caret.skipBlankChars();
+        if(!caret.canContinueAtChar(':', 1)) {
+          caret.setError("[oatpp::bob::Transcoder::transcodeJsonValue()]: Error. ':' - expected");
+          return;
+        }
+
+        transcodeJsonValue(caret, stream, buffer, depth + 1);
+        if(caret.hasError()) return;
+
+        caret.skipBlankChars();
+        if(caret.canContinueAtChar(',', 1)) {
+          continue;
+        }
+        if(caret.canContinueAtChar('}', 1)) {
+          break;
+        }
+        caret.setError("[oatpp::bob::Transcoder::transcodeJsonValue()]: Error. '}' - expected");
+        return;
+
+      }
+
+      stream->writeCharSimple(Utils::CONTROL_SECTION_END);
+      return;
+
+    }
+
+    case '[': {
+
+      caret.inc();
+      stream->writeCharSimple(Utils::CONTROL_ARRAY_BEGIN);
+
+      caret.skipBlankChars();
+      if(caret.canContinueAtChar(']', 1)) {
+        stream->writeCharSimple(Utils::CONTROL_SECTION_END);
+        return;
+      }
+
+      while(true) {
+
+        transcodeJsonValue(caret, stream, buffer, depth + 1);
+        if(caret.hasError()) return;
+
+        caret.skipBlankChars();
+        if(caret.canContinueAtChar(',', 1)) {
+          continue;
+        }
+        if(caret.canContinueAtChar(']', 1)) {
+          break;
+        }
+        caret.setError("[oatpp::bob::Transcoder::transcodeJsonValue()]: Error. ']' - expected");
+        return;
+
+      }
+
+      stream->writeCharSimple(Utils::CONTROL_SECTION_END);
+      return;
+
+    }
+
+    case '"':
+      if(readJsonString(caret, buffer, data, size)) {
+        writeBobString(stream, data, size);
+      }
+      return;
+
+    case 't':
+      if(caret.isAtText("true", 4, true)) {
+        stream->writeCharSimple(Utils::TYPE_BOOL_TRUE);
+        return;
+      }
+      break;
+
+    case 'f':
+      if(caret.isAtText("false", 5, true)) {
+        stream->writeCharSimple(Utils::TYPE_BOOL_FALSE);
+        return;
+      }
+      break;
+
+    case 'n':
+      if(caret.isAtText("null", 4, true)) {
+        stream->writeCharSimple(Utils::TYPE_NULL);
+        return;
+      }
+      break;
+
+    default:
+      if(caret.isAtChar('-') || caret.isAtDigitChar()) {
+        transcodeJsonNumber(caret, stream, buffer);
+        return;
+      }
+
+  }
+
+  caret.setError("[oatpp::bob::Transcoder::transcodeJsonValue()]: Error. Invalid value.");
+
+}
+
+void Transcoder::jsonToBob(oatpp::parser::Caret& caret, ConsistentOutputStream* stream) {
+  std::string buffer; // strings with escapes and long numbers are decoded here
+  transcodeJsonValue(caret, stream, buffer, 0);
+}
+
+oatpp::String Transcoder::jsonToBob(const oatpp::String& json) {
+  oatpp::parser::Caret caret(json);
+  oatpp::data::stream::BufferOutputStream stream(json->size());
+  jsonToBob(caret, &stream);
+  if(caret.hasError()) {
+    throw oatpp::parser::ParsingError(caret.getErrorMessage(), caret.getErrorCode(), caret.getPosition());
+  }
+  return stream.toString();
+}
+
+}}
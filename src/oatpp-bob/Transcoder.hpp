@@ -0,0 +1,129 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_BOB_TRANSCODER_HPP
+#define OATPP_BOB_TRANSCODER_HPP
+
+#include "./Utils.hpp"
+
+#include "oatpp/core/parser/Caret.hpp"
+#include "oatpp/core/data/stream/Stream.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include <string>
+#include <vector>
+
+namespace oatpp { namespace bob {
+
+/**
+ * Direct JSON <-> BOB conversion. <br>
+ * Tags (or JSON tokens) are converted one by one and written to the output stream - no `oatpp::Any` tree is built.
+ */
+class Transcoder {
+public:
+  typedef oatpp::data::stream::ConsistentOutputStream ConsistentOutputStream;
+public:
+
+  /**
+   * Max nesting of maps and arrays.
+   */
+  static constexpr v_int32 MAX_DEPTH = 512;
+
+private:
+
+  /*
+   * Cursor of the column of the columnar container ('C').
+   */
+  struct Column {
+    const char* key;
+    v_buff_size keySize;
+    v_char8 type;
+    v_buff_size width; // width of the packed value
+    const v_char8* bitmap; // non-null rows
+    const v_char8* data; // packed values or string offsets
+    const char* blob; // string data
+    v_buff_size blobSize;
+    v_buff_size position; // '*' - position of the next value. Packed columns - index of the next non-null value.
+    v_buff_size end; // '*' - end of the column
+  };
+
+private:
+  static bool readCString(oatpp::parser::Caret& caret, const char*& data, v_buff_size& size);
+  static bool readKey(oatpp::parser::Caret& caret, const char*& data, v_buff_size& size);
+  static bool readString(oatpp::parser::Caret& caret, const char*& data, v_buff_size& size);
+  static v_buff_size readSizedContainerHeader(oatpp::parser::Caret& caret);
+  static void writeJsonString(ConsistentOutputStream* stream, const char* data, v_buff_size size);
+  static void transcodeBobMap(oatpp::parser::Caret& caret, ConsistentOutputStream* stream, v_int32 depth);
+  static void transcodeBobArray(oatpp::parser::Caret& caret, ConsistentOutputStream* stream, v_int32 depth);
+  static bool openColumn(Column& column, const char* data, v_buff_size start, v_buff_size end, v_uint64 rowsCount);
+  static void transcodeBobColumns(oatpp::parser::Caret& caret, ConsistentOutputStream* stream, v_int32 depth);
+  static void transcodeBobValue(oatpp::parser::Caret& caret, ConsistentOutputStream* stream, v_int32 depth);
+private:
+  static bool readJsonString(oatpp::parser::Caret& caret, std::string& buffer, const char*& data, v_buff_size& size);
+  static void writeBobString(ConsistentOutputStream* stream, const char* data, v_buff_size size);
+  static void writeBobInteger(ConsistentOutputStream* stream, v_int64 value);
+  static void transcodeJsonNumber(oatpp::parser::Caret& caret, ConsistentOutputStream* stream, std::string& buffer);
+  static void transcodeJsonValue(oatpp::parser::Caret& caret, ConsistentOutputStream* stream, std::string& buffer, v_int32 depth);
+public:
+
+  /**
+   * Convert BOB value to JSON. <br>
+   * References, sized and columnar containers are resolved. Columnar containers are written as arrays of objects.
+   * Strings are written as is (UTF-8), only quotes, backslashes and control characters are escaped.
+   * @param caret - &id:oatpp::parser::Caret; over the BOB document. The caret is positioned after the value.
+   * @param stream - stream to write JSON to.
+   * @param maxFrameSize - max size of the decompressed frame (see &id:oatpp::bob::Codec::readFrame;).
+   * `0` - compressed frames are not accepted.
+   */
+  static void bobToJson(oatpp::parser::Caret& caret, ConsistentOutputStream* stream, v_buff_size maxFrameSize = 0);
+
+  /**
+   * Convert JSON value to BOB. <br>
+   * Integers are written with the smallest width which fits the value (`'8'` - for values above the `v_int64` range),
+   * other numbers - as 8-byte floats.
+   * @param caret - &id:oatpp::parser::Caret; over the JSON text. The caret is positioned after the value.
+   * @param stream - stream to write BOB to.
+   */
+  static void jsonToBob(oatpp::parser::Caret& caret, ConsistentOutputStream* stream);
+
+  /**
+   * Convert BOB document to JSON. Throws `oatpp::parser::ParsingError` on error.
+   * @param bob - BOB document.
+   * @param maxFrameSize - max size of the decompressed frame. `0` - compressed frames are not accepted.
+   * @return - JSON text.
+   */
+  static oatpp::String bobToJson(const oatpp::String& bob, v_buff_size maxFrameSize = 0);
+
+  /**
+   * Convert JSON text to BOB. Throws `oatpp::parser::ParsingError` on error.
+   * @param json - JSON text.
+   * @return - BOB document.
+   */
+  static oatpp::String jsonToBob(const oatpp::String& json);
+
+};
+
+}}
+
+#endif /* OATPP_BOB_TRANSCODER_HPP */
@@ -0,0 +1,184 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef OATPP_BOB_TYPECACHE_HPP
+#define OATPP_BOB_TYPECACHE_HPP
+
+#include "oatpp/core/Types.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace oatpp { namespace bob {
+
+/**
+ * Cache of per-type data (ex.: precomputed keys of DTO types). <br>
+ * Lookups are lock-free - the cache is an open-addressing table of pointers to immutable entries.
+ * Insertions take the lock and publish the new entry in a free slot. When the table gets half full it's replaced
+ * by the table of the double capacity, so the retired tables (kept for the concurrent readers) together are smaller than the current one. <br>
+ * Entries are retained till the cache is destroyed, thus returned pointers stay valid for the cache lifetime.
+ * @tparam T - type of cached data.
+ */
+template<class T>
+class TypeCache {
+public:
+  typedef oatpp::data::mapping::type::Type Type;
+private:
+
+  static constexpr v_buff_size INITIAL_CAPACITY = 16;
+
+  struct Entry {
+    const Type* type;
+    std::shared_ptr<T> value;
+    v_uint64 generation; // entries of the previous generations are dropped by clear()
+  };
+
+  struct Table {
+
+    Table(v_buff_size pCapacity)
+      : capacity(pCapacity)
+      , slots(new std::atomic<Entry*>[pCapacity])
+    {
+      for(v_buff_size i = 0; i < capacity; i ++) {
+        slots[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+
+    /*
+     * Slot of the entry for the type, or the free slot where it should be inserted.
+     * The table is never full, so the probing always stops.
+     */
+    std::atomic<Entry*>& findSlot(const Type* type) {
+      v_buff_size index = (v_buff_size) ((((v_uint64) (std::uintptr_t) type) * 0x9E3779B97F4A7C15ULL) >> 32) & (capacity - 1);
+      while(true) {
+        Entry* entry = slots[index].load(std::memory_order_acquire);
+        if(entry == nullptr || entry->type == type) {
+          return slots[index];
+        }
+        index = (index + 1) & (capacity - 1);
+      }
+    }
+
+    const v_buff_size capacity; // power of 2
+    std::unique_ptr<std::atomic<Entry*>[]> slots;
+
+  };
+
+private:
+  std::atomic<Table*> m_table;
+  std::atomic<v_uint64> m_generation;
+  std::mutex m_lock;
+  v_buff_size m_size; // occupied slots of the current table
+  std::vector<std::unique_ptr<Table>> m_tables; // current and retired tables
+  std::vector<std::unique_ptr<Entry>> m_entries;
+private:
+
+  Table* grow(Table* table) {
+    m_tables.emplace_back(new Table(table->capacity * 2));
+    Table* newTable = m_tables.back().get();
+    for(v_buff_size i = 0; i < table->capacity; i ++) {
+      Entry* entry = table->slots[i].load(std::memory_order_relaxed);
+      if(entry != nullptr) {
+        newTable->findSlot(entry->type).store(entry, std::memory_order_relaxed);
+      }
+    }
+    m_table.store(newTable, std::memory_order_release);
+    return newTable;
+  }
+
+public:
+
+  TypeCache()
+    : m_table(nullptr)
+    , m_generation(0)
+    , m_size(0)
+  {
+    m_tables.emplace_back(new Table(INITIAL_CAPACITY));
+    m_table.store(m_tables.back().get(), std::memory_order_release);
+  }
+
+  TypeCache(const TypeCache&) = delete;
+  TypeCache& operator=(const TypeCache&) = delete;
+
+  /**
+   * Get cached data for type. Create it with `create(type)` if not found.
+   * @param type - &id:oatpp::data::mapping::type::Type;.
+   * @param create - callable `std::shared_ptr<T>(const Type*)`.
+   * @return - pointer to cached data.
+   */
+  template<class F>
+  const T* get(const Type* type, const F& create) {
+
+    {
+      Entry* entry = m_table.load(std::memory_order_acquire)->findSlot(type).load(std::memory_order_acquire);
+      if(entry != nullptr && entry->generation == m_generation.load(std::memory_order_acquire)) {
+        return entry->value.get();
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    const v_uint64 generation = m_generation.load(std::memory_order_relaxed);
+    Table* table = m_table.load(std::memory_order_relaxed);
+    Entry* entry = table->findSlot(type).load(std::memory_order_relaxed);
+    if(entry != nullptr && entry->generation == generation) {
+      return entry->value.get();
+    }
+
+    std::shared_ptr<T> value = create(type);
+    m_entries.emplace_back(new Entry{type, value, generation});
+    Entry* newEntry = m_entries.back().get();
+
+    if(entry == nullptr) {
+      if((m_size + 1) * 2 > table->capacity) {
+        table = grow(table);
+      }
+      m_size ++;
+    }
+
+    table->findSlot(type).store(newEntry, std::memory_order_release); // replaces the entry of the previous generation
+
+    return value.get();
+
+  }
+
+  /**
+   * Drop all cached data. Previously returned pointers stay valid. <br>
+   * Entries are invalidated by the generation counter - nothing is allocated, and clearing the empty cache is free.
+   */
+  void clear() {
+    std::lock_guard<std::mutex> lock(m_lock);
+    if(m_size > 0) {
+      m_generation.fetch_add(1, std::memory_order_release);
+    }
+  }
+
+};
+
+}}
+
+#endif //OATPP_BOB_TYPECACHE_HPP
@@ -386,4 +386,90 @@ void Utils::writeFloat64(ConsistentOutputStream* stream, v_float64 value, BO_TYP
 
 }
 
+v_uint64 Utils::readVarUInt(oatpp::parser::Caret& caret) {
+
+  v_uint64 value = 0;
+  v_int32 shift = 0;
+
+  while(caret.canContinue()) {
+    v_uint8 byte = (v_uint8) caret.getCurrData()[0];
+    caret.inc();
+    value |= (v_uint64) (byte & 0x7F) << shift;
+    if((byte & 0x80) == 0) {
+      return value;
+    }
+    shift += 7;
+    if(shift > 63) {
+      break;
+    }
+  }
+
+  caret.setError("[oatpp::bob::readVarUInt]: Error. Invalid value.");
+  return 0;
+
+}
+
+void Utils::writeVarUInt(ConsistentOutputStream* stream, v_uint64 value) {
+  v_char8 buffer[10];
+  v_buff_size size = 0;
+  while(value >= 0x80) {
+    buffer[size ++] = (v_char8) (value | 0x80);
+    value >>= 7;
+  }
+  buffer[size ++] = (v_char8) value;
+  stream->writeSimple(buffer, size);
+}
+
+v_buff_size Utils::getVarUIntSize(v_uint64 value) {
+  v_buff_size size = 1;
+  while(value >= 0x80) {
+    value >>= 7;
+    size ++;
+  }
+  return size;
+}
+
+namespace {
+
+void appendTypeSignature(std::string& signature, const oatpp::data::mapping::type::Type* type) {
+  signature.append(type->classId.name);
+  if(type->nameQualifier) {
+    signature.push_back(':');
+    signature.append(type->nameQualifier);
+  }
+  if(!type->params.empty()) {
+    signature.push_back('<');
+    for(auto param : type->params) {
+      appendTypeSignature(signature, param);
+      signature.push_back(',');
+    }
+    signature.push_back('>');
+  }
+}
+
+}
+
+v_uint32 Utils::computeObjectFingerprint(const oatpp::data::mapping::type::Type* objectType) {
+
+  auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::AbstractObject::PolymorphicDispatcher*>(
+    objectType->polymorphicDispatcher
+  );
+
+  std::string signature;
+  for(auto const& property : dispatcher->getProperties()->getList()) {
+    signature.append(property->name);
+    signature.push_back(0);
+    appendTypeSignature(signature, property->type);
+    signature.push_back(0);
+  }
+
+  v_uint32 hash = 2166136261u;
+  for(char c : signature) {
+    hash ^= (v_uint8) c;
+    hash *= 16777619u;
+  }
+  return hash;
+
+}
+
 }}
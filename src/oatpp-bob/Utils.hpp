@@ -39,6 +39,7 @@ public:
   static constexpr const v_char8 TYPE_STRING_1 = 's'; // string length 1 byte
   static constexpr const v_char8 TYPE_STRING_2 = 'S'; // string length 2 bytes
   static constexpr const v_char8 TYPE_STRING_4 = '$'; // string length 4 bytes;
+  static constexpr const v_char8 TYPE_STRING_REFERENCE = '@'; // reference to the previous occurrence of the same string
 
   static constexpr const v_char8 TYPE_BOOL_FALSE = '-';
   static constexpr const v_char8 TYPE_BOOL_TRUE = '+';
@@ -59,6 +60,19 @@ public:
   static constexpr const v_char8 CONTROL_ARRAY_BEGIN = '[';
   static constexpr const v_char8 CONTROL_SECTION_END = ')'; // end of a map or end of an array
 
+  static constexpr const v_char8 CONTROL_MAP_SIZED = 'M'; // map with the 4-byte size and the 4-byte count of pairs
+  static constexpr const v_char8 CONTROL_ARRAY_SIZED = 'A'; // array with the 4-byte size and the 4-byte count of elements
+  static constexpr const v_char8 CONTROL_ARRAY_INDEXED = 'X'; // sized array with the trailing table of element offsets
+  static constexpr const v_buff_size SIZED_CONTAINER_HEADER_SIZE = 9; // tag + size + count
+
+  static constexpr const v_char8 KEY_REFERENCE = 0xFF; // key is a reference to the previous occurrence of the same key
+
+  static constexpr const v_char8 CONTROL_COLUMNS_BEGIN = 'C'; // array of objects stored column-wise
+  static constexpr const v_char8 COLUMN_VALUES = '*'; // column of regular values
+
+  static constexpr const v_char8 CONTROL_OBJECT_POSITIONAL = 'P'; // object values in property order, identified by the schema fingerprint
+  static constexpr const v_char8 CONTROL_OBJECT_IDS = '#'; // object with numeric field ids instead of keys
+
 public:
   typedef oatpp::data::stream::ConsistentOutputStream ConsistentOutputStream;
   typedef oatpp::data::share::StringKeyLabel StringKeyLabel;
@@ -104,6 +118,34 @@ public:
   static v_float64 readFloat64(oatpp::parser::Caret& caret, BO_TYPE readBO);
   static void writeFloat64(ConsistentOutputStream* stream, v_float64 value, BO_TYPE writeBO);
 
+  /**
+   * Read variable-length unsigned integer (7 bits per byte, least significant group first).
+   * @param caret
+   * @return
+   */
+  static v_uint64 readVarUInt(oatpp::parser::Caret& caret);
+
+  /**
+   * Write variable-length unsigned integer (7 bits per byte, least significant group first).
+   * @param stream
+   * @param value
+   */
+  static void writeVarUInt(ConsistentOutputStream* stream, v_uint64 value);
+
+  /**
+   * Get number of bytes the variable-length unsigned integer is written to.
+   * @param value
+   * @return
+   */
+  static v_buff_size getVarUIntSize(v_uint64 value);
+
+  /**
+   * Compute fingerprint of the DTO schema - names and types of the properties in declaration order (32-bit FNV-1a).
+   * @param objectType - DTO type.
+   * @return
+   */
+  static v_uint32 computeObjectFingerprint(const oatpp::data::mapping::type::Type* objectType);
+
 };
 
 }}
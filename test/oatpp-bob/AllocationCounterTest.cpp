@@ -0,0 +1,168 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "AllocationCounterTest.hpp"
+
+#include "oatpp-bob/ObjectMapper.hpp"
+
+#include "oatpp/core/data/stream/BufferStream.hpp"
+
+#include "oatpp/core/macro/codegen.hpp"
+
+namespace oatpp { namespace bob { namespace test {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class ChildDto : public oatpp::DTO {
+
+  DTO_INIT(ChildDto, DTO)
+
+  DTO_FIELD(String, name);
+
+};
+
+class ParentDto : public oatpp::DTO {
+
+  DTO_INIT(ParentDto, DTO)
+
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, name);
+  DTO_FIELD(List<Int64>, values);
+  DTO_FIELD(Object<ChildDto>, child);
+  DTO_FIELD(Any, payload);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::Vector<oatpp::Object<ChildDto>> createChildren(v_int32 count) {
+  oatpp::Vector<oatpp::Object<ChildDto>> children({});
+  for(v_int32 i = 0; i < count; i ++) {
+    auto child = ChildDto::createShared();
+    child->name = "child-" + std::to_string(i);
+    children->push_back(child);
+  }
+  return children;
+}
+
+}
+
+void AllocationCounterTest::onRun() {
+
+  typedef oatpp::bob::AllocationCounter AC;
+
+  oatpp::bob::ObjectMapper mapper;
+
+  auto parent = ParentDto::createShared();
+  parent->id = 1;
+  parent->name = "parent";
+  parent->values = {1, 2, 3};
+  parent->child = ChildDto::createShared();
+  parent->child->name = "child";
+  parent->payload = oatpp::String("payload");
+
+  {
+    OATPP_LOGD(TAG, "Deserialize - values by category")
+    auto bob = mapper.writeToString(parent);
+    AC::Scope scope;
+    auto clone = mapper.readFromString<oatpp::Object<ParentDto>>(bob);
+    const auto& counters = scope.getCounters();
+    OATPP_ASSERT(counters.count[AC::STRINGS] == 3)
+    OATPP_ASSERT(counters.count[AC::PRIMITIVES] == 4)
+    OATPP_ASSERT(counters.count[AC::OBJECTS] == 2)
+    OATPP_ASSERT(counters.count[AC::COLLECTIONS] == 1)
+    OATPP_ASSERT(counters.count[AC::ANY_HANDLES] == 1)
+    OATPP_ASSERT(counters.count[AC::BUFFERS] == 0)
+    OATPP_ASSERT(counters.getTotalCount() == 11)
+    OATPP_ASSERT(counters.bytes[AC::STRINGS] >= 18)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Budget per payload shape")
+    auto children = createChildren(100);
+    auto bob = mapper.writeToString(children);
+    AC::Scope scope;
+    auto clone = mapper.readFromString<oatpp::Vector<oatpp::Object<ChildDto>>>(bob);
+    OATPP_ASSERT(clone->size() == 100)
+    OATPP_ASSERT(scope.getCounters().getTotalCount() <= 201) // 100 objects, 100 strings and the vector
+  }
+
+  {
+    OATPP_LOGD(TAG, "Serializer buffers")
+    auto children = createChildren(10);
+
+    AC::Scope outer;
+    {
+      AC::Scope scope;
+      mapper.writeToString(children);
+      OATPP_ASSERT(scope.getCounters().getTotalCount() == 0)
+    }
+
+    auto serializerConfig = oatpp::bob::Serializer::Config::createShared();
+    serializerConfig->columnarObjectVectors = true;
+    oatpp::bob::ObjectMapper columnarMapper(serializerConfig, oatpp::bob::Deserializer::Config::createShared());
+    {
+      oatpp::data::stream::BufferOutputStream stream;
+      AC::Scope scope;
+      columnarMapper.write(&stream, children);
+      OATPP_ASSERT(scope.getCounters().count[AC::BUFFERS] == 1)
+      AC::onHeapAllocation(16);
+      OATPP_ASSERT(scope.getCounters().heapCount == 1 && scope.getCounters().heapBytes == 16)
+    }
+
+    /* inner scopes are added to the outer one */
+    OATPP_ASSERT(outer.getCounters().count[AC::BUFFERS] == 1)
+    OATPP_ASSERT(outer.getCounters().heapCount == 1)
+    outer.reset();
+    OATPP_ASSERT(outer.getCounters().heapCount == 0)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Deserialize - string references")
+    oatpp::Vector<oatpp::Object<ChildDto>> children({});
+    for(v_int32 i = 0; i < 10; i ++) {
+      auto child = ChildDto::createShared();
+      child->name = "repeated-name";
+      children->push_back(child);
+    }
+
+    auto serializerConfig = oatpp::bob::Serializer::Config::createShared();
+    serializerConfig->stringDedupTableSize = 64;
+    oatpp::bob::ObjectMapper dedupMapper(serializerConfig, oatpp::bob::Deserializer::Config::createShared());
+    auto bob = dedupMapper.writeToString(children);
+
+    AC::Scope scope;
+    auto clone = dedupMapper.readFromString<oatpp::Vector<oatpp::Object<ChildDto>>>(bob);
+    OATPP_ASSERT(clone->size() == 10)
+    OATPP_ASSERT(clone[9]->name == "repeated-name")
+    /* the plain occurrence plus one string shared by all 9 references */
+    OATPP_ASSERT(scope.getCounters().count[AC::STRINGS] == 2)
+    OATPP_ASSERT(clone[1]->name.get() == clone[9]->name.get())
+  }
+
+}
+
+}}}
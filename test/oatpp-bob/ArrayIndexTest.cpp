@@ -0,0 +1,152 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "ArrayIndexTest.hpp"
+
+#include "oatpp-bob/ObjectMapper.hpp"
+
+#include "oatpp/core/macro/codegen.hpp"
+
+#include <limits>
+
+namespace oatpp { namespace bob { namespace test {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class RecordDto : public oatpp::DTO {
+
+  DTO_INIT(RecordDto, DTO)
+
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, name);
+  DTO_FIELD(String, group);
+
+};
+
+class PageDto : public oatpp::DTO {
+
+  DTO_INIT(PageDto, DTO)
+
+  DTO_FIELD(Vector<Object<RecordDto>>, records);
+  DTO_FIELD(String, cursor);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::Vector<oatpp::Object<RecordDto>> createRecords(v_int32 count) {
+  oatpp::Vector<oatpp::Object<RecordDto>> records({});
+  for(v_int32 i = 0; i < count; i ++) {
+    auto record = RecordDto::createShared();
+    record->id = i;
+    record->name = "record-" + std::to_string(i);
+    record->group = "group-" + std::to_string(i % 5);
+    records->push_back(record);
+  }
+  return records;
+}
+
+void checkSlice(const oatpp::Vector<oatpp::Object<RecordDto>>& slice, v_int32 offset, v_int32 count) {
+  OATPP_ASSERT(slice->size() == count)
+  for(v_int32 i = 0; i < count; i ++) {
+    OATPP_ASSERT(slice[i]->id == offset + i)
+    OATPP_ASSERT(slice[i]->name == "record-" + std::to_string(offset + i))
+    OATPP_ASSERT(slice[i]->group == "group-" + std::to_string((offset + i) % 5))
+  }
+}
+
+}
+
+void ArrayIndexTest::onRun() {
+
+  typedef oatpp::Vector<oatpp::Object<RecordDto>> Records;
+
+  auto records = createRecords(1000);
+
+  oatpp::bob::ObjectMapper mapper;
+  auto plainBob = mapper.writeToString(records);
+
+  for(v_int32 stride : {1, 16}) {
+
+    OATPP_LOGD(TAG, "stride=%d", stride)
+
+    auto config = oatpp::bob::Serializer::Config::createShared();
+    config->arrayIndexThreshold = 100;
+    config->arrayIndexStride = stride;
+    oatpp::bob::ObjectMapper indexedMapper(config, oatpp::bob::Deserializer::Config::createShared());
+
+    auto bob = indexedMapper.writeToString(records);
+    OATPP_ASSERT(bob->data()[0] == 'X')
+    OATPP_ASSERT(indexedMapper.getSerializer()->computeSize(records) == bob->size())
+
+    checkSlice(mapper.readSliceFromString<Records>(bob, 500, 50), 500, 50);
+    checkSlice(mapper.readSliceFromString<Records>(bob, 0, 3), 0, 3);
+    checkSlice(mapper.readSliceFromString<Records>(bob, 990, 50), 990, 10);
+    checkSlice(mapper.readSliceFromString<Records>(bob, 2000, 50), 0, 0);
+    checkSlice(mapper.readSliceFromString<Records>(bob, 990, std::numeric_limits<v_buff_size>::max()), 990, 10);
+    checkSlice(mapper.readFromString<Records>(bob), 0, 1000);
+
+    /* index is written for large collections only */
+    auto small = indexedMapper.writeToString(createRecords(10));
+    OATPP_ASSERT(small == mapper.writeToString(createRecords(10)))
+
+    /* nested */
+    auto page = PageDto::createShared();
+    page->records = records;
+    page->cursor = "next";
+    auto pageBob = indexedMapper.writeToString(page);
+    auto clone = mapper.readFromString<oatpp::Object<PageDto>>(pageBob);
+    OATPP_ASSERT(clone->cursor == "next")
+    checkSlice(clone->records, 0, 1000);
+
+    /* parallel serialization produces the same index */
+    config->parallelThreads = 4;
+    config->parallelCollectionThreshold = 100;
+    oatpp::bob::ObjectMapper parallelMapper(config, oatpp::bob::Deserializer::Config::createShared());
+    OATPP_ASSERT(parallelMapper.writeToString(records) == bob)
+
+  }
+
+  {
+    OATPP_LOGD(TAG, "Arrays without index")
+    checkSlice(mapper.readSliceFromString<Records>(plainBob, 500, 50), 500, 50);
+    checkSlice(mapper.readSliceFromString<Records>(plainBob, 990, 50), 990, 10);
+    checkSlice(mapper.readSliceFromString<Records>(plainBob, 990, std::numeric_limits<v_buff_size>::max()), 990, 10);
+  }
+
+  {
+    OATPP_LOGD(TAG, "String references")
+    auto config = oatpp::bob::Serializer::Config::createShared();
+    config->arrayIndexThreshold = 100;
+    config->stringDedupTableSize = 64;
+    oatpp::bob::ObjectMapper dedupMapper(config, oatpp::bob::Deserializer::Config::createShared());
+    auto bob = dedupMapper.writeToString(records);
+    checkSlice(mapper.readSliceFromString<Records>(bob, 700, 20), 700, 20);
+  }
+
+}
+
+}}}
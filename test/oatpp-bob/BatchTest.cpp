@@ -0,0 +1,130 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "BatchTest.hpp"
+
+#include "oatpp-bob/ObjectMapper.hpp"
+
+#include "oatpp/core/macro/codegen.hpp"
+
+namespace oatpp { namespace bob { namespace test {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class MessageDto : public oatpp::DTO {
+
+  DTO_INIT(MessageDto, DTO)
+
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, topic);
+  DTO_FIELD(Fields<String>, headers);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+std::vector<oatpp::Void> createMessages(v_int32 count) {
+  std::vector<oatpp::Void> result;
+  for(v_int32 i = 0; i < count; i ++) {
+    auto message = MessageDto::createShared();
+    message->id = i;
+    message->topic = "topic-" + std::to_string(i % 3);
+    message->headers = {{"content-type", "text/plain"}, {"encoding", "identity"}};
+    result.push_back(message);
+  }
+  return result;
+}
+
+void checkMessages(const std::vector<oatpp::Object<MessageDto>>& messages, v_int32 count) {
+  OATPP_ASSERT(messages.size() == (size_t) count)
+  for(v_int32 i = 0; i < count; i ++) {
+    OATPP_ASSERT(messages[i]->id == i)
+    OATPP_ASSERT(messages[i]->topic == "topic-" + std::to_string(i % 3))
+    OATPP_ASSERT(messages[i]->headers[1].second == "identity")
+  }
+}
+
+}
+
+void BatchTest::onRun() {
+
+  auto messages = createMessages(1000);
+
+  {
+    OATPP_LOGD(TAG, "Plain batch")
+    oatpp::bob::ObjectMapper mapper;
+    auto data = mapper.writeManyToString(messages);
+    checkMessages(mapper.readManyFromString<oatpp::Object<MessageDto>>(data), 1000);
+  }
+
+  {
+    OATPP_LOGD(TAG, "Documents are self-contained")
+    auto config = oatpp::bob::Serializer::Config::createShared();
+    config->useKeyTable = true;
+    config->stringDedupTableSize = 64;
+    config->sizedContainers = true;
+    oatpp::bob::ObjectMapper mapper(config, oatpp::bob::Deserializer::Config::createShared());
+
+    auto data = mapper.writeManyToString(messages);
+
+    std::string expected;
+    for(auto& message : messages) {
+      expected += *mapper.writeToString(message);
+    }
+    OATPP_ASSERT(*data == expected)
+
+    checkMessages(mapper.readManyFromString<oatpp::Object<MessageDto>>(data), 1000);
+
+    oatpp::data::stream::BufferOutputStream stream;
+    mapper.writeMany(&stream, messages);
+    OATPP_ASSERT(stream.toString() == data)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Compressed batch")
+    oatpp::bob::ObjectMapper mapper;
+    mapper.setCompression(std::make_shared<oatpp::bob::LzCodec>());
+    auto data = mapper.writeManyToString(messages);
+    OATPP_ASSERT(data->data()[0] == 'Z')
+    checkMessages(mapper.readManyFromString<oatpp::Object<MessageDto>>(data), 1000);
+  }
+
+  {
+    OATPP_LOGD(TAG, "Errors")
+    oatpp::bob::ObjectMapper mapper;
+    auto data = mapper.writeManyToString(messages);
+    bool failed = false;
+    try {
+      mapper.readManyFromString<oatpp::Object<MessageDto>>(oatpp::String(data->data(), data->size() - 1));
+    } catch (const oatpp::parser::ParsingError&) {
+      failed = true;
+    }
+    OATPP_ASSERT(failed)
+  }
+
+}
+
+}}}
@@ -0,0 +1,115 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "BufferPoolTest.hpp"
+
+#include "oatpp-bob/ObjectMapper.hpp"
+
+#include "oatpp/core/macro/codegen.hpp"
+
+#include <thread>
+
+namespace oatpp { namespace bob { namespace test {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class ItemDto : public oatpp::DTO {
+
+  DTO_INIT(ItemDto, DTO)
+
+  DTO_FIELD(Int64, id);
+  DTO_FIELD(String, name);
+  DTO_FIELD(Vector<Float64>, values);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::Object<ItemDto> createItem(v_int32 id, v_int32 valuesCount) {
+  auto item = ItemDto::createShared();
+  item->id = id;
+  item->name = "item-" + std::to_string(id);
+  item->values = oatpp::Vector<oatpp::Float64>::createShared();
+  for(v_int32 i = 0; i < valuesCount; i ++) {
+    item->values->push_back(i * 0.5);
+  }
+  return item;
+}
+
+void checkPooled(const oatpp::bob::ObjectMapper& pooled, const oatpp::bob::ObjectMapper& plain) {
+  /* small, huge (grows the buffer past the trim capacity), then small again */
+  for(v_int32 valuesCount : {10, 10, 200000, 10, 1000, 10}) {
+    auto item = createItem(valuesCount, valuesCount);
+    OATPP_ASSERT(pooled.writeToString(item) == plain.writeToString(item))
+  }
+  oatpp::Vector<oatpp::Object<ItemDto>> items({createItem(1, 1), createItem(2, 2)});
+  OATPP_ASSERT(pooled.writeToString(items) == plain.writeToString(items))
+  OATPP_ASSERT(pooled.writeToString(oatpp::String("text")) == plain.writeToString(oatpp::String("text")))
+}
+
+}
+
+void BufferPoolTest::onRun() {
+
+  oatpp::bob::ObjectMapper plain;
+  oatpp::bob::ObjectMapper pooled;
+  pooled.setBufferPooling(true);
+  OATPP_ASSERT(pooled.isBufferPooling())
+
+  {
+    OATPP_LOGD(TAG, "Single thread")
+    checkPooled(pooled, plain);
+    auto clone = pooled.readFromString<oatpp::Object<ItemDto>>(pooled.writeToString(createItem(7, 100)));
+    OATPP_ASSERT(clone->id == 7)
+    OATPP_ASSERT(clone->values->size() == 100)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Multiple threads")
+    std::vector<std::thread> threads;
+    for(v_int32 i = 0; i < 4; i ++) {
+      threads.push_back(std::thread([&pooled, &plain] {
+        checkPooled(pooled, plain);
+      }));
+    }
+    for(auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  {
+    OATPP_LOGD(TAG, "Pooled compression")
+    oatpp::bob::ObjectMapper compressed;
+    compressed.setCompression(std::make_shared<oatpp::bob::LzCodec>());
+    compressed.setBufferPooling(true);
+    auto item = createItem(1, 1000);
+    auto clone = compressed.readFromString<oatpp::Object<ItemDto>>(compressed.writeToString(item));
+    OATPP_ASSERT(clone->values->size() == 1000)
+  }
+
+}
+
+}}}
@@ -0,0 +1,205 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "ColumnarTest.hpp"
+
+#include "oatpp-bob/ObjectMapper.hpp"
+
+#include "oatpp/core/macro/codegen.hpp"
+
+namespace oatpp { namespace bob { namespace test {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class PointDto : public oatpp::DTO {
+
+  DTO_INIT(PointDto, DTO)
+
+  DTO_FIELD(Int8, i8);
+  DTO_FIELD(UInt16, u16);
+  DTO_FIELD(Int32, i32);
+  DTO_FIELD(Int64, i64);
+  DTO_FIELD(Float32, f32);
+  DTO_FIELD(Float64, f64);
+  DTO_FIELD(Boolean, flag);
+  DTO_FIELD(String, label);
+  DTO_FIELD(Vector<Int32>, tags);
+
+};
+
+class NarrowPointDto : public oatpp::DTO {
+
+  DTO_INIT(NarrowPointDto, DTO)
+
+  DTO_FIELD(Int64, i32);
+  DTO_FIELD(String, label);
+
+};
+
+class EmptyDto : public oatpp::DTO {
+
+  DTO_INIT(EmptyDto, DTO)
+
+};
+
+class SeriesDto : public oatpp::DTO {
+
+  DTO_INIT(SeriesDto, DTO)
+
+  DTO_FIELD(String, name);
+  DTO_FIELD(Vector<Object<PointDto>>, points);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::Vector<oatpp::Object<PointDto>> createPoints(v_int32 count) {
+  oatpp::Vector<oatpp::Object<PointDto>> points({});
+  for(v_int32 i = 0; i < count; i ++) {
+    auto point = PointDto::createShared();
+    point->i8 = (v_int8) (i - 50);
+    point->u16 = (v_uint16) (i * 300);
+    point->i32 = i * -100000;
+    if(i % 5 != 0) {
+      point->i64 = (v_int64) i << 40;
+    }
+    point->f32 = 0.5f * i;
+    point->f64 = 0.25 * i;
+    point->flag = (i % 3 == 0);
+    if(i % 7 != 0) {
+      point->label = "label-" + std::to_string(i);
+    }
+    point->tags = {i, i + 1};
+    points->push_back(point);
+  }
+  return points;
+}
+
+}
+
+void ColumnarTest::onRun() {
+
+  auto serializerConfig = oatpp::bob::Serializer::Config::createShared();
+  serializerConfig->columnarObjectVectors = true;
+  auto deserializerConfig = oatpp::bob::Deserializer::Config::createShared();
+  deserializerConfig->allowUnknownFields = true;
+
+  oatpp::bob::ObjectMapper mapper;
+  oatpp::bob::ObjectMapper columnarMapper(serializerConfig, deserializerConfig);
+
+  auto points = createPoints(100);
+
+  auto bob = mapper.writeToString(points);
+  auto columnarBob = columnarMapper.writeToString(points);
+  OATPP_LOGD(TAG, "size=%d, columnar size=%d", (v_int32) bob->size(), (v_int32) columnarBob->size())
+  OATPP_ASSERT(columnarBob->size() < bob->size())
+  OATPP_ASSERT(columnarBob->data()[0] == 'C')
+
+  {
+    OATPP_LOGD(TAG, "Round trip")
+    auto clone = mapper.readFromString<oatpp::Vector<oatpp::Object<PointDto>>>(columnarBob);
+    OATPP_ASSERT(clone->size() == points->size())
+    for(v_int32 i = 0; i < points->size(); i ++) {
+      auto& a = points[i];
+      auto& b = clone[i];
+      OATPP_ASSERT(a->i8 == b->i8)
+      OATPP_ASSERT(a->u16 == b->u16)
+      OATPP_ASSERT(a->i32 == b->i32)
+      OATPP_ASSERT(a->i64 == b->i64)
+      OATPP_ASSERT(a->f32 == b->f32)
+      OATPP_ASSERT(a->f64 == b->f64)
+      OATPP_ASSERT(a->flag == b->flag)
+      OATPP_ASSERT(a->label == b->label)
+      OATPP_ASSERT(b->tags->size() == 2 && b->tags[1] == i + 1)
+    }
+  }
+
+  {
+    OATPP_LOGD(TAG, "Nested, as List, with conversion and unknown fields")
+    auto series = SeriesDto::createShared();
+    series->name = "series";
+    series->points = points;
+    auto seriesBob = columnarMapper.writeToString(series);
+    auto clone = columnarMapper.readFromString<oatpp::Object<SeriesDto>>(seriesBob);
+    OATPP_ASSERT(clone->points->size() == 100)
+    OATPP_ASSERT(clone->points[99]->label == "label-99")
+
+    auto narrow = columnarMapper.readFromString<oatpp::List<oatpp::Object<NarrowPointDto>>>(columnarBob);
+    OATPP_ASSERT(narrow->size() == 100)
+    OATPP_ASSERT(narrow->back()->i32 == 99 * -100000)
+    OATPP_ASSERT(narrow->front()->label == nullptr)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Any")
+    auto any = mapper.readFromString<oatpp::Any>(columnarBob);
+    auto rows = any.retrieve<oatpp::Vector<oatpp::Fields<oatpp::Any>>>();
+    OATPP_ASSERT(rows->size() == 100)
+    OATPP_ASSERT(rows[3]["label"].retrieve<oatpp::String>() == "label-3")
+    OATPP_ASSERT(rows[3]["flag"].retrieve<oatpp::Boolean>() == true)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Vector with null element is written row-wise")
+    auto withNull = createPoints(3);
+    withNull->push_back(nullptr);
+    auto result = columnarMapper.writeToString(withNull);
+    OATPP_ASSERT(result == mapper.writeToString(withNull))
+  }
+
+  {
+    OATPP_LOGD(TAG, "Vector of objects without fields is written row-wise")
+    oatpp::Vector<oatpp::Object<EmptyDto>> empty({EmptyDto::createShared(), EmptyDto::createShared()});
+    auto result = columnarMapper.writeToString(empty);
+    OATPP_ASSERT(result == mapper.writeToString(empty))
+    OATPP_ASSERT(columnarMapper.readFromString<oatpp::Vector<oatpp::Object<EmptyDto>>>(result)->size() == 2)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Invalid headers")
+    oatpp::String noColumns("C\xFF\xFF\xFF\x7F\x00)", 7);
+    oatpp::String shortBitmap("C\x64\x01i32\x00" "4\x00\x00\x00\x01\x01)", 14);
+    for(auto& data : {noColumns, shortBitmap}) {
+      bool failed = false;
+      try {
+        mapper.readFromString<oatpp::Vector<oatpp::Object<PointDto>>>(data);
+      } catch (const oatpp::parser::ParsingError&) {
+        failed = true;
+      }
+      OATPP_ASSERT(failed)
+    }
+    bool failed = false;
+    try {
+      mapper.readFromString<oatpp::Vector<oatpp::UnorderedMap<oatpp::Int32, oatpp::Any>>>(columnarBob);
+    } catch (const oatpp::parser::ParsingError&) {
+      failed = true;
+    }
+    OATPP_ASSERT(failed)
+  }
+
+}
+
+}}}
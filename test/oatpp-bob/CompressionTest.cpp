@@ -0,0 +1,218 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "CompressionTest.hpp"
+
+#include "oatpp-bob/ObjectMapper.hpp"
+#include "oatpp-bob/Stream.hpp"
+
+#include "oatpp/core/data/stream/BufferStream.hpp"
+
+#include "oatpp/core/macro/codegen.hpp"
+
+namespace oatpp { namespace bob { namespace test {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class EventDto : public oatpp::DTO {
+
+  DTO_INIT(EventDto, DTO)
+
+  DTO_FIELD(Int64, id);
+  DTO_FIELD(String, source);
+  DTO_FIELD(String, message);
+  DTO_FIELD(Fields<String>, labels);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::Vector<oatpp::Object<EventDto>> createEvents(v_int32 count) {
+  oatpp::Vector<oatpp::Object<EventDto>> events({});
+  for(v_int32 i = 0; i < count; i ++) {
+    auto event = EventDto::createShared();
+    event->id = i;
+    event->source = "replica-" + std::to_string(i % 4);
+    event->message = "record " + std::to_string(i) + " was replicated successfully";
+    event->labels = {{"region", "eu-west"}, {"tier", "gold"}};
+    events->push_back(event);
+  }
+  return events;
+}
+
+void checkEvents(const oatpp::Vector<oatpp::Object<EventDto>>& events, v_int32 count) {
+  OATPP_ASSERT(events->size() == count)
+  for(v_int32 i = 0; i < count; i ++) {
+    OATPP_ASSERT(events[i]->id == i)
+    OATPP_ASSERT(events[i]->source == "replica-" + std::to_string(i % 4))
+    OATPP_ASSERT(events[i]->message == "record " + std::to_string(i) + " was replicated successfully")
+    OATPP_ASSERT(events[i]->labels["tier"] == "gold")
+  }
+}
+
+void checkCodec(const std::shared_ptr<oatpp::bob::Codec>& codec, const oatpp::String& data) {
+  std::string compressed(codec->getMaxCompressedSize(data->size()), '\0');
+  auto size = codec->compress(data->data(), data->size(), &compressed[0], compressed.size());
+  OATPP_ASSERT(size > 0 && size < data->size())
+  std::string decompressed(data->size(), '\0');
+  auto result = codec->decompress(compressed.data(), size, &decompressed[0], decompressed.size());
+  OATPP_ASSERT(result == data->size())
+  OATPP_ASSERT(decompressed == *data)
+}
+
+}
+
+void CompressionTest::onRun() {
+
+  auto events = createEvents(5000);
+
+  oatpp::bob::ObjectMapper mapper;
+  auto bob = mapper.writeToString(events);
+
+  {
+    OATPP_LOGD(TAG, "Codecs")
+    checkCodec(std::make_shared<oatpp::bob::LzCodec>(), bob);
+#ifdef OATPP_BOB_WITH_ZLIB
+    checkCodec(std::make_shared<oatpp::bob::ZlibCodec>(), bob);
+#endif
+#ifdef OATPP_BOB_WITH_ZSTD
+    checkCodec(std::make_shared<oatpp::bob::ZstdCodec>(), bob);
+#endif
+  }
+
+  {
+    OATPP_LOGD(TAG, "Incompressible data")
+    oatpp::bob::LzCodec codec;
+    std::string data;
+    v_uint32 seed = 12345;
+    for(v_int32 i = 0; i < 1000; i ++) {
+      seed = seed * 1103515245 + 12345;
+      data.push_back((char) (seed >> 16));
+    }
+    std::string compressed(codec.getMaxCompressedSize(data.size()), '\0');
+    auto size = codec.compress(data.data(), data.size(), &compressed[0], compressed.size());
+    std::string decompressed(data.size(), '\0');
+    OATPP_ASSERT(codec.decompress(compressed.data(), size, &decompressed[0], decompressed.size()) == (v_buff_size) data.size())
+    OATPP_ASSERT(decompressed == data)
+  }
+
+  oatpp::bob::ObjectMapper compressedMapper;
+  compressedMapper.setCompression(std::make_shared<oatpp::bob::LzCodec>(), 4096);
+
+  auto compressedBob = compressedMapper.writeToString(events);
+  OATPP_LOGD(TAG, "size=%d, compressed size=%d", (v_int32) bob->size(), (v_int32) compressedBob->size())
+  OATPP_ASSERT(compressedBob->size() < bob->size() / 2)
+  OATPP_ASSERT(compressedBob->data()[0] == 'Z')
+
+  {
+    OATPP_LOGD(TAG, "Round trip")
+    checkEvents(compressedMapper.readFromString<oatpp::Vector<oatpp::Object<EventDto>>>(compressedBob), 5000);
+    /* reading of frames is opt-in */
+    oatpp::bob::ObjectMapper decompressingMapper;
+    decompressingMapper.setDecompression(true);
+    checkEvents(decompressingMapper.readFromString<oatpp::Vector<oatpp::Object<EventDto>>>(compressedBob), 5000);
+    bool failed = false;
+    try {
+      mapper.readFromString<oatpp::Vector<oatpp::Object<EventDto>>>(compressedBob);
+    } catch (...) {
+      failed = true;
+    }
+    OATPP_ASSERT(failed)
+    /* uncompressed data is still readable */
+    checkEvents(compressedMapper.readFromString<oatpp::Vector<oatpp::Object<EventDto>>>(bob), 5000);
+  }
+
+  {
+    OATPP_LOGD(TAG, "Small and empty documents")
+    auto small = compressedMapper.writeToString(oatpp::String("hello"));
+    OATPP_ASSERT(compressedMapper.readFromString<oatpp::String>(small) == "hello")
+    auto empty = compressedMapper.writeToString(oatpp::Vector<oatpp::Int32>({}));
+    OATPP_ASSERT(compressedMapper.readFromString<oatpp::Vector<oatpp::Int32>>(empty)->size() == 0)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Invalid frames")
+    oatpp::String truncated(compressedBob->data(), compressedBob->size() / 2);
+    oatpp::String unknownCodec("Z\x7F\x00", 3);
+    oatpp::String emptyBlock("Z\x01\x80\x80\x04\x00\x00", 7); // 64 KB block with no data
+    for(auto& frame : {truncated, unknownCodec, emptyBlock}) {
+      bool failed = false;
+      try {
+        compressedMapper.readFromString<oatpp::Vector<oatpp::Object<EventDto>>>(frame);
+      } catch (...) {
+        failed = true;
+      }
+      OATPP_ASSERT(failed)
+    }
+  }
+
+  {
+    OATPP_LOGD(TAG, "Frame size limit")
+    oatpp::bob::ObjectMapper limitedMapper;
+    limitedMapper.setDecompression(true, bob->size() - 1);
+    bool failed = false;
+    try {
+      limitedMapper.readFromString<oatpp::Vector<oatpp::Object<EventDto>>>(compressedBob);
+    } catch (...) {
+      failed = true;
+    }
+    OATPP_ASSERT(failed)
+    limitedMapper.setDecompression(true, bob->size());
+    checkEvents(limitedMapper.readFromString<oatpp::Vector<oatpp::Object<EventDto>>>(compressedBob), 5000);
+  }
+
+  {
+    OATPP_LOGD(TAG, "Block size validation")
+    auto codec = std::make_shared<oatpp::bob::LzCodec>();
+    oatpp::data::stream::BufferOutputStream stream;
+    for(v_buff_size blockSize : {(v_buff_size) 0, (v_buff_size) -1, oatpp::bob::Codec::MAX_BLOCK_SIZE + 1}) {
+      oatpp::bob::ObjectMapper invalidMapper;
+      bool mapperFailed = false;
+      try {
+        invalidMapper.setCompression(codec, blockSize);
+      } catch (const std::invalid_argument&) {
+        mapperFailed = true;
+      }
+      OATPP_ASSERT(mapperFailed)
+      OATPP_ASSERT(invalidMapper.getCompression() == nullptr)
+      bool streamFailed = false;
+      try {
+        oatpp::bob::CompressingOutputStream compressingStream(&stream, codec, blockSize);
+      } catch (const std::invalid_argument&) {
+        streamFailed = true;
+      }
+      OATPP_ASSERT(streamFailed)
+    }
+    /* the largest block is still readable */
+    oatpp::bob::ObjectMapper largeBlockMapper;
+    largeBlockMapper.setCompression(codec, oatpp::bob::Codec::MAX_BLOCK_SIZE);
+    auto largeBlockBob = largeBlockMapper.writeToString(events);
+    checkEvents(largeBlockMapper.readFromString<oatpp::Vector<oatpp::Object<EventDto>>>(largeBlockBob), 5000);
+  }
+
+}
+
+}}}
@@ -0,0 +1,112 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "EnumTest.hpp"
+
+#include "oatpp-bob/ObjectMapper.hpp"
+
+#include "oatpp/core/macro/codegen.hpp"
+
+namespace oatpp { namespace bob { namespace test {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+ENUM(Color, v_int32,
+  VALUE(RED, 10, "color-red"),
+  VALUE(GREEN, 20, "color-green"),
+  VALUE(BLUE, 30, "color-blue")
+)
+
+class EnumDto : public oatpp::DTO {
+
+  DTO_INIT(EnumDto, DTO)
+
+  DTO_FIELD(Enum<Color>::AsString, colorStr);
+  DTO_FIELD(Enum<Color>::AsNumber, colorNum);
+  DTO_FIELD(Enum<Color>::AsString, colorNull);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+}
+
+void EnumTest::onRun() {
+
+  auto dto = EnumDto::createShared();
+  dto->colorStr = Color::BLUE;
+  dto->colorNum = Color::GREEN;
+
+  oatpp::bob::ObjectMapper mapper;
+
+  auto serializerConfig = oatpp::bob::Serializer::Config::createShared();
+  serializerConfig->enumsAsOrdinals = true;
+  auto deserializerConfig = oatpp::bob::Deserializer::Config::createShared();
+  deserializerConfig->enumsAsOrdinals = true;
+  oatpp::bob::ObjectMapper ordinalMapper(serializerConfig, deserializerConfig);
+
+  auto bob = mapper.writeToString(dto);
+  auto ordinalBob = ordinalMapper.writeToString(dto);
+
+  OATPP_LOGD(TAG, "size=%d, ordinal size=%d", (v_int32) bob->size(), (v_int32) ordinalBob->size())
+  OATPP_ASSERT(ordinalBob->size() < bob->size())
+
+  {
+    OATPP_LOGD(TAG, "Read ordinals")
+    auto clone = ordinalMapper.readFromString<oatpp::Object<EnumDto>>(ordinalBob);
+    OATPP_ASSERT(clone->colorStr == Color::BLUE)
+    OATPP_ASSERT(clone->colorNum == Color::GREEN)
+    OATPP_ASSERT(clone->colorNull == nullptr)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Read interpretations")
+    auto clone = ordinalMapper.readFromString<oatpp::Object<EnumDto>>(bob);
+    OATPP_ASSERT(clone->colorStr == Color::BLUE)
+    OATPP_ASSERT(clone->colorNull == nullptr)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Read string ordinals with default config")
+    auto clone = mapper.readFromString<oatpp::Object<EnumDto>>(ordinalBob);
+    OATPP_ASSERT(clone->colorStr == Color::BLUE)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Ordinal out of range")
+    oatpp::String wrong("{colorStr\0" "1\5)", 13);
+    bool failed = false;
+    try {
+      mapper.readFromString<oatpp::Object<EnumDto>>(wrong);
+    } catch (...) {
+      failed = true;
+    }
+    OATPP_ASSERT(failed)
+  }
+
+}
+
+}}}
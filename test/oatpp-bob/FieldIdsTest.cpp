@@ -0,0 +1,162 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "FieldIdsTest.hpp"
+
+#include "oatpp-bob/ObjectMapper.hpp"
+
+#include "oatpp/core/macro/codegen.hpp"
+
+namespace oatpp { namespace bob { namespace test {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class AddressDto : public oatpp::DTO {
+
+  DTO_INIT(AddressDto, DTO)
+
+  DTO_FIELD(String, city);
+  DTO_FIELD(String, street);
+
+};
+
+class AccountDto : public oatpp::DTO {
+
+  DTO_INIT(AccountDto, DTO)
+
+  DTO_FIELD(Int64, id);
+  DTO_FIELD(String, name);
+  DTO_FIELD(Object<AddressDto>, address);
+  DTO_FIELD(List<String>, roles);
+
+};
+
+/* next version of AccountDto - "address" removed, "email" added */
+class AccountV2Dto : public oatpp::DTO {
+
+  DTO_INIT(AccountV2Dto, DTO)
+
+  DTO_FIELD(String, email);
+  DTO_FIELD(Int64, id);
+  DTO_FIELD(List<String>, roles);
+  DTO_FIELD(String, name);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::Object<AccountDto> createAccount() {
+  auto account = AccountDto::createShared();
+  account->id = 1234567890123;
+  account->name = "account";
+  account->address = AddressDto::createShared();
+  account->address->city = "Kyiv";
+  account->address->street = "Khreshchatyk";
+  account->roles = {"admin", "user"};
+  return account;
+}
+
+}
+
+void FieldIdsTest::onRun() {
+
+  auto fieldIds = std::make_shared<oatpp::bob::FieldIds>();
+  fieldIds->set<oatpp::Object<AccountDto>>({{"id", 1}, {"name", 2}, {"address", 3}, {"roles", 4}});
+  fieldIds->set<oatpp::Object<AccountV2Dto>>({{"id", 1}, {"name", 2}, {"roles", 4}, {"email", 5}});
+
+  auto serializerConfig = oatpp::bob::Serializer::Config::createShared();
+  serializerConfig->fieldIds = fieldIds;
+  auto deserializerConfig = oatpp::bob::Deserializer::Config::createShared();
+  deserializerConfig->fieldIds = fieldIds;
+
+  oatpp::bob::ObjectMapper mapper(serializerConfig, deserializerConfig);
+  oatpp::bob::ObjectMapper keyedMapper;
+
+  auto account = createAccount();
+  auto bob = mapper.writeToString(account);
+  auto keyedBob = keyedMapper.writeToString(account);
+
+  OATPP_LOGD(TAG, "keyed size=%d, ids size=%d", (v_int32) keyedBob->size(), (v_int32) bob->size())
+  OATPP_ASSERT(bob->size() < keyedBob->size())
+  OATPP_ASSERT(bob->data()[0] == '#')
+
+  {
+    OATPP_LOGD(TAG, "Round trip")
+    auto clone = mapper.readFromString<oatpp::Object<AccountDto>>(bob);
+    OATPP_ASSERT(clone->id == account->id)
+    OATPP_ASSERT(clone->name == "account")
+    OATPP_ASSERT(clone->address->city == "Kyiv") // AddressDto has no ids - written with keys
+    OATPP_ASSERT(clone->address->street == "Khreshchatyk")
+    OATPP_ASSERT(clone->roles->size() == 2 && clone->roles->back() == "user")
+  }
+
+  {
+    OATPP_LOGD(TAG, "Next version - unknown ids are skipped")
+    auto clone = mapper.readFromString<oatpp::Object<AccountV2Dto>>(bob);
+    OATPP_ASSERT(clone->id == account->id)
+    OATPP_ASSERT(clone->name == "account")
+    OATPP_ASSERT(clone->email == nullptr)
+    OATPP_ASSERT(clone->roles->size() == 2 && clone->roles->front() == "admin")
+  }
+
+  {
+    OATPP_LOGD(TAG, "Unknown ids not allowed")
+    auto strictConfig = oatpp::bob::Deserializer::Config::createShared();
+    strictConfig->fieldIds = fieldIds;
+    strictConfig->allowUnknownFields = false;
+    oatpp::bob::ObjectMapper strictMapper(serializerConfig, strictConfig);
+    bool failed = false;
+    try {
+      strictMapper.readFromString<oatpp::Object<AccountV2Dto>>(bob);
+    } catch (const std::runtime_error& e) {
+      failed = true;
+    }
+    OATPP_ASSERT(failed)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Invalid ids")
+    oatpp::bob::FieldIds ids;
+    bool failed = false;
+    try {
+      ids.set<oatpp::Object<AddressDto>>({{"city", 1}});
+    } catch (const std::runtime_error& e) {
+      failed = true;
+    }
+    OATPP_ASSERT(failed)
+    failed = false;
+    try {
+      ids.set<oatpp::Object<AddressDto>>({{"city", 1}, {"street", 1}});
+    } catch (const std::runtime_error& e) {
+      failed = true;
+    }
+    OATPP_ASSERT(failed)
+    OATPP_ASSERT(ids.get(oatpp::Object<AddressDto>::Class::getType()) == nullptr)
+  }
+
+}
+
+}}}
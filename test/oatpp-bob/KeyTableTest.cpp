@@ -0,0 +1,188 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "KeyTableTest.hpp"
+
+#include "oatpp-bob/ObjectMapper.hpp"
+
+#include "oatpp/core/data/stream/BufferStream.hpp"
+#include "oatpp/core/macro/codegen.hpp"
+
+namespace oatpp { namespace bob { namespace test {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class RowDto : public oatpp::DTO {
+
+  DTO_INIT(RowDto, DTO)
+
+  DTO_FIELD(Int32, identifier);
+  DTO_FIELD(String, description);
+  DTO_FIELD(String, nullableField);
+  DTO_FIELD(Fields<Int32>, counters);
+
+};
+
+class PartialRowDto : public oatpp::DTO {
+
+  DTO_INIT(PartialRowDto, DTO)
+
+  DTO_FIELD(String, description);
+
+};
+
+class EnvelopeDto : public oatpp::DTO {
+
+  DTO_INIT(EnvelopeDto, DTO)
+
+  DTO_FIELD(String, kind);
+  DTO_FIELD(Any, payload);
+
+  DTO_FIELD_TYPE_SELECTOR(payload) {
+    if(kind == "rows") return oatpp::Vector<oatpp::Object<RowDto>>::Class::getType();
+    return Void::Class::getType();
+  }
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::Vector<oatpp::Object<RowDto>> createRows(v_int32 count) {
+  oatpp::Vector<oatpp::Object<RowDto>> rows({});
+  for(v_int32 i = 0; i < count; i ++) {
+    auto row = RowDto::createShared();
+    row->identifier = i;
+    row->description = "row";
+    row->counters = {{"firstCounter", i}, {"secondCounter", i * 2}};
+    rows->push_back(row);
+  }
+  return rows;
+}
+
+}
+
+void KeyTableTest::onRun() {
+
+  auto serializerConfig = oatpp::bob::Serializer::Config::createShared();
+  serializerConfig->useKeyTable = true;
+  auto deserializerConfig = oatpp::bob::Deserializer::Config::createShared();
+  deserializerConfig->allowUnknownFields = true;
+
+  oatpp::bob::ObjectMapper mapper;
+  oatpp::bob::ObjectMapper keyTableMapper(serializerConfig, deserializerConfig);
+
+  auto rows = createRows(100);
+
+  {
+    OATPP_LOGD(TAG, "Round trip")
+    auto bob = mapper.writeToString(rows);
+    auto keyTableBob = keyTableMapper.writeToString(rows);
+    OATPP_LOGD(TAG, "size=%d, key table size=%d", (v_int32) bob->size(), (v_int32) keyTableBob->size())
+    OATPP_ASSERT(keyTableBob->size() < bob->size())
+    OATPP_ASSERT(keyTableMapper.getSerializer()->computeSize(rows) == keyTableBob->size())
+
+    auto clone = mapper.readFromString<oatpp::Vector<oatpp::Object<RowDto>>>(keyTableBob);
+    OATPP_ASSERT(clone->size() == rows->size())
+    for(v_int32 i = 0; i < rows->size(); i ++) {
+      OATPP_ASSERT(clone[i]->identifier == i)
+      OATPP_ASSERT(clone[i]->description == "row")
+      OATPP_ASSERT(clone[i]->nullableField == nullptr)
+      OATPP_ASSERT(clone[i]->counters->size() == 2)
+      OATPP_ASSERT(clone[i]->counters[1].first == "secondCounter")
+      OATPP_ASSERT(clone[i]->counters[1].second == i * 2)
+    }
+  }
+
+  {
+    OATPP_LOGD(TAG, "Skip fields with key references")
+    auto keyTableBob = keyTableMapper.writeToString(rows);
+    auto clone = keyTableMapper.readFromString<oatpp::Vector<oatpp::Object<PartialRowDto>>>(keyTableBob);
+    OATPP_ASSERT(clone->size() == rows->size())
+    OATPP_ASSERT(clone[rows->size() - 1]->description == "row")
+
+    auto any = keyTableMapper.readFromString<oatpp::Any>(keyTableBob);
+    OATPP_ASSERT(any)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Polymorphic field")
+    auto envelope = EnvelopeDto::createShared();
+    envelope->kind = "rows";
+    envelope->payload = createRows(10);
+    auto keyTableBob = keyTableMapper.writeToString(oatpp::Vector<oatpp::Object<EnvelopeDto>>({envelope, envelope}));
+    auto clone = mapper.readFromString<oatpp::Vector<oatpp::Object<EnvelopeDto>>>(keyTableBob);
+    auto payload = clone[1]->payload.retrieve<oatpp::Vector<oatpp::Object<RowDto>>>();
+    OATPP_ASSERT(payload->size() == 10)
+    OATPP_ASSERT(payload[9]->counters[0].first == "firstCounter")
+  }
+
+  {
+    OATPP_LOGD(TAG, "Pull-based serializer")
+    auto expected = keyTableMapper.writeToString(rows);
+    auto callback = keyTableMapper.createReadCallback(rows);
+    oatpp::data::stream::BufferOutputStream stream;
+    v_char8 buffer[16];
+    v_io_size res;
+    while((res = callback->readSimple(buffer, 16)) > 0) {
+      stream.writeSimple(buffer, res);
+    }
+    OATPP_ASSERT(stream.toString() == expected)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Keys with the 0xFF byte")
+    oatpp::Fields<oatpp::String> fields({{"a\xFF", "1"}, {"", "2"}});
+    for(auto* m : {&mapper, &keyTableMapper}) {
+      auto clone = mapper.readFromString<oatpp::Fields<oatpp::String>>(m->writeToString(fields));
+      OATPP_ASSERT(clone->size() == 2)
+      OATPP_ASSERT(clone["a\xFF"] == "1")
+      OATPP_ASSERT(clone[""] == "2")
+
+      bool failed = false;
+      try {
+        m->writeToString(oatpp::Fields<oatpp::String>({{"\xFF" "abc", "1"}}));
+      } catch (const std::runtime_error&) {
+        failed = true;
+      }
+      OATPP_ASSERT(failed)
+    }
+  }
+
+  {
+    OATPP_LOGD(TAG, "Invalid reference")
+    oatpp::String wrong("{\xFF\x05s\x01x)", 7);
+    bool failed = false;
+    try {
+      mapper.readFromString<oatpp::Any>(wrong);
+    } catch (...) {
+      failed = true;
+    }
+    OATPP_ASSERT(failed)
+  }
+
+}
+
+}}}
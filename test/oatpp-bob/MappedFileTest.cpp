@@ -0,0 +1,129 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "MappedFileTest.hpp"
+
+#include "oatpp-bob/ObjectMapper.hpp"
+
+#include "oatpp/core/macro/codegen.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+namespace oatpp { namespace bob { namespace test {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class EntryDto : public oatpp::DTO {
+
+  DTO_INIT(EntryDto, DTO)
+
+  DTO_FIELD(Int64, key);
+  DTO_FIELD(String, value);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+const char* const FILE_PATH = "oatpp-bob-mapped-file-test.bob";
+
+void writeFile(const oatpp::String& data) {
+  std::ofstream file(FILE_PATH, std::ios::out | std::ios::binary | std::ios::trunc);
+  file.write(data->data(), data->size());
+}
+
+}
+
+void MappedFileTest::onRun() {
+
+  typedef oatpp::Vector<oatpp::Object<EntryDto>> Entries;
+
+  Entries entries({});
+  for(v_int32 i = 0; i < 10000; i ++) {
+    auto entry = EntryDto::createShared();
+    entry->key = i;
+    entry->value = "value-" + std::to_string(i);
+    entries->push_back(entry);
+  }
+
+  auto config = oatpp::bob::Serializer::Config::createShared();
+  config->arrayIndexThreshold = 1000;
+  config->arrayIndexStride = 8;
+  oatpp::bob::ObjectMapper mapper(config, oatpp::bob::Deserializer::Config::createShared());
+
+  writeFile(mapper.writeToString(entries));
+
+  {
+    OATPP_LOGD(TAG, "Read whole file")
+    auto clone = mapper.readFromFile<Entries>(oatpp::String(FILE_PATH));
+    OATPP_ASSERT(clone->size() == 10000)
+    OATPP_ASSERT(clone[9999]->value == "value-9999")
+  }
+
+  {
+    OATPP_LOGD(TAG, "Read slices")
+    oatpp::bob::MappedFile file(FILE_PATH, oatpp::bob::MappedFile::Access::RANDOM);
+    for(v_int32 offset : {0, 4321, 9990}) {
+      auto slice = mapper.readSliceFromFile<Entries>(file, offset, 50);
+      OATPP_ASSERT(slice->size() == std::min(50, 10000 - offset))
+      OATPP_ASSERT(slice[0]->key == offset)
+      OATPP_ASSERT(slice[0]->value == "value-" + std::to_string(offset))
+    }
+  }
+
+  {
+    OATPP_LOGD(TAG, "Compressed file")
+    oatpp::bob::ObjectMapper compressedMapper;
+    compressedMapper.setCompression(std::make_shared<oatpp::bob::LzCodec>());
+    writeFile(compressedMapper.writeToString(entries));
+    auto clone = compressedMapper.readFromFile<Entries>(oatpp::String(FILE_PATH));
+    OATPP_ASSERT(clone->size() == 10000)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Errors")
+    writeFile("");
+    bool failed = false;
+    try {
+      mapper.readFromFile<Entries>(oatpp::String(FILE_PATH));
+    } catch (const std::runtime_error&) {
+      failed = true;
+    }
+    OATPP_ASSERT(failed)
+
+    std::remove(FILE_PATH);
+    failed = false;
+    try {
+      mapper.readFromFile<Entries>(oatpp::String(FILE_PATH));
+    } catch (const std::runtime_error&) {
+      failed = true;
+    }
+    OATPP_ASSERT(failed)
+  }
+
+}
+
+}}}
@@ -0,0 +1,108 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "ObjectKeysTest.hpp"
+
+#include "oatpp-bob/ObjectMapper.hpp"
+
+#include "oatpp/core/macro/codegen.hpp"
+
+namespace oatpp { namespace bob { namespace test {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class KeysDto : public oatpp::DTO {
+
+  DTO_INIT(KeysDto, DTO)
+
+  DTO_FIELD(String, name);
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, comment);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::Object<KeysDto> createKeys() {
+  auto dto = KeysDto::createShared();
+  dto->name = "n";
+  dto->id = 1;
+  return dto;
+}
+
+void serializeStringOrTilde(oatpp::bob::Serializer* serializer,
+                            oatpp::data::stream::ConsistentOutputStream* stream,
+                            const oatpp::Void& polymorph)
+{
+  if(!polymorph) {
+    stream->writeCharSimple('~');
+    return;
+  }
+  oatpp::bob::Serializer::serializeString(serializer, stream, polymorph);
+}
+
+}
+
+void ObjectKeysTest::onRun() {
+
+  {
+    OATPP_LOGD(TAG, "Key blob and null tag")
+    oatpp::bob::ObjectMapper mapper;
+    auto bob = mapper.writeToString(createKeys());
+    OATPP_ASSERT(bob == oatpp::String("{name\0s\x01n" "id\0I\0\0\0\x01" "comment\0" "0)", 27))
+    OATPP_ASSERT(mapper.getSerializer()->computeSize(createKeys()) == bob->size())
+  }
+
+  {
+    OATPP_LOGD(TAG, "Null tag with key references")
+    auto config = oatpp::bob::Serializer::Config::createShared();
+    config->useKeyTable = true;
+    oatpp::bob::ObjectMapper mapper(config, oatpp::bob::Deserializer::Config::createShared());
+    auto bob = mapper.writeToString(oatpp::Vector<oatpp::Object<KeysDto>>({createKeys(), createKeys()}));
+    /* the second 'comment' is a reference followed by the null tag */
+    OATPP_ASSERT(bob->substr(bob->size() - 5) == std::string("\xFF\x17" "0))", 5))
+    auto clone = mapper.readFromString<oatpp::Vector<oatpp::Object<KeysDto>>>(bob);
+    OATPP_ASSERT(clone->size() == 2)
+    OATPP_ASSERT(clone[1]->name == "n" && clone[1]->id == 1 && clone[1]->comment == nullptr)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Method replaced after use")
+    auto serializer = std::make_shared<oatpp::bob::Serializer>();
+    oatpp::bob::ObjectMapper mapper(serializer, std::make_shared<oatpp::bob::Deserializer>());
+    auto bob = mapper.writeToString(createKeys());
+    OATPP_ASSERT(bob->substr(bob->size() - 10) == std::string("comment\0" "0)", 10))
+
+    /* keys are cached per type - null tags must not be merged for the custom method */
+    serializer->setSerializerMethod(oatpp::data::mapping::type::__class::String::CLASS_ID, &serializeStringOrTilde);
+    bob = mapper.writeToString(createKeys());
+    OATPP_ASSERT(bob->substr(bob->size() - 10) == std::string("comment\0" "~)", 10))
+    OATPP_ASSERT(bob->substr(0, 9) == std::string("{name\0s\x01n", 9))
+  }
+
+}
+
+}}}
@@ -26,8 +26,10 @@
 #include "ObjectMapperTest.hpp"
 
 #include "oatpp-bob/ObjectMapper.hpp"
+#include "oatpp-bob/Stream.hpp"
 #include "oatpp/parser/json/mapping/ObjectMapper.hpp"
 
+#include "oatpp/core/data/stream/BufferStream.hpp"
 #include "oatpp/core/macro/codegen.hpp"
 
 namespace oatpp { namespace bob { namespace test {
@@ -82,6 +84,23 @@ class PolymorphicDto : public oatpp::DTO {
 
 #include OATPP_CODEGEN_END(DTO)
 
+/*
+ * Writes the string longer or shorter on every other call - the size pass of writeToString() doesn't match the output.
+ */
+v_int32 UNSTABLE_CALLS = 0;
+
+void serializeUnstableString(oatpp::bob::Serializer* serializer,
+                             oatpp::data::stream::ConsistentOutputStream* stream,
+                             const oatpp::Void& polymorph)
+{
+  auto str = static_cast<std::string*>(polymorph.get());
+  if(str != nullptr && (UNSTABLE_CALLS ++) % 2 == 1) {
+    oatpp::bob::Serializer::serializeString(serializer, stream, oatpp::String(*str + *str));
+    return;
+  }
+  oatpp::bob::Serializer::serializeString(serializer, stream, polymorph);
+}
+
 }
 
 void ObjectMapperTest::onRun() {
@@ -137,6 +156,139 @@ void ObjectMapperTest::onRun() {
     }
   }
 
+  {
+    auto poly = PolymorphicDto::createShared();
+    poly->type = 3;
+    poly->obj = dto3;
+    oatpp::data::stream::BufferOutputStream stream;
+    bobMapper.write(&stream, poly);
+    auto bob = bobMapper.writeToString(poly);
+    auto size = bobMapper.getSerializer()->computeSize(poly);
+    OATPP_LOGD(TAG, "computed size=%d", (v_int32) size)
+    OATPP_ASSERT(size == bob->size())
+    OATPP_ASSERT(stream.toString() == bob)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Output doesn't match the computed size")
+    auto serializer = std::make_shared<oatpp::bob::Serializer>();
+    serializer->setSerializerMethod(oatpp::data::mapping::type::__class::String::CLASS_ID, &serializeUnstableString);
+    oatpp::bob::ObjectMapper unstableMapper(serializer, std::make_shared<oatpp::bob::Deserializer>());
+    auto dto = TestDto1::createShared();
+    dto->valueStr = "abc";
+
+    UNSTABLE_CALLS = 0; // size pass - "abc", then "abcabc" - overflow, then "abc" from the fallback
+    OATPP_ASSERT(unstableMapper.readFromString<oatpp::Object<TestDto1>>(unstableMapper.writeToString(dto))->valueStr == "abc")
+
+    UNSTABLE_CALLS = 1; // size pass - "abcabc", then "abc" - short output, then "abcabc" from the fallback
+    OATPP_ASSERT(unstableMapper.readFromString<oatpp::Object<TestDto1>>(unstableMapper.writeToString(dto))->valueStr == "abcabc")
+  }
+
+  {
+    OATPP_LOGD(TAG, "writeToString() through the base class")
+    oatpp::bob::ObjectMapper pooledMapper;
+    pooledMapper.setBufferPooling(true);
+    oatpp::bob::ObjectMapper compressedMapper;
+    compressedMapper.setCompression(std::make_shared<oatpp::bob::LzCodec>());
+    for(const oatpp::bob::ObjectMapper* mapper : {&bobMapper, &pooledMapper, &compressedMapper}) {
+      const oatpp::data::mapping::ObjectMapper* base = mapper;
+      for(v_int32 i = 0; i < 3; i ++) {
+        OATPP_ASSERT(base->writeToString(dto3) == mapper->writeToString(dto3))
+        OATPP_ASSERT(base->writeToString(dto1) == mapper->writeToString(dto1))
+      }
+    }
+    oatpp::data::stream::BufferOutputStream stream(4);
+    stream.writeSimple("head", 4);
+    bobMapper.write(&stream, dto3);
+    auto bob = bobMapper.writeToString(dto3);
+    std::string expected = "head";
+    expected.append(bob->data(), bob->size());
+    OATPP_ASSERT(stream.toString() == oatpp::String(expected))
+  }
+
+  {
+    auto dto = TestDto1::createShared();
+    dto->valueStr = oatpp::String(std::string(2000, 'x'));
+    oatpp::bob::SegmentedOutputStream stream(64);
+    bobMapper.write(&stream, dto);
+    auto bob = bobMapper.writeToString(dto);
+    OATPP_LOGD(TAG, "segments=%d", (v_int32) stream.getSegments().size())
+    OATPP_ASSERT(stream.getSegments().size() == 3)
+    OATPP_ASSERT(stream.getSegments()[1].data == dto->valueStr->data())
+    OATPP_ASSERT(stream.getSize() == bob->size())
+    OATPP_ASSERT(stream.toString() == bob)
+  }
+
+  {
+    auto serializerConfig = oatpp::bob::Serializer::Config::createShared();
+    serializerConfig->parallelThreads = 4;
+    serializerConfig->parallelCollectionThreshold = 10;
+    oatpp::bob::ObjectMapper parallelMapper(serializerConfig, oatpp::bob::Deserializer::Config::createShared());
+
+    oatpp::List<oatpp::Object<TestDto3>> list({});
+    for(v_int32 i = 0; i < 1000; i ++) {
+      auto dto = TestDto3::createShared();
+      dto->values = {i, i + 1, i + 2};
+      list->push_back(dto);
+    }
+    list->push_back(nullptr);
+
+    auto bob = bobMapper.writeToString(list);
+    auto parallelBob = parallelMapper.writeToString(list);
+    OATPP_ASSERT(parallelBob == bob)
+
+    auto clone = bobMapper.readFromString<oatpp::List<oatpp::Object<TestDto3>>>(parallelBob);
+    OATPP_ASSERT(clone->size() == list->size())
+    OATPP_ASSERT(clone->back() == nullptr)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Parallel chunks with the key table - size pass matches the output")
+    auto serializerConfig = oatpp::bob::Serializer::Config::createShared();
+    serializerConfig->parallelThreads = 3;
+    serializerConfig->parallelCollectionThreshold = 10;
+    serializerConfig->useKeyTable = true;
+    serializerConfig->includeNullFields = false;
+    oatpp::bob::ObjectMapper parallelMapper(serializerConfig, oatpp::bob::Deserializer::Config::createShared());
+
+    oatpp::Vector<oatpp::Object<TestDto1>> vector({});
+    for(v_int32 i = 0; i < 100; i ++) {
+      vector->push_back(i % 10 == 0 ? nullptr : dto1);
+    }
+
+    auto bob = parallelMapper.writeToString(vector);
+    oatpp::data::stream::BufferOutputStream stream;
+    parallelMapper.getSerializer()->serializeToStream(&stream, vector);
+    OATPP_ASSERT(parallelMapper.getSerializer()->computeSize(vector) == bob->size())
+    OATPP_ASSERT(stream.toString() == bob)
+    OATPP_ASSERT(bobMapper.readFromString<oatpp::Vector<oatpp::Object<TestDto1>>>(bob)->size() == 90)
+  }
+
+  {
+    auto serializerConfig = oatpp::bob::Serializer::Config::createShared();
+    serializerConfig->subtreeCache = std::make_shared<oatpp::bob::SubtreeCache>();
+    oatpp::bob::ObjectMapper cachingMapper(serializerConfig, oatpp::bob::Deserializer::Config::createShared());
+
+    auto shared = TestDto1::createShared();
+    shared->valueStr = "shared value";
+    oatpp::Vector<oatpp::Object<TestDto1>> vector({shared, TestDto1::createShared(), shared});
+
+    serializerConfig->subtreeCache->put(shared, 1);
+    OATPP_ASSERT(cachingMapper.writeToString(vector) == bobMapper.writeToString(vector))
+
+    /* not re-encoded until the version is changed */
+    auto cached = cachingMapper.writeToString(vector);
+    shared->valueStr = "changed value";
+    OATPP_ASSERT(cachingMapper.writeToString(vector) == cached)
+
+    serializerConfig->subtreeCache->put(shared, 2);
+    OATPP_ASSERT(cachingMapper.writeToString(vector) == bobMapper.writeToString(vector))
+    OATPP_ASSERT(cachingMapper.writeToString(vector) != cached)
+
+    serializerConfig->subtreeCache->remove(shared);
+    OATPP_ASSERT(serializerConfig->subtreeCache->getSize() == 0)
+  }
+
   {
     oatpp::String bob("{key\0s\5value)", 13);
     auto obj = bobMapper.readFromString<oatpp::Any>(bob);
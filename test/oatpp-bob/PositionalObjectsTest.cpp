@@ -0,0 +1,167 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "PositionalObjectsTest.hpp"
+
+#include "oatpp-bob/ObjectMapper.hpp"
+
+#include "oatpp/core/macro/codegen.hpp"
+
+namespace oatpp { namespace bob { namespace test {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class UserDto : public oatpp::DTO {
+
+  DTO_INIT(UserDto, DTO)
+
+  DTO_FIELD(Int64, id);
+  DTO_FIELD(String, name);
+  DTO_FIELD(String, email);
+  DTO_FIELD(Boolean, active);
+
+};
+
+class UsersDto : public oatpp::DTO {
+
+  DTO_INIT(UsersDto, DTO)
+
+  DTO_FIELD(List<Object<UserDto>>, users);
+
+};
+
+/* next version of UserDto - field removed, field added, fields reordered */
+class UserV2Dto : public oatpp::DTO {
+
+  DTO_INIT(UserV2Dto, DTO)
+
+  DTO_FIELD(String, email);
+  DTO_FIELD(Int64, id);
+  DTO_FIELD(String, phone);
+
+};
+
+class UsersV2Dto : public oatpp::DTO {
+
+  DTO_INIT(UsersV2Dto, DTO)
+
+  DTO_FIELD(List<Object<UserV2Dto>>, users);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::Object<UsersDto> createUsers(v_int32 count) {
+  auto result = UsersDto::createShared();
+  result->users = {};
+  for(v_int32 i = 0; i < count; i ++) {
+    auto user = UserDto::createShared();
+    user->id = (v_int64) i;
+    user->name = "user-" + std::to_string(i);
+    if(i % 2 == 0) {
+      user->email = "user-" + std::to_string(i) + "@example.com";
+    }
+    user->active = (i % 3 == 0);
+    result->users->push_back(user);
+  }
+  return result;
+}
+
+}
+
+void PositionalObjectsTest::onRun() {
+
+  auto users = createUsers(100);
+
+  oatpp::bob::ObjectMapper keyedMapper;
+  auto keyedBob = keyedMapper.writeToString(users);
+
+  {
+    OATPP_LOGD(TAG, "Same schema")
+
+    auto config = oatpp::bob::Serializer::Config::createShared();
+    config->positionalObjects = true;
+    oatpp::bob::ObjectMapper mapper(config, oatpp::bob::Deserializer::Config::createShared());
+
+    auto bob = mapper.writeToString(users);
+    OATPP_LOGD(TAG, "keyed size=%d, positional size=%d", (v_int32) keyedBob->size(), (v_int32) bob->size())
+    OATPP_ASSERT(bob->size() < keyedBob->size())
+
+    auto clone = mapper.readFromString<oatpp::Object<UsersDto>>(bob);
+    OATPP_ASSERT(clone->users->size() == 100)
+    for(v_int32 i = 0; i < 100; i ++) {
+      auto& a = users->users[i];
+      auto& b = clone->users[i];
+      OATPP_ASSERT(a->id == b->id)
+      OATPP_ASSERT(a->name == b->name)
+      OATPP_ASSERT(a->email == b->email)
+      OATPP_ASSERT(a->active == b->active)
+    }
+
+    /* different schema and no keys */
+    bool failed = false;
+    try {
+      mapper.readFromString<oatpp::Object<UsersV2Dto>>(bob);
+    } catch (const std::runtime_error& e) {
+      failed = true;
+    }
+    OATPP_ASSERT(failed)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Different schema, embedded keys")
+
+    auto config = oatpp::bob::Serializer::Config::createShared();
+    config->positionalObjects = true;
+    config->embedObjectSchemas = true;
+    auto deserializerConfig = oatpp::bob::Deserializer::Config::createShared();
+    deserializerConfig->allowUnknownFields = true;
+    oatpp::bob::ObjectMapper mapper(config, deserializerConfig);
+
+    auto bob = mapper.writeToString(users);
+    OATPP_LOGD(TAG, "positional size with schemas=%d", (v_int32) bob->size())
+    OATPP_ASSERT(bob->size() < keyedBob->size())
+
+    auto clone = mapper.readFromString<oatpp::Object<UsersV2Dto>>(bob);
+    OATPP_ASSERT(clone->users->size() == 100)
+    for(v_int32 i = 0; i < 100; i ++) {
+      auto& a = users->users[i];
+      auto& b = clone->users[i];
+      OATPP_ASSERT(a->id == b->id)
+      OATPP_ASSERT(a->email == b->email)
+      OATPP_ASSERT(b->phone == nullptr)
+    }
+
+    /* keyed and positional data is read by the same reader */
+    auto sameClone = mapper.readFromString<oatpp::Object<UsersDto>>(bob);
+    OATPP_ASSERT(sameClone->users[99]->name == "user-99")
+    auto keyedClone = mapper.readFromString<oatpp::Object<UsersV2Dto>>(keyedBob);
+    OATPP_ASSERT(keyedClone->users[98]->email == "user-98@example.com")
+  }
+
+}
+
+}}}
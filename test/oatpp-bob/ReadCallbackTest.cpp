@@ -0,0 +1,209 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "ReadCallbackTest.hpp"
+
+#include "oatpp-bob/ObjectMapper.hpp"
+
+#include "oatpp/core/data/stream/BufferStream.hpp"
+#include "oatpp/core/utils/ConversionUtils.hpp"
+#include "oatpp/core/macro/codegen.hpp"
+
+namespace oatpp { namespace bob { namespace test {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class ItemDto : public oatpp::DTO {
+
+  DTO_INIT(ItemDto, DTO)
+
+  DTO_FIELD(Int64, id);
+
+  DTO_FIELD_INFO(name) {
+    info->required = true;
+  }
+  DTO_FIELD(String, name);
+
+  DTO_FIELD(Vector<Float64>, values);
+  DTO_FIELD(Fields<String>, tags);
+  DTO_FIELD(Any, extra);
+
+};
+
+class ExportDto : public oatpp::DTO {
+
+  DTO_INIT(ExportDto, DTO)
+
+  DTO_FIELD(String, title);
+  DTO_FIELD(List<Object<ItemDto>>, items);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::String pullAll(const std::shared_ptr<oatpp::data::stream::ReadCallback>& callback, v_buff_size chunkSize) {
+  oatpp::data::stream::BufferOutputStream stream;
+  std::unique_ptr<v_char8[]> buffer(new v_char8[chunkSize]);
+  while(true) {
+    auto res = callback->readSimple(buffer.get(), chunkSize);
+    OATPP_ASSERT(res >= 0 && res <= chunkSize)
+    if(res == 0) {
+      break;
+    }
+    stream.writeSimple(buffer.get(), res);
+  }
+  return stream.toString();
+}
+
+void serializeStringOrTilde(oatpp::bob::Serializer* serializer,
+                            oatpp::data::stream::ConsistentOutputStream* stream,
+                            const oatpp::Void& polymorph)
+{
+  if(!polymorph) {
+    stream->writeCharSimple('~');
+    return;
+  }
+  oatpp::bob::Serializer::serializeString(serializer, stream, polymorph);
+}
+
+oatpp::Object<ExportDto> createExport() {
+  auto dto = ExportDto::createShared();
+  dto->title = "export";
+  dto->items = {};
+  for(v_int32 i = 0; i < 100; i ++) {
+    auto item = ItemDto::createShared();
+    item->id = i;
+    if(i % 3 != 0) {
+      item->name = "item-" + oatpp::utils::conversion::int32ToStdStr(i);
+    }
+    item->values = {0.5 * i, nullptr, 1.5};
+    item->tags = {{"a", "tag-a"}, {"b", nullptr}};
+    if(i % 2 == 0) {
+      item->extra = oatpp::Vector<oatpp::String>({"x", "y"});
+    }
+    dto->items->push_back(item);
+  }
+  dto->items->push_back(nullptr);
+  return dto;
+}
+
+}
+
+void ReadCallbackTest::onRun() {
+
+  auto dto = createExport();
+
+  {
+    OATPP_LOGD(TAG, "Default config")
+    oatpp::bob::ObjectMapper mapper;
+    auto expected = mapper.writeToString(dto);
+    for(v_buff_size chunkSize : {1, 7, 64, 4096, 1024 * 1024}) {
+      auto result = pullAll(mapper.createReadCallback(dto), chunkSize);
+      OATPP_ASSERT(result == expected)
+    }
+    auto clone = mapper.readFromString<oatpp::Object<ExportDto>>(pullAll(mapper.createReadCallback(dto), 13));
+    OATPP_ASSERT(clone->items->size() == dto->items->size())
+    OATPP_ASSERT(clone->items->front()->id == 0)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Skip nulls")
+    auto serializerConfig = oatpp::bob::Serializer::Config::createShared();
+    serializerConfig->includeNullFields = false;
+    oatpp::bob::ObjectMapper mapper(serializerConfig, oatpp::bob::Deserializer::Config::createShared());
+    auto expected = mapper.writeToString(dto);
+    for(v_buff_size chunkSize : {1, 5, 256}) {
+      auto result = pullAll(mapper.createReadCallback(dto), chunkSize);
+      OATPP_ASSERT(result == expected)
+    }
+  }
+
+  {
+    OATPP_LOGD(TAG, "Null and required options")
+    for(v_int32 flags = 0; flags < 32; flags ++) {
+      auto serializerConfig = oatpp::bob::Serializer::Config::createShared();
+      serializerConfig->includeNullFields = (flags & 1) != 0;
+      serializerConfig->alwaysIncludeRequired = (flags & 2) != 0;
+      serializerConfig->alwaysIncludeNullCollectionElements = (flags & 4) != 0;
+      serializerConfig->useKeyTable = (flags & 8) != 0;
+      serializerConfig->stringDedupTableSize = (flags & 16) != 0 ? 64 : 0;
+      auto serializer = std::make_shared<oatpp::bob::Serializer>(serializerConfig);
+      oatpp::bob::ObjectMapper mapper(serializer, std::make_shared<oatpp::bob::Deserializer>());
+      auto expected = mapper.writeToString(dto);
+      OATPP_ASSERT(pullAll(mapper.createReadCallback(dto), 7) == expected)
+      /* nulls of the type with the custom method */
+      serializer->setSerializerMethod(oatpp::data::mapping::type::__class::String::CLASS_ID, &serializeStringOrTilde);
+      expected = mapper.writeToString(dto);
+      OATPP_ASSERT(pullAll(mapper.createReadCallback(dto), 7) == expected)
+    }
+  }
+
+  {
+    OATPP_LOGD(TAG, "Positional objects")
+    for(bool embedSchemas : {false, true}) {
+      auto serializerConfig = oatpp::bob::Serializer::Config::createShared();
+      serializerConfig->positionalObjects = true;
+      serializerConfig->embedObjectSchemas = embedSchemas;
+      oatpp::bob::ObjectMapper mapper(serializerConfig, oatpp::bob::Deserializer::Config::createShared());
+      auto expected = mapper.writeToString(dto);
+      for(v_buff_size chunkSize : {1, 7, 4096}) {
+        auto result = pullAll(mapper.createReadCallback(dto), chunkSize);
+        OATPP_ASSERT(result == expected)
+      }
+    }
+  }
+
+  {
+    OATPP_LOGD(TAG, "Field ids")
+    auto fieldIds = std::make_shared<oatpp::bob::FieldIds>();
+    fieldIds->set<oatpp::Object<ExportDto>>({{"title", 1}, {"items", 2}}); // ItemDto stays keyed
+    auto serializerConfig = oatpp::bob::Serializer::Config::createShared();
+    serializerConfig->fieldIds = fieldIds;
+    auto deserializerConfig = oatpp::bob::Deserializer::Config::createShared();
+    deserializerConfig->fieldIds = fieldIds;
+    oatpp::bob::ObjectMapper mapper(serializerConfig, deserializerConfig);
+    auto expected = mapper.writeToString(dto);
+    for(v_buff_size chunkSize : {1, 7, 4096}) {
+      auto result = pullAll(mapper.createReadCallback(dto), chunkSize);
+      OATPP_ASSERT(result == expected)
+    }
+    auto items = pullAll(mapper.createReadCallback(dto->items), 13);
+    OATPP_ASSERT(items == mapper.writeToString(dto->items))
+    auto clone = mapper.readFromString<oatpp::Object<ExportDto>>(expected);
+    OATPP_ASSERT(clone->items->size() == dto->items->size())
+  }
+
+  {
+    OATPP_LOGD(TAG, "Scalar and null roots")
+    oatpp::bob::ObjectMapper mapper;
+    OATPP_ASSERT(pullAll(mapper.createReadCallback(oatpp::String("hello")), 2) == mapper.writeToString(oatpp::String("hello")))
+    OATPP_ASSERT(pullAll(mapper.createReadCallback(oatpp::Int32(7)), 2) == mapper.writeToString(oatpp::Int32(7)))
+    OATPP_ASSERT(pullAll(mapper.createReadCallback(oatpp::Void(nullptr, oatpp::String::Class::getType())), 2)->size() == 1)
+  }
+
+}
+
+}}}
@@ -0,0 +1,140 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "RecordLogTest.hpp"
+
+#include "oatpp-bob/RecordLog.hpp"
+
+#include "oatpp/core/macro/codegen.hpp"
+
+#include <limits>
+
+namespace oatpp { namespace bob { namespace test {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class EventDto : public oatpp::DTO {
+
+  DTO_INIT(EventDto, DTO)
+
+  DTO_FIELD(Int64, id);
+  DTO_FIELD(String, name);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::String writeLog(v_int32 count, v_buff_size syncInterval) {
+  oatpp::data::stream::BufferOutputStream stream;
+  oatpp::bob::RecordLogWriter writer(&stream, std::make_shared<oatpp::bob::ObjectMapper>(), syncInterval);
+  for(v_int32 i = 0; i < count; i ++) {
+    auto event = EventDto::createShared();
+    event->id = i;
+    event->name = "event-" + std::to_string(i);
+    writer.append(event);
+  }
+  OATPP_ASSERT(writer.getPosition() == stream.getCurrentPosition())
+  return stream.toString();
+}
+
+}
+
+void RecordLogTest::onRun() {
+
+  oatpp::bob::ObjectMapper mapper;
+
+  {
+    OATPP_LOGD(TAG, "Sequential read")
+    auto log = writeLog(1000, 0);
+    oatpp::bob::RecordLogReader reader(log);
+    oatpp::bob::RecordLogReader::Record record;
+    v_int32 count = 0;
+    while(reader.next(record)) {
+      auto event = oatpp::bob::RecordLogReader::read<oatpp::Object<EventDto>>(mapper, record);
+      OATPP_ASSERT(event->id == count)
+      count ++;
+    }
+    OATPP_ASSERT(reader.getError() == nullptr)
+    OATPP_ASSERT(count == 1000)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Batch read with sync markers")
+    auto log = writeLog(1000, 256);
+    oatpp::bob::RecordLogReader reader(log);
+    v_int32 count = 0;
+    while(true) {
+      auto batch = reader.readBatch<oatpp::Object<EventDto>>(mapper, 64);
+      if(batch.empty()) break;
+      for(auto& event : batch) {
+        OATPP_ASSERT(event->id == count)
+        OATPP_ASSERT(event->name == "event-" + std::to_string(count))
+        count ++;
+      }
+    }
+    OATPP_ASSERT(reader.getError() == nullptr)
+    OATPP_ASSERT(count == 1000)
+
+    /* maxCount is a limit, not the size of the batch */
+    oatpp::bob::RecordLogReader unboundedReader(log);
+    auto all = unboundedReader.readBatch<oatpp::Object<EventDto>>(mapper, std::numeric_limits<v_buff_size>::max());
+    OATPP_ASSERT(all.size() == 1000)
+    OATPP_ASSERT((v_buff_size) all.capacity() <= log->size() / 2)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Resync after corrupted record")
+    auto log = writeLog(1000, 256);
+    std::string data(log->data(), log->size());
+
+    oatpp::bob::RecordLogReader scanner(data.data(), data.size());
+    oatpp::bob::RecordLogReader::Record record;
+    for(v_int32 i = 0; i < 100; i ++) {
+      OATPP_ASSERT(scanner.next(record))
+    }
+    data[record.position] = (char) 0xFF; // length varint now runs past the end of the log
+    data[record.position + 1] = (char) 0xFF;
+
+    oatpp::bob::RecordLogReader reader(data.data(), data.size());
+    v_int32 count = 0;
+    while(reader.next(record)) count ++;
+    OATPP_ASSERT(count == 99)
+    OATPP_ASSERT(reader.getError() != nullptr)
+
+    OATPP_ASSERT(reader.resync())
+    v_int64 lastId = -1;
+    while(reader.next(record)) {
+      lastId = oatpp::bob::RecordLogReader::read<oatpp::Object<EventDto>>(mapper, record)->id;
+      count ++;
+    }
+    OATPP_ASSERT(reader.getError() == nullptr)
+    OATPP_ASSERT(lastId == 999)
+    OATPP_ASSERT(count > 900 && count < 999)
+  }
+
+}
+
+}}}
@@ -0,0 +1,199 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "SerializerConfigTest.hpp"
+
+#include "oatpp-bob/ObjectMapper.hpp"
+
+#include "oatpp/core/data/stream/BufferStream.hpp"
+#include "oatpp/core/utils/ConversionUtils.hpp"
+#include "oatpp/core/macro/codegen.hpp"
+
+namespace oatpp { namespace bob { namespace test {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class RecordDto : public oatpp::DTO {
+
+  DTO_INIT(RecordDto, DTO)
+
+  DTO_FIELD(String, name);
+
+  DTO_FIELD_INFO(id) {
+    info->required = true;
+  }
+  DTO_FIELD(Int32, id);
+
+  DTO_FIELD(String, comment);
+  DTO_FIELD(Vector<String>, items);
+  DTO_FIELD(Fields<String>, labels);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::Object<RecordDto> createRecord() {
+  auto record = RecordDto::createShared();
+  record->name = "record";
+  record->items = {"a", nullptr, "b"};
+  record->labels = {{"x", "1"}, {"y", nullptr}};
+  return record;
+}
+
+oatpp::String pullAll(const std::shared_ptr<oatpp::data::stream::ReadCallback>& callback) {
+  oatpp::data::stream::BufferOutputStream stream;
+  v_char8 buffer[16];
+  v_io_size res;
+  while((res = callback->readSimple(buffer, 16)) > 0) {
+    stream.writeSimple(buffer, res);
+  }
+  return stream.toString();
+}
+
+void serializeInt32AsString(oatpp::bob::Serializer* serializer,
+                            oatpp::data::stream::ConsistentOutputStream* stream,
+                            const oatpp::Void& polymorph)
+{
+  if(!polymorph) {
+    stream->writeCharSimple('0');
+    return;
+  }
+  oatpp::String text = oatpp::utils::conversion::int32ToStr(*static_cast<v_int32*>(polymorph.get()));
+  oatpp::bob::Serializer::serializeString(serializer, stream, text);
+}
+
+/*
+ * Write the record with the config and check the number of written fields, array elements and map entries.
+ */
+void checkConfig(const std::shared_ptr<oatpp::bob::Serializer::Config>& config,
+                 v_int32 fieldsCount, v_int32 itemsCount, v_int32 labelsCount)
+{
+  for(bool keyTable : {false, true}) {
+
+    config->useKeyTable = keyTable;
+    oatpp::bob::ObjectMapper mapper(config, oatpp::bob::Deserializer::Config::createShared());
+    auto bob = mapper.writeToString(createRecord());
+
+    auto fields = mapper.readFromString<oatpp::Fields<oatpp::Any>>(bob);
+    OATPP_ASSERT(fields->size() == fieldsCount)
+    OATPP_ASSERT(fields["items"].retrieve<oatpp::Vector<oatpp::Any>>()->size() == itemsCount)
+    OATPP_ASSERT(fields["labels"].retrieve<oatpp::Fields<oatpp::Any>>()->size() == labelsCount)
+
+    auto clone = mapper.readFromString<oatpp::Object<RecordDto>>(bob);
+    OATPP_ASSERT(clone->name == "record")
+    OATPP_ASSERT(clone->items->size() == itemsCount)
+    OATPP_ASSERT(clone->items->back() == "b")
+
+    /* the pull serializer follows the same config */
+    OATPP_ASSERT(pullAll(mapper.createReadCallback(createRecord())) == bob)
+
+  }
+}
+
+}
+
+void SerializerConfigTest::onRun() {
+
+  {
+    OATPP_LOGD(TAG, "includeNullFields")
+    auto config = oatpp::bob::Serializer::Config::createShared();
+    config->includeNullFields = true;
+    checkConfig(config, 5, 3, 2);
+  }
+
+  {
+    OATPP_LOGD(TAG, "alwaysIncludeRequired")
+    auto config = oatpp::bob::Serializer::Config::createShared();
+    config->includeNullFields = false;
+    config->alwaysIncludeRequired = true;
+    checkConfig(config, 4, 2, 1);
+  }
+
+  {
+    OATPP_LOGD(TAG, "alwaysIncludeNullCollectionElements")
+    auto config = oatpp::bob::Serializer::Config::createShared();
+    config->includeNullFields = false;
+    config->alwaysIncludeNullCollectionElements = true;
+    checkConfig(config, 3, 3, 2);
+  }
+
+  {
+    OATPP_LOGD(TAG, "No nulls")
+    auto config = oatpp::bob::Serializer::Config::createShared();
+    config->includeNullFields = false;
+    checkConfig(config, 3, 2, 1);
+  }
+
+  {
+    OATPP_LOGD(TAG, "Config is copied at construction")
+    auto config = oatpp::bob::Serializer::Config::createShared();
+    oatpp::bob::ObjectMapper mapper(config, oatpp::bob::Deserializer::Config::createShared());
+    auto bob = mapper.writeToString(createRecord());
+
+    mapper.getSerializer()->getConfig()->includeNullFields = false;
+    config->sizedContainers = true;
+    config->arrayIndexThreshold = 1;
+    OATPP_ASSERT(mapper.getSerializer()->getConfig() == config)
+
+    OATPP_ASSERT(mapper.writeToString(createRecord()) == bob)
+    OATPP_ASSERT(pullAll(mapper.createReadCallback(createRecord())) == bob)
+    oatpp::bob::SegmentedOutputStream stream;
+    mapper.write(&stream, createRecord());
+    OATPP_ASSERT(stream.toString() == bob)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Reload config")
+    auto config = oatpp::bob::Serializer::Config::createShared();
+    auto serializer = std::make_shared<oatpp::bob::Serializer>(config);
+    serializer->setSerializerMethod(oatpp::data::mapping::type::__class::Int32::CLASS_ID, &serializeInt32AsString);
+    oatpp::bob::ObjectMapper mapper(serializer, std::make_shared<oatpp::bob::Deserializer>());
+
+    config->includeNullFields = false;
+    config->sizedContainers = true;
+    serializer->reloadConfig();
+
+    auto expectedConfig = oatpp::bob::Serializer::Config::createShared();
+    expectedConfig->includeNullFields = false;
+    expectedConfig->sizedContainers = true;
+    auto expectedSerializer = std::make_shared<oatpp::bob::Serializer>(expectedConfig);
+    expectedSerializer->setSerializerMethod(oatpp::data::mapping::type::__class::Int32::CLASS_ID, &serializeInt32AsString);
+    oatpp::bob::ObjectMapper expectedMapper(expectedSerializer, std::make_shared<oatpp::bob::Deserializer>());
+
+    auto record = createRecord();
+    record->id = 7;
+    auto bob = mapper.writeToString(record);
+    OATPP_ASSERT(bob->data()[0] == 'M')
+    OATPP_ASSERT(bob == expectedMapper.writeToString(record))
+    OATPP_ASSERT(pullAll(mapper.createReadCallback(record)) == bob)
+    auto fields = mapper.readFromString<oatpp::Fields<oatpp::Any>>(bob);
+    OATPP_ASSERT(fields["id"].retrieve<oatpp::String>() == "7") // the custom method is kept
+    OATPP_ASSERT(fields->size() == 4) // null "comment" is skipped
+  }
+
+}
+
+}}}
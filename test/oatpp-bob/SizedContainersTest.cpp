@@ -0,0 +1,195 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "SizedContainersTest.hpp"
+
+#include "oatpp-bob/ObjectMapper.hpp"
+
+#include "oatpp/core/data/stream/BufferStream.hpp"
+#include "oatpp/core/macro/codegen.hpp"
+
+namespace oatpp { namespace bob { namespace test {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class ItemDto : public oatpp::DTO {
+
+  DTO_INIT(ItemDto, DTO)
+
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, name);
+  DTO_FIELD(List<Float64>, values);
+  DTO_FIELD(Fields<String>, attributes);
+
+};
+
+class CatalogDto : public oatpp::DTO {
+
+  DTO_INIT(CatalogDto, DTO)
+
+  DTO_FIELD(Vector<Object<ItemDto>>, items);
+  DTO_FIELD(String, title);
+
+};
+
+class TitleOnlyDto : public oatpp::DTO {
+
+  DTO_INIT(TitleOnlyDto, DTO)
+
+  DTO_FIELD(String, title);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::Object<CatalogDto> createCatalog(v_int32 count) {
+  auto catalog = CatalogDto::createShared();
+  catalog->title = "catalog";
+  catalog->items = {};
+  for(v_int32 i = 0; i < count; i ++) {
+    auto item = ItemDto::createShared();
+    item->id = i;
+    item->name = "item-" + std::to_string(i);
+    item->values = {0.5 * i, 1.5 * i};
+    item->attributes = {{"color", "red"}, {"size", std::to_string(i % 3)}};
+    catalog->items->push_back(item);
+  }
+  catalog->items->push_back(nullptr);
+  return catalog;
+}
+
+}
+
+void SizedContainersTest::onRun() {
+
+  auto serializerConfig = oatpp::bob::Serializer::Config::createShared();
+  serializerConfig->sizedContainers = true;
+  serializerConfig->alwaysIncludeNullCollectionElements = true;
+  auto deserializerConfig = oatpp::bob::Deserializer::Config::createShared();
+  deserializerConfig->allowUnknownFields = true;
+
+  oatpp::bob::ObjectMapper mapper;
+  oatpp::bob::ObjectMapper sizedMapper(serializerConfig, deserializerConfig);
+
+  auto catalog = createCatalog(500);
+  auto bob = sizedMapper.writeToString(catalog);
+
+  OATPP_ASSERT(bob->data()[0] == 'M')
+  OATPP_ASSERT(sizedMapper.getSerializer()->computeSize(catalog) == bob->size())
+
+  {
+    OATPP_LOGD(TAG, "Round trip")
+    auto clone = mapper.readFromString<oatpp::Object<CatalogDto>>(bob);
+    OATPP_ASSERT(clone->title == "catalog")
+    OATPP_ASSERT(clone->items->size() == 501)
+    OATPP_ASSERT(clone->items[500] == nullptr)
+    for(v_int32 i = 0; i < 500; i ++) {
+      auto& item = clone->items[i];
+      OATPP_ASSERT(item->id == i)
+      OATPP_ASSERT(item->name == "item-" + std::to_string(i))
+      OATPP_ASSERT(item->values->size() == 2 && item->values->back() == 1.5 * i)
+      OATPP_ASSERT(item->attributes["size"] == std::to_string(i % 3))
+    }
+  }
+
+  {
+    OATPP_LOGD(TAG, "Header")
+    auto data = (const v_uint8*) bob->data();
+    v_uint32 size = ((v_uint32) data[1] << 24) | ((v_uint32) data[2] << 16) | ((v_uint32) data[3] << 8) | data[4];
+    v_uint32 count = ((v_uint32) data[5] << 24) | ((v_uint32) data[6] << 16) | ((v_uint32) data[7] << 8) | data[8];
+    OATPP_ASSERT(size == bob->size() - 9)
+    OATPP_ASSERT(count == 2)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Skip")
+    auto clone = sizedMapper.readFromString<oatpp::Object<TitleOnlyDto>>(bob);
+    OATPP_ASSERT(clone->title == "catalog")
+  }
+
+  {
+    OATPP_LOGD(TAG, "Any")
+    auto any = mapper.readFromString<oatpp::Any>(bob);
+    auto fields = any.retrieve<oatpp::Fields<oatpp::Any>>();
+    auto items = fields["items"].retrieve<oatpp::Vector<oatpp::Any>>();
+    OATPP_ASSERT(items->size() == 501)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Streams without back-patching")
+    oatpp::bob::SegmentedOutputStream stream;
+    sizedMapper.write(&stream, catalog);
+    OATPP_ASSERT(stream.toString() == bob)
+    auto callback = sizedMapper.createReadCallback(catalog);
+    oatpp::data::stream::BufferOutputStream result;
+    v_char8 buffer[100];
+    v_io_size res;
+    while((res = callback->readSimple(buffer, 100)) > 0) {
+      result.writeSimple(buffer, res);
+    }
+    OATPP_ASSERT(result.toString() == bob)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Key table")
+    auto config = oatpp::bob::Serializer::Config::createShared();
+    config->sizedContainers = true;
+    config->useKeyTable = true;
+    oatpp::bob::ObjectMapper keyTableMapper(config, deserializerConfig);
+    auto result = keyTableMapper.writeToString(catalog);
+    OATPP_ASSERT(result->size() < bob->size())
+    auto clone = keyTableMapper.readFromString<oatpp::Object<CatalogDto>>(result);
+    OATPP_ASSERT(clone->items[499]->attributes["color"] == "red")
+    OATPP_ASSERT(keyTableMapper.readFromString<oatpp::Object<TitleOnlyDto>>(result)->title == "catalog")
+  }
+
+  {
+    OATPP_LOGD(TAG, "Invalid count")
+    oatpp::String wrong("A\x00\x00\x00\x05\x00\x00\x00\x03" "b\x01" "b\x02" ")", 14);
+    bool failed = false;
+    try {
+      mapper.readFromString<oatpp::Vector<oatpp::Int8>>(wrong);
+    } catch (...) {
+      failed = true;
+    }
+    OATPP_ASSERT(failed)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Invalid size")
+    oatpp::String wrong("A\x00\x00\x01\x00\x00\x00\x00\x02" "b\x01" "b\x02" ")", 14);
+    bool failed = false;
+    try {
+      mapper.readFromString<oatpp::Vector<oatpp::Int8>>(wrong);
+    } catch (...) {
+      failed = true;
+    }
+    OATPP_ASSERT(failed)
+  }
+
+}
+
+}}}
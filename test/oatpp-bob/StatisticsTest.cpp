@@ -0,0 +1,141 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "StatisticsTest.hpp"
+
+#include "oatpp-bob/ObjectMapper.hpp"
+
+#include "oatpp/core/macro/codegen.hpp"
+
+#include <thread>
+
+namespace oatpp { namespace bob { namespace test {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class OrderDto : public oatpp::DTO {
+
+  DTO_INIT(OrderDto, DTO)
+
+  DTO_FIELD(Int64, id);
+  DTO_FIELD(String, customer);
+  DTO_FIELD(String, comment);
+  DTO_FIELD(List<String>, items);
+
+};
+
+/* previous version of OrderDto - without "comment" */
+class OrderV1Dto : public oatpp::DTO {
+
+  DTO_INIT(OrderV1Dto, DTO)
+
+  DTO_FIELD(Int64, id);
+  DTO_FIELD(String, customer);
+  DTO_FIELD(List<String>, items);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+const oatpp::bob::Statistics::TypeCounters* find(const std::vector<oatpp::bob::Statistics::TypeCounters>& list, const char* name) {
+  for(auto const& counters : list) {
+    if(counters.name == name) {
+      return &counters;
+    }
+  }
+  return nullptr;
+}
+
+}
+
+void StatisticsTest::onRun() {
+
+  auto statistics = std::make_shared<oatpp::bob::Statistics>();
+
+  auto serializerConfig = oatpp::bob::Serializer::Config::createShared();
+  serializerConfig->statistics = statistics;
+  auto deserializerConfig = oatpp::bob::Deserializer::Config::createShared();
+  deserializerConfig->statistics = statistics;
+  oatpp::bob::ObjectMapper mapper(serializerConfig, deserializerConfig);
+
+  auto order = OrderDto::createShared();
+  order->id = 1;
+  order->customer = "customer";
+  order->comment = "leave at the door";
+  order->items = {"apple", "pear", "plum"};
+
+  auto bob = mapper.writeToString(order);
+
+  {
+    OATPP_LOGD(TAG, "Serialize")
+    auto snapshot = statistics->getSnapshot();
+    OATPP_ASSERT(snapshot.deserialized.empty())
+    OATPP_ASSERT(snapshot.serializedObjects.size() == 1)
+    OATPP_ASSERT(snapshot.serializedObjects[0].values == 1) // the size computation pass is not counted
+    OATPP_ASSERT(snapshot.serializedObjects[0].bytes == (v_int64) bob->size())
+    auto strings = find(snapshot.serialized, "String");
+    OATPP_ASSERT(strings && strings->values == 5)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Deserialize with unknown field")
+    auto clone = mapper.readFromString<oatpp::Object<OrderV1Dto>>(bob);
+    OATPP_ASSERT(clone->items->size() == 3)
+    auto snapshot = statistics->getSnapshot();
+    OATPP_ASSERT(snapshot.deserializedObjects.size() == 1)
+    OATPP_ASSERT(snapshot.deserializedObjects[0].bytes == (v_int64) bob->size())
+    auto strings = find(snapshot.deserialized, "String");
+    OATPP_ASSERT(strings && strings->values == 4)
+    OATPP_ASSERT(snapshot.skippedFields == 1)
+    OATPP_ASSERT(snapshot.skippedBytes == 19) // 's' + size + "leave at the door"
+  }
+
+  {
+    OATPP_LOGD(TAG, "Threads")
+    std::vector<std::thread> threads;
+    for(v_int32 t = 0; t < 4; t ++) {
+      threads.emplace_back([&mapper, &bob]() {
+        for(v_int32 i = 0; i < 100; i ++) {
+          mapper.readFromString<oatpp::Object<OrderDto>>(bob);
+        }
+      });
+    }
+    for(auto& thread : threads) {
+      thread.join();
+    }
+    auto snapshot = statistics->getSnapshot();
+    OATPP_ASSERT(snapshot.deserializedObjects.size() == 2)
+    v_int64 objects = 0;
+    for(auto const& counters : snapshot.deserializedObjects) {
+      objects += counters.values;
+    }
+    OATPP_ASSERT(objects == 401)
+    OATPP_ASSERT(snapshot.skippedFields == 1)
+  }
+
+}
+
+}}}
@@ -0,0 +1,137 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "StringDedupTest.hpp"
+
+#include "oatpp-bob/ObjectMapper.hpp"
+
+#include "oatpp/core/macro/codegen.hpp"
+
+#include <unordered_set>
+
+namespace oatpp { namespace bob { namespace test {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class AccountDto : public oatpp::DTO {
+
+  DTO_INIT(AccountDto, DTO)
+
+  DTO_FIELD(String, tenant);
+  DTO_FIELD(String, country);
+  DTO_FIELD(String, status);
+  DTO_FIELD(String, name);
+
+};
+
+class TenantOnlyDto : public oatpp::DTO {
+
+  DTO_INIT(TenantOnlyDto, DTO)
+
+  DTO_FIELD(String, name);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+}
+
+void StringDedupTest::onRun() {
+
+  oatpp::Vector<oatpp::Object<AccountDto>> accounts({});
+  for(v_int32 i = 0; i < 200; i ++) {
+    auto account = AccountDto::createShared();
+    account->tenant = (i % 2 == 0) ? "tenant-5f1c0a2e" : "tenant-9b77d410";
+    account->country = "UA";
+    account->status = "active";
+    account->name = "account-" + std::to_string(i);
+    accounts->push_back(account);
+  }
+
+  auto serializerConfig = oatpp::bob::Serializer::Config::createShared();
+  serializerConfig->stringDedupTableSize = 64;
+  auto deserializerConfig = oatpp::bob::Deserializer::Config::createShared();
+  deserializerConfig->allowUnknownFields = true;
+
+  oatpp::bob::ObjectMapper mapper;
+  oatpp::bob::ObjectMapper dedupMapper(serializerConfig, deserializerConfig);
+
+  auto bob = mapper.writeToString(accounts);
+  auto dedupBob = dedupMapper.writeToString(accounts);
+  OATPP_LOGD(TAG, "size=%d, dedup size=%d", (v_int32) bob->size(), (v_int32) dedupBob->size())
+  OATPP_ASSERT(dedupBob->size() < bob->size())
+  OATPP_ASSERT(dedupMapper.getSerializer()->computeSize(accounts) == dedupBob->size())
+
+  {
+    OATPP_LOGD(TAG, "Round trip")
+    auto clone = mapper.readFromString<oatpp::Vector<oatpp::Object<AccountDto>>>(dedupBob);
+    OATPP_ASSERT(clone->size() == accounts->size())
+    for(v_int32 i = 0; i < accounts->size(); i ++) {
+      OATPP_ASSERT(clone[i]->tenant == accounts[i]->tenant)
+      OATPP_ASSERT(clone[i]->country == "UA")
+      OATPP_ASSERT(clone[i]->status == "active")
+      OATPP_ASSERT(clone[i]->name == accounts[i]->name)
+    }
+    /* references to the same string share the instance */
+    std::unordered_set<const void*> instances;
+    for(v_int32 i = 0; i < clone->size(); i ++) {
+      instances.insert(clone[i]->tenant.get());
+      instances.insert(clone[i]->status.get());
+    }
+    OATPP_LOGD(TAG, "string instances=%d", (v_int32) instances.size())
+    OATPP_ASSERT(instances.size() < 40)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Skip references")
+    auto clone = dedupMapper.readFromString<oatpp::Vector<oatpp::Object<TenantOnlyDto>>>(dedupBob);
+    OATPP_ASSERT(clone->size() == accounts->size())
+    OATPP_ASSERT(clone[199]->name == "account-199")
+  }
+
+  {
+    OATPP_LOGD(TAG, "Any")
+    auto any = mapper.readFromString<oatpp::Any>(dedupBob);
+    auto vector = any.retrieve<oatpp::Vector<oatpp::Any>>();
+    auto fields = vector[10].retrieve<oatpp::Fields<oatpp::Any>>();
+    OATPP_ASSERT(fields["status"].retrieve<oatpp::String>() == "active")
+  }
+
+  {
+    OATPP_LOGD(TAG, "Invalid reference")
+    oatpp::String wrong("[s\x02UA@\x03@\x02)", 10);
+    bool failed = false;
+    try {
+      mapper.readFromString<oatpp::Vector<oatpp::String>>(wrong);
+    } catch (...) {
+      failed = true;
+    }
+    OATPP_ASSERT(failed)
+  }
+
+}
+
+}}}
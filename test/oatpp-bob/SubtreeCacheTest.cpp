@@ -0,0 +1,122 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "SubtreeCacheTest.hpp"
+
+#include "oatpp-bob/ObjectMapper.hpp"
+
+#include "oatpp/core/macro/codegen.hpp"
+
+#include <thread>
+
+namespace oatpp { namespace bob { namespace test {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class NodeDto : public oatpp::DTO {
+
+  DTO_INIT(NodeDto, DTO)
+
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, name);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::Vector<oatpp::Object<NodeDto>> createNodes(v_int32 count) {
+  oatpp::Vector<oatpp::Object<NodeDto>> nodes({});
+  for(v_int32 i = 0; i < count; i ++) {
+    auto node = NodeDto::createShared();
+    node->id = i;
+    node->name = "node-" + std::to_string(i);
+    nodes->push_back(node);
+  }
+  return nodes;
+}
+
+}
+
+void SubtreeCacheTest::onRun() {
+
+  auto cache = std::make_shared<oatpp::bob::SubtreeCache>();
+  auto serializerConfig = oatpp::bob::Serializer::Config::createShared();
+  serializerConfig->subtreeCache = cache;
+  oatpp::bob::ObjectMapper cachingMapper(serializerConfig, oatpp::bob::Deserializer::Config::createShared());
+  oatpp::bob::ObjectMapper mapper;
+
+  auto shared = NodeDto::createShared();
+  shared->id = -1;
+  shared->name = "shared";
+  cache->put(shared, 1);
+
+  {
+    OATPP_LOGD(TAG, "Unregistered objects don't take the lock")
+    const v_int32 threadsCount = 4;
+    const v_int32 iterations = 10;
+    const v_int32 nodesCount = 100;
+    std::vector<std::thread> threads;
+    for(v_int32 t = 0; t < threadsCount; t ++) {
+      threads.emplace_back([&cachingMapper, &mapper] {
+        auto nodes = createNodes(nodesCount);
+        auto expected = mapper.writeToString(nodes);
+        for(v_int32 i = 0; i < iterations; i ++) {
+          OATPP_ASSERT(cachingMapper.writeToString(nodes) == expected)
+          OATPP_ASSERT(cachingMapper.readFromString<oatpp::Vector<oatpp::Object<NodeDto>>>(expected)->size() == nodesCount)
+        }
+      });
+    }
+    for(auto& thread : threads) {
+      thread.join();
+    }
+    /* each writeToString() looks up every node twice - size pass and write. Only filter collisions take the lock */
+    const v_int64 lookups = threadsCount * iterations * nodesCount * 2;
+    OATPP_LOGD(TAG, "lookups=%d, locked=%d", (v_int32) lookups, (v_int32) cache->getLockedLookups())
+    OATPP_ASSERT(cache->getLockedLookups() < lookups / 10)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Registered objects are found")
+    auto nodes = createNodes(10);
+    nodes->push_back(shared);
+    auto before = cache->getLockedLookups();
+    OATPP_ASSERT(cachingMapper.writeToString(nodes) == mapper.writeToString(nodes))
+    OATPP_ASSERT(cache->getLockedLookups() > before)
+    OATPP_ASSERT(cache->get(cachingMapper.getSerializer().get(), shared.get()).data != nullptr)
+  }
+
+  {
+    OATPP_LOGD(TAG, "Clear")
+    cache->clear();
+    auto before = cache->getLockedLookups();
+    OATPP_ASSERT(cachingMapper.writeToString(shared) == mapper.writeToString(shared))
+    OATPP_ASSERT(cache->getLockedLookups() == before)
+    OATPP_ASSERT(!cache->get(cachingMapper.getSerializer().get(), shared.get()).registered)
+  }
+
+}
+
+}}}
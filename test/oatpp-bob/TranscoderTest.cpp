@@ -0,0 +1,186 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "TranscoderTest.hpp"
+
+#include "oatpp-bob/ObjectMapper.hpp"
+#include "oatpp-bob/Transcoder.hpp"
+
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+#include "oatpp/core/macro/codegen.hpp"
+
+namespace oatpp { namespace bob { namespace test {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class PointDto : public oatpp::DTO {
+
+  DTO_INIT(PointDto, DTO)
+
+  DTO_FIELD(Int32, x);
+  DTO_FIELD(Int32, y);
+  DTO_FIELD(String, label);
+  DTO_FIELD(Boolean, visible);
+
+};
+
+class ShapeDto : public oatpp::DTO {
+
+  DTO_INIT(ShapeDto, DTO)
+
+  DTO_FIELD(String, name);
+  DTO_FIELD(Int64, id);
+  DTO_FIELD(Float64, area);
+  DTO_FIELD(Vector<Object<PointDto>>, points);
+  DTO_FIELD(Fields<String>, tags);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::Object<ShapeDto> createShape() {
+  auto shape = ShapeDto::createShared();
+  shape->name = "polygon \"A\"\n";
+  shape->id = 5000000000;
+  shape->area = 12.5;
+  shape->points = {};
+  for(v_int32 i = 0; i < 20; i ++) {
+    auto point = PointDto::createShared();
+    point->x = i * 1000;
+    point->y = -i;
+    point->label = i % 2 == 0 ? oatpp::String("p-" + std::to_string(i)) : nullptr;
+    point->visible = i % 3 == 0;
+    shape->points->push_back(point);
+  }
+  shape->tags = {{"color", "red"}, {"layer", "top"}};
+  return shape;
+}
+
+void checkShape(const oatpp::Object<ShapeDto>& shape) {
+  OATPP_ASSERT(shape->name == "polygon \"A\"\n")
+  OATPP_ASSERT(shape->id == 5000000000)
+  OATPP_ASSERT(shape->area == 12.5)
+  OATPP_ASSERT(shape->points->size() == 20)
+  for(v_int32 i = 0; i < 20; i ++) {
+    auto& point = shape->points[i];
+    OATPP_ASSERT(point->x == i * 1000)
+    OATPP_ASSERT(point->y == -i)
+    OATPP_ASSERT(i % 2 == 0 ? point->label == "p-" + std::to_string(i) : point->label == nullptr)
+    OATPP_ASSERT(point->visible == (i % 3 == 0))
+  }
+  OATPP_ASSERT(shape->tags->size() == 2)
+  OATPP_ASSERT(shape->tags[1].second == "top")
+}
+
+}
+
+void TranscoderTest::onRun() {
+
+  oatpp::parser::json::mapping::ObjectMapper jsonMapper;
+
+  {
+    OATPP_LOGD(TAG, "BOB -> JSON")
+    auto config = oatpp::bob::Serializer::Config::createShared();
+    config->useKeyTable = true;
+    config->stringDedupTableSize = 64;
+    oatpp::bob::ObjectMapper mapper(config, oatpp::bob::Deserializer::Config::createShared());
+    auto json = oatpp::bob::Transcoder::bobToJson(mapper.writeToString(createShape()));
+    checkShape(jsonMapper.readFromString<oatpp::Object<ShapeDto>>(json));
+  }
+
+  {
+    OATPP_LOGD(TAG, "BOB -> JSON - sized, indexed and columnar containers")
+    auto config = oatpp::bob::Serializer::Config::createShared();
+    config->sizedContainers = true;
+    config->arrayIndexThreshold = 10;
+    oatpp::bob::ObjectMapper mapper(config, oatpp::bob::Deserializer::Config::createShared());
+    checkShape(jsonMapper.readFromString<oatpp::Object<ShapeDto>>(oatpp::bob::Transcoder::bobToJson(mapper.writeToString(createShape()))));
+
+    config = oatpp::bob::Serializer::Config::createShared();
+    config->columnarObjectVectors = true;
+    oatpp::bob::ObjectMapper columnarMapper(config, oatpp::bob::Deserializer::Config::createShared());
+    columnarMapper.setCompression(std::make_shared<oatpp::bob::LzCodec>());
+    auto compressed = columnarMapper.writeToString(createShape());
+    checkShape(jsonMapper.readFromString<oatpp::Object<ShapeDto>>(oatpp::bob::Transcoder::bobToJson(compressed, 1024 * 1024)));
+    bool failed = false;
+    try {
+      oatpp::bob::Transcoder::bobToJson(compressed);
+    } catch (const oatpp::parser::ParsingError&) {
+      failed = true;
+    }
+    OATPP_ASSERT(failed)
+  }
+
+  {
+    OATPP_LOGD(TAG, "JSON -> BOB")
+    oatpp::bob::ObjectMapper mapper;
+    auto bob = oatpp::bob::Transcoder::jsonToBob(jsonMapper.writeToString(createShape()));
+    checkShape(mapper.readFromString<oatpp::Object<ShapeDto>>(bob));
+  }
+
+  {
+    OATPP_LOGD(TAG, "Integer widths")
+    OATPP_ASSERT(oatpp::bob::Transcoder::jsonToBob("5") == oatpp::String("b\x05", 2))
+    OATPP_ASSERT(oatpp::bob::Transcoder::jsonToBob("-300") == oatpp::String("i\xfe\xd4", 3))
+    OATPP_ASSERT(oatpp::bob::Transcoder::jsonToBob("{\"a\": [true, null]}") == oatpp::String("{a\0[+0))", 8))
+    OATPP_ASSERT(oatpp::bob::Transcoder::bobToJson(oatpp::bob::Transcoder::jsonToBob("[18446744073709551615, -9223372036854775808]")) ==
+                 "[18446744073709551615,-9223372036854775808]")
+  }
+
+  {
+    OATPP_LOGD(TAG, "Strings")
+    auto json = oatpp::bob::Transcoder::bobToJson(oatpp::bob::Transcoder::jsonToBob("\"tab\\t quote\\\" \\u00e9 \\ud83d\\ude00\""));
+    OATPP_ASSERT(json == "\"tab\\t quote\\\" \xc3\xa9 \xf0\x9f\x98\x80\"")
+  }
+
+  {
+    OATPP_LOGD(TAG, "Errors")
+    for(auto& text : {"[1,]", "{\"a\" 1}", "\"abc", "[1e]", "\"\\ud800\""}) {
+      bool failed = false;
+      try {
+        oatpp::bob::Transcoder::jsonToBob(text);
+      } catch (const oatpp::parser::ParsingError&) {
+        failed = true;
+      }
+      OATPP_ASSERT(failed)
+    }
+    oatpp::String truncatedMap("{key\0s\x09value)", 12);
+    oatpp::String noColumns("C\xFF\xFF\xFF\x7F\x00)", 7);
+    oatpp::String shortValuesColumn("C\x64\x01k\x00*\x00\x00\x00\x02" "b\x01)", 13);
+    for(auto& bob : {truncatedMap, noColumns, shortValuesColumn}) {
+      bool failed = false;
+      try {
+        oatpp::bob::Transcoder::bobToJson(bob);
+      } catch (const oatpp::parser::ParsingError&) {
+        failed = true;
+      }
+      OATPP_ASSERT(failed)
+    }
+  }
+
+}
+
+}}}
@@ -5,6 +5,26 @@
 #include "./IntegerTest.hpp"
 #include "./SkipTest.hpp"
 #include "./ObjectMapperTest.hpp"
+#include "./EnumTest.hpp"
+#include "./ReadCallbackTest.hpp"
+#include "./KeyTableTest.hpp"
+#include "./StringDedupTest.hpp"
+#include "./ColumnarTest.hpp"
+#include "./CompressionTest.hpp"
+#include "./SizedContainersTest.hpp"
+#include "./ArrayIndexTest.hpp"
+#include "./MappedFileTest.hpp"
+#include "./RecordLogTest.hpp"
+#include "./BatchTest.hpp"
+#include "./BufferPoolTest.hpp"
+#include "./TranscoderTest.hpp"
+#include "./PositionalObjectsTest.hpp"
+#include "./FieldIdsTest.hpp"
+#include "./AllocationCounterTest.hpp"
+#include "./StatisticsTest.hpp"
+#include "./SerializerConfigTest.hpp"
+#include "./ObjectKeysTest.hpp"
+#include "./SubtreeCacheTest.hpp"
 
 #include <iostream>
 
@@ -15,6 +35,26 @@ void runTests() {
   OATPP_RUN_TEST(oatpp::bob::test::IntegerTest);
   OATPP_RUN_TEST(oatpp::bob::test::SkipTest);
   OATPP_RUN_TEST(oatpp::bob::test::ObjectMapperTest);
+  OATPP_RUN_TEST(oatpp::bob::test::EnumTest);
+  OATPP_RUN_TEST(oatpp::bob::test::ReadCallbackTest);
+  OATPP_RUN_TEST(oatpp::bob::test::KeyTableTest);
+  OATPP_RUN_TEST(oatpp::bob::test::StringDedupTest);
+  OATPP_RUN_TEST(oatpp::bob::test::ColumnarTest);
+  OATPP_RUN_TEST(oatpp::bob::test::CompressionTest);
+  OATPP_RUN_TEST(oatpp::bob::test::SizedContainersTest);
+  OATPP_RUN_TEST(oatpp::bob::test::ArrayIndexTest);
+  OATPP_RUN_TEST(oatpp::bob::test::MappedFileTest);
+  OATPP_RUN_TEST(oatpp::bob::test::RecordLogTest);
+  OATPP_RUN_TEST(oatpp::bob::test::BatchTest);
+  OATPP_RUN_TEST(oatpp::bob::test::BufferPoolTest);
+  OATPP_RUN_TEST(oatpp::bob::test::TranscoderTest);
+  OATPP_RUN_TEST(oatpp::bob::test::PositionalObjectsTest);
+  OATPP_RUN_TEST(oatpp::bob::test::FieldIdsTest);
+  OATPP_RUN_TEST(oatpp::bob::test::AllocationCounterTest);
+  OATPP_RUN_TEST(oatpp::bob::test::StatisticsTest);
+  OATPP_RUN_TEST(oatpp::bob::test::SerializerConfigTest);
+  OATPP_RUN_TEST(oatpp::bob::test::ObjectKeysTest);
+  OATPP_RUN_TEST(oatpp::bob::test::SubtreeCacheTest);
 }
 
 }